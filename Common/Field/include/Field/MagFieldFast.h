@@ -55,6 +55,8 @@ class MagFieldFast
   bool Field(const float xyz[3], float bxyz[3]) const;
   bool Field(const math_utils::Point3D<float> xyz, float bxyz[3]) const;
   bool Field(const math_utils::Point3D<double> xyz, double bxyz[3]) const;
+  int Field(int n, const double* xyz, double* bxyz) const;
+  int Field(int n, const float* xyz, float* bxyz) const;
   bool GetBcomp(EDim comp, const double xyz[3], double& b) const;
   bool GetBcomp(EDim comp, const float xyz[3], float& b) const;
   bool GetBcomp(EDim comp, const math_utils::Point3D<float> xyz, double& b) const;
@@ -82,6 +84,9 @@ class MagFieldFast
 
   float CalcPol(const float* cf, float x, float y, float z) const;
 
+  template <typename T>
+  int FieldBatch(int n, const T* xyz, T* bxyz) const;
+
  private:
   float mFactorSol; // scaling factor
   SolParam mSolPar[kNSolRRanges][kNSolZRanges][kNQuadrants];
@@ -112,6 +112,10 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Method to calculate the field at n points stored contiguously in xyz (xyz[3*i+k]), the field of point i
+  /// being stored in b[3*i+k]. The points in the measured map region are evaluated in one batch
+  void Field(int n, const Double_t* __restrict__ xyz, Double_t* __restrict__ b);
+
   void field(const math_utils::Point3D<float> xyz, float bxyz[3])
   {
     double xyzd[3] = {xyz.X(), xyz.Y(), xyz.Z()}, bxyzd[3] = {0};
@@ -210,6 +210,12 @@ class MagneticWrapperChebyshev : public TNamed
   /// it gets it at closest valid point
   virtual void Field(const Double_t* xyz, Double_t* b) const;
 
+  /// Computes field in cartesian coordinates for n points stored contiguously in xyz (xyz[3*i+k]), the field of
+  /// point i being stored in b[3*i+k]. The points are grouped per parameterization segment and the Chebyshev
+  /// polynomials of each segment are evaluated for all its points at once. Points outside of the parameterized
+  /// region get a null field
+  void Field(int n, const Double_t* xyz, Double_t* b) const;
+
   /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
   /// it gets it at closest valid point
   Double_t getBz(const Double_t* xyz) const;
@@ -234,6 +234,63 @@ bool MagFieldFast::Field(const math_utils::Point3D<double> xyz, double bxyz[3])
   return true;
 }
 
+//_______________________________________________________________________
+int MagFieldFast::Field(int n, const double* xyz, double* bxyz) const
+{
+  // get field for n points stored contiguously in xyz (xyz[3*i+k]), see FieldBatch
+  return FieldBatch(n, xyz, bxyz);
+}
+
+//_______________________________________________________________________
+int MagFieldFast::Field(int n, const float* xyz, float* bxyz) const
+{
+  // get field for n points stored contiguously in xyz (xyz[3*i+k]), see FieldBatch
+  return FieldBatch(n, xyz, bxyz);
+}
+
+//_______________________________________________________________________
+template <typename T>
+int MagFieldFast::FieldBatch(int n, const T* xyz, T* bxyz) const
+{
+  // get field for n points, the field of point i being stored in bxyz[3*i+k].
+  // Runs of consecutive points in the same segment (e.g. points along a track) are evaluated
+  // with the same polynomial coefficients in a single vectorizable loop.
+  // Points outside of the parametrization get a null field. Return the number of points inside
+  int nInside = 0;
+  int zSeg = 0, rSeg = 0, quadrant = 0, zSegN = 0, rSegN = 0, quadrantN = 0;
+  bool inside = n > 0 && GetSegment(xyz[kX], xyz[kY], xyz[kZ], zSeg, rSeg, quadrant), insideN = false;
+  for (int first = 0, last = 1; first < n; first = last++) {
+    // extend the run while the points stay in the same segment
+    for (; last < n; last++) {
+      const T* pnt = xyz + 3 * last;
+      insideN = GetSegment(pnt[kX], pnt[kY], pnt[kZ], zSegN, rSegN, quadrantN);
+      if (insideN != inside || (inside && (zSegN != zSeg || rSegN != rSeg || quadrantN != quadrant))) {
+        break;
+      }
+    }
+    if (inside) {
+      const SolParam* par = &mSolPar[rSeg][zSeg][quadrant];
+      for (int i = first; i < last; i++) {
+        const T* pnt = xyz + 3 * i;
+        T* b = bxyz + 3 * i;
+        b[kX] = CalcPol(par->parBxyz[kX], pnt[kX], pnt[kY], pnt[kZ]) * mFactorSol;
+        b[kY] = CalcPol(par->parBxyz[kY], pnt[kX], pnt[kY], pnt[kZ]) * mFactorSol;
+        b[kZ] = CalcPol(par->parBxyz[kZ], pnt[kX], pnt[kY], pnt[kZ]) * mFactorSol;
+      }
+      nInside += last - first;
+    } else {
+      for (int i = 3 * first; i < 3 * last; i++) {
+        bxyz[i] = 0;
+      }
+    }
+    inside = insideN;
+    zSeg = zSegN;
+    rSeg = rSegN;
+    quadrant = quadrantN;
+  }
+  return nInside;
+}
+
 //_______________________________________________________________________
 bool MagFieldFast::GetSegment(float x, float y, float z, int& zSeg, int& rSeg, int& quadrant) const
 {
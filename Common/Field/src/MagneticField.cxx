@@ -21,6 +21,7 @@
 #include "FairParamList.h"
 #include "FairRun.h"
 #include "FairRuntimeDb.h"
+#include <vector>
 
 using namespace o2::field;
 
@@ -286,6 +287,43 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(int n, const Double_t* __restrict__ xyz, Double_t* __restrict__ b)
+{
+  /*
+   * query field values at n points, same as calling Field(xyz, b) for each point
+   */
+
+  // points served by the fast parametrization or by the machine field are done one by one,
+  // the ones in the measured map are collected and evaluated together
+  std::vector<int> mapIndex;
+  std::vector<Double_t> mapXYZ, mapB;
+  for (int i = 0; i < n; i++) {
+    const Double_t* pnt = xyz + 3 * i;
+    if (mFastField && mFastField->Field(pnt, b + 3 * i)) {
+      continue;
+    }
+    if (mMeasuredMap && pnt[2] > mMeasuredMap->getMinZ() && pnt[2] < mMeasuredMap->getMaxZ()) {
+      mapIndex.push_back(i);
+      mapXYZ.insert(mapXYZ.end(), pnt, pnt + 3);
+    } else {
+      MachineField(pnt, b + 3 * i);
+    }
+  }
+  if (mapIndex.empty()) {
+    return;
+  }
+
+  mapB.resize(mapXYZ.size());
+  mMeasuredMap->Field(mapIndex.size(), mapXYZ.data(), mapB.data());
+  for (size_t j = 0; j < mapIndex.size(); j++) {
+    const Double_t* pnt = &mapXYZ[3 * j];
+    double factor = (pnt[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? mMultipicativeFactorSolenoid : mMultipicativeFactorDipole;
+    for (int k = 3; k--;) {
+      b[3 * mapIndex[j] + k] = mapB[3 * j + k] * factor;
+    }
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
@@ -19,6 +19,9 @@
 #include <TSystem.h>    // for TSystem, gSystem
 #include <cstdio>       // for printf, fprintf, fclose, fopen, FILE
 #include <cstring>      // for memcpy
+#include <algorithm>    // for stable_sort
+#include <numeric>      // for iota
+#include <vector>       // for vector
 #include "FairLogger.h" // for FairLogger
 #include "TMath.h"      // for BinarySearch, Sort
 #include "TMathBase.h"  // for Abs
@@ -445,6 +448,75 @@ void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(int n, const Double_t* xyz, Double_t* b) const
+{
+  // find the parameterization of each point: solenoid segments first, then dipole segments, -1 if none.
+  // Solenoid points are converted to cylindrical coordinates, in which the parameterization is defined
+  std::vector<Double_t> coord(3 * n);
+  std::vector<int> segment(n), order(n);
+  for (int i = 0; i < n; i++) {
+    const Double_t* pnt = xyz + 3 * i;
+    Double_t* crd = &coord[3 * i];
+    b[3 * i] = b[3 * i + 1] = b[3 * i + 2] = 0;
+    int id = -1;
+    if (pnt[2] > mMinZSolenoid) {
+      cartesianToCylindrical(pnt, crd);
+      id = findSolenoidSegment(crd);
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+      if (id >= 0 && !getParameterSolenoid(id)->isInside(crd)) {
+        id = -1;
+      }
+#endif
+    } else {
+      crd[0] = pnt[0];
+      crd[1] = pnt[1];
+      crd[2] = pnt[2];
+      id = findDipoleSegment(pnt);
+#ifndef _BRING_TO_BOUNDARY_
+      if (id >= 0 && !getParameterDipole(id)->isInside(pnt)) {
+        id = -1;
+      }
+#endif
+      if (id >= 0) {
+        id += mNumberOfParameterizationSolenoid;
+      }
+    }
+    segment[i] = id;
+  }
+
+  // group the points per segment and evaluate each segment for all its points at once
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&segment](int i, int j) { return segment[i] < segment[j]; });
+  std::vector<Double_t> crdSeg, bSeg;
+  for (int first = 0, last = 0; first < n; first = last) {
+    int id = segment[order[first]];
+    while (last < n && segment[order[last]] == id) {
+      last++;
+    }
+    if (id < 0) {
+      continue;
+    }
+    int nSeg = last - first;
+    crdSeg.resize(3 * nSeg);
+    bSeg.resize(3 * nSeg);
+    for (int j = 0; j < nSeg; j++) {
+      memcpy(&crdSeg[3 * j], &coord[3 * order[first + j]], 3 * sizeof(Double_t));
+    }
+    bool isSolenoid = id < mNumberOfParameterizationSolenoid;
+    Chebyshev3D* par = isSolenoid ? getParameterSolenoid(id) : getParameterDipole(id - mNumberOfParameterizationSolenoid);
+    par->Eval(nSeg, crdSeg.data(), bSeg.data());
+    for (int j = 0; j < nSeg; j++) {
+      int i = order[first + j];
+      if (isSolenoid) {
+        // convert field to cartesian system
+        cylindricalToCartesianCylB(&coord[3 * i], &bSeg[3 * j], b + 3 * i);
+      } else {
+        memcpy(b + 3 * i, &bSeg[3 * j], 3 * sizeof(Double_t));
+      }
+    }
+  }
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t* xyz) const
 {
   Double_t rphiz[3];
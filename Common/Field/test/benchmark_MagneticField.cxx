@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <TMath.h>
+#include <TRandom.h>
+
+#include "Field/MagneticField.h"
+#include "Field/MagFieldFast.h"
+
+using namespace o2::field;
+
+namespace
+{
+MagneticField& getField()
+{
+  static std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., MagFieldParam::k5kG);
+  return *fld;
+}
+
+/// random points in the barrel, half of them along straight tracks from the vertex
+std::vector<double> makePoints(int n)
+{
+  std::vector<double> xyz(3 * n);
+  float rnd[3];
+  for (int i = 0; i < n; i += 100) {
+    gRandom->RndmArray(3, rnd);
+    double phi = rnd[0] * TMath::TwoPi(), tgl = rnd[1] - 0.5;
+    for (int j = i; j < n && j < i + 100; j++) {
+      double r = (j - i) * 4.;
+      if (j % 2) {
+        gRandom->RndmArray(3, rnd);
+        xyz[3 * j] = rnd[0] * 400. * TMath::Cos(rnd[1] * TMath::TwoPi());
+        xyz[3 * j + 1] = rnd[0] * 400. * TMath::Sin(rnd[1] * TMath::TwoPi());
+        xyz[3 * j + 2] = (rnd[2] - 0.5) * 500.;
+      } else {
+        xyz[3 * j] = r * TMath::Cos(phi);
+        xyz[3 * j + 1] = r * TMath::Sin(phi);
+        xyz[3 * j + 2] = r * tgl;
+      }
+    }
+  }
+  return xyz;
+}
+} // namespace
+
+static void BM_ChebyshevPerPoint(benchmark::State& state)
+{
+  const auto* cheb = getField().getMeasuredMap();
+  int n = state.range(0);
+  auto xyz = makePoints(n);
+  std::vector<double> b(3 * n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; i++) {
+      cheb->Field(&xyz[3 * i], &b[3 * i]);
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_ChebyshevBatched(benchmark::State& state)
+{
+  const auto* cheb = getField().getMeasuredMap();
+  int n = state.range(0);
+  auto xyz = makePoints(n);
+  std::vector<double> b(3 * n);
+  for (auto _ : state) {
+    cheb->Field(n, xyz.data(), b.data());
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_FastFieldPerPoint(benchmark::State& state)
+{
+  MagFieldFast fast(1.f, 5);
+  int n = state.range(0);
+  auto xyz = makePoints(n);
+  std::vector<double> b(3 * n);
+  for (auto _ : state) {
+    for (int i = 0; i < n; i++) {
+      fast.Field(&xyz[3 * i], &b[3 * i]);
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_FastFieldBatched(benchmark::State& state)
+{
+  MagFieldFast fast(1.f, 5);
+  int n = state.range(0);
+  auto xyz = makePoints(n);
+  std::vector<double> b(3 * n);
+  for (auto _ : state) {
+    fast.Field(n, xyz.data(), b.data());
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ChebyshevPerPoint)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_ChebyshevBatched)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_FastFieldPerPoint)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_FastFieldBatched)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,7 @@
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
 #include <memory>
+#include <vector>
 #include "FairLogger.h" // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -98,3 +99,59 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticField_batched_test)
+{
+  // compare the batched field evaluation with the point by point one
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const auto* cheb = fld->getMeasuredMap();
+  BOOST_REQUIRE(cheb != nullptr);
+
+  // points in the solenoid and dipole regions, partly along straight lines to have runs in the same segment
+  const int ntst = 10000;
+  std::vector<double> xyz(3 * ntst), bBatch(3 * ntst);
+  float rnd[3];
+  for (int it = 0; it < ntst; it++) {
+    gRandom->RndmArray(3, rnd);
+    if (it % 2) {
+      xyz[3 * it] = rnd[0] * 400. * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+      xyz[3 * it + 1] = rnd[0] * 400. * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+      xyz[3 * it + 2] = (rnd[2] - 0.7) * 1500.;
+    } else {
+      xyz[3 * it] = (it % 100) * 3.;
+      xyz[3 * it + 1] = (it % 100) * 1.5;
+      xyz[3 * it + 2] = (it % 100) * 2. - 100.;
+    }
+  }
+
+  double b[3];
+  cheb->Field(ntst, xyz.data(), bBatch.data());
+  for (int it = 0; it < ntst; it++) {
+    cheb->Field(&xyz[3 * it], b);
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_SMALL(bBatch[3 * it + i] - b[i], 1.e-4);
+    }
+  }
+
+  fld->Field(ntst, xyz.data(), bBatch.data());
+  for (int it = 0; it < ntst; it++) {
+    fld->Field(&xyz[3 * it], b);
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_SMALL(bBatch[3 * it + i] - b[i], 1.e-4);
+    }
+  }
+
+  fld->AllowFastField(true);
+  const auto* fast = fld->getFastField();
+  BOOST_REQUIRE(fast != nullptr);
+  int nInside = fast->Field(ntst, xyz.data(), bBatch.data()), nInsideRef = 0;
+  for (int it = 0; it < ntst; it++) {
+    if (fast->Field(&xyz[3 * it], b)) {
+      nInsideRef++;
+      for (int i = 0; i < 3; i++) {
+        BOOST_CHECK_SMALL(bBatch[3 * it + i] - b[i], 1.e-4);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(nInside, nInsideRef);
+}
@@ -136,6 +136,10 @@ class Chebyshev3D : public TNamed
 
   Double_t Eval(const Double_t* par, int idim);
 
+  /// Evaluates Chebyshev parameterization for 3d->DimOut function at n points stored contiguously in par
+  /// (par[3*i+k] is coordinate k of point i), output dimension k of point i being stored in res[DimOut*i+k]
+  void Eval(int n, const Double_t* par, Double_t* res);
+
   void evaluateDerivative(int dimd, const Float_t* par, Float_t* res);
 
   void evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res);
@@ -169,6 +169,12 @@ class Chebyshev3DCalc : public TNamed
 
   Double_t Eval(const Double_t* par) const;
 
+  /// Evaluates Chebyshev parameterization for 3D function at n points at once.
+  /// VERY IMPORTANT: par0[i], par1[i], par2[i] must contain the arguments of point i ALREADY MAPPED to [-1:1] interval
+  void Eval(int n, const Float_t* par0, const Float_t* par1, const Float_t* par2, Float_t* res) const;
+
+  static constexpr int sBatchSize = 8; ///< number of points evaluated together in the Clenshaw recurrences
+
  private:
   Int_t mNumberOfCoefficients;    ///< total number of coeeficients
   Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
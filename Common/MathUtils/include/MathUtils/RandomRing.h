@@ -78,10 +78,20 @@ class RandomRing
   /// @return next random value
   float getNextValue()
   {
-    const float value = mRandomNumbers[mRingPosition];
-    ++mRingPosition;
-    if (mRingPosition >= mRandomNumbers.size()) {
-      mRingPosition = 0;
+    return getNextValue(mRingPosition);
+  }
+
+  /// next random value from the ring buffer using an external position
+  /// This allows several independent streams (e.g. one per thread) to share
+  /// the same ring buffer, which is only read
+  /// @param [in,out] position position in the ring buffer, increased by one
+  /// @return next random value
+  float getNextValue(size_t& position) const
+  {
+    const float value = mRandomNumbers[position];
+    ++position;
+    if (position >= mRandomNumbers.size()) {
+      position = 0;
     }
     return value;
   }
@@ -110,6 +120,10 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// size of the ring buffer
+  /// @return number of random values in the ring buffer
+  static constexpr size_t getSize() { return N; }
+
  private:
   // =========================================================================
   // ===| members |===========================================================
@@ -27,6 +27,7 @@
 #include "TMathBase.h"                 // for Max, Abs
 #include "TNamed.h"                    // for TNamed
 #include "TObjArray.h"                 // for TObjArray
+#include <vector>
 
 using namespace o2::math_utils;
 
@@ -261,6 +262,24 @@ Chebyshev3D::Chebyshev3D(void (*ptr)(float*, float*), int dimOut, const Float_t*
 }
 #endif
 
+void Chebyshev3D::Eval(int n, const Double_t* par, Double_t* res)
+{
+  // map all the points to the internal [-1:1] coordinates, stored per coordinate, then let each
+  // output dimension evaluate them in batches
+  std::vector<Float_t> mapped(3 * n), out(n);
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      mapped[k * n + i] = mapToInternal(par[3 * i + k], k);
+    }
+  }
+  for (int id = 0; id < mOutputArrayDimension; id++) {
+    getChebyshevCalc(id)->Eval(n, mapped.data(), mapped.data() + n, mapped.data() + 2 * n, out.data());
+    for (int i = 0; i < n; i++) {
+      res[mOutputArrayDimension * i + id] = out[i];
+    }
+  }
+}
+
 Chebyshev3D& Chebyshev3D::operator=(const Chebyshev3D& rhs)
 {
   // assignment operator
@@ -17,11 +17,50 @@
 #include <TSystem.h> // for TSystem, gSystem
 #include "TNamed.h"  // for TNamed
 #include "TString.h" // for TString, TString::EStripType::kBoth
+#include <vector>
 
 using namespace o2::math_utils;
 
 ClassImp(Chebyshev3DCalc);
 
+namespace
+{
+/// Evaluates 1D Chebyshev parameterization for sBatchSize points at once. x[j] is the argument of point j mapped
+/// to [-1:1] interval and the coefficient i of point j is array[i * coefStride + j * laneStride].
+/// The operations are the same as in chebyshevEvaluation1D, the loops over the points can be vectorized
+inline void chebyshevEvaluation1DBatch(const Float_t* x, const Float_t* array, int coefStride, int laneStride, int ncf,
+                                       Float_t* res)
+{
+  constexpr int nb = Chebyshev3DCalc::sBatchSize;
+  if (ncf <= 0) {
+    for (int j = 0; j < nb; j++) {
+      res[j] = 0;
+    }
+    return;
+  }
+
+  Float_t b0[nb], b1[nb], b2[nb], x2[nb];
+  --ncf;
+  for (int j = 0; j < nb; j++) {
+    x2[j] = x[j] + x[j];
+    b0[j] = array[ncf * coefStride + j * laneStride];
+    b1[j] = b2[j] = 0;
+  }
+
+  for (int i = ncf; i--;) {
+    const Float_t* cf = array + i * coefStride;
+    for (int j = 0; j < nb; j++) {
+      b2[j] = b1[j];
+      b1[j] = b0[j];
+      b0[j] = cf[j * laneStride] + x2[j] * b1[j] - b2[j];
+    }
+  }
+  for (int j = 0; j < nb; j++) {
+    res[j] = b0[j] - x[j] * b1[j];
+  }
+}
+} // namespace
+
 Chebyshev3DCalc::Chebyshev3DCalc()
   : mNumberOfCoefficients(0),
     mNumberOfRows(0),
@@ -540,3 +579,34 @@ Int_t Chebyshev3DCalc::getMaxColumnsAtRow() const
   }
   return nmax3d;
 }
+
+void Chebyshev3DCalc::Eval(int n, const Float_t* par0, const Float_t* par1, const Float_t* par2, Float_t* res) const
+{
+  // the points are processed in batches of sBatchSize, each step of the Clenshaw recurrences being done for all the
+  // points of the batch with the same coefficients. The incomplete last batch is padded with dummy points
+  constexpr int nb = sBatchSize;
+  std::vector<Float_t> tmp2D(mNumberOfColumns * nb), tmp1D(mNumberOfRows * nb);
+  Float_t x[nb], y[nb], z[nb], out[nb];
+
+  for (int first = 0; first < n; first += nb) {
+    int nLoc = (n - first < nb) ? n - first : nb;
+    for (int j = 0; j < nb; j++) {
+      x[j] = (j < nLoc) ? par0[first + j] : 0;
+      y[j] = (j < nLoc) ? par1[first + j] : 0;
+      z[j] = (j < nLoc) ? par2[first + j] : 0;
+    }
+    for (int id0 = mNumberOfRows; id0--;) {
+      int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
+      int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+      for (int id1 = nCLoc; id1--;) {
+        int id = id1 + col0;
+        chebyshevEvaluation1DBatch(z, mCoefficients + mCoefficientBound2D1[id], 1, 0, mCoefficientBound2D0[id], &tmp2D[id1 * nb]);
+      }
+      chebyshevEvaluation1DBatch(y, tmp2D.data(), nb, 1, nCLoc, &tmp1D[id0 * nb]);
+    }
+    chebyshevEvaluation1DBatch(x, tmp1D.data(), nb, 1, mNumberOfRows, out);
+    for (int j = 0; j < nLoc; j++) {
+      res[first + j] = out[j];
+    }
+  }
+}
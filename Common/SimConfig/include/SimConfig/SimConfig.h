@@ -52,6 +52,7 @@ struct SimConfigData {
   int mInternalChunkSize;                     //
   int mStartSeed;                             // base for random number seeds
   int mSimWorkers = 1;                        // number of parallel sim workers (when it applies)
+  int mMergerWorkers = 1;                     // number of threads used by the hit merger (when it applies)
   bool mFilterNoHitEvents = false;            // whether to filter out events not leaving any response
   std::string mCCDBUrl;                       // the URL where to find CCDB
   uint64_t mTimestamp;                        // timestamp in ms to anchor transport simulation to
@@ -59,8 +60,9 @@ struct SimConfigData {
   SimFieldMode mFieldMode = kDefault;         // uniform magnetic field
   bool mAsService = false;                    // if simulation should be run as service/deamon (does not exit after run)
   bool mNoGeant = false;                      // if Geant transport should be turned off (when one is only interested in the generated events)
+  bool mFlatSimData = false;                  // if hits, MCTracks and TrackRefs of POD type are sent as flat buffers from the workers to the merger
 
-  ClassDefNV(SimConfigData, 4);
+  ClassDefNV(SimConfigData, 6);
 };
 
 // A singleton class which can be used
@@ -122,10 +124,12 @@ class SimConfig
   int getInternalChunkSize() const { return mConfigData.mInternalChunkSize; }
   int getStartSeed() const { return mConfigData.mStartSeed; }
   int getNSimWorkers() const { return mConfigData.mSimWorkers; }
+  int getNMergerWorkers() const { return mConfigData.mMergerWorkers; }
   bool isFilterOutNoHitEvents() const { return mConfigData.mFilterNoHitEvents; }
   bool asService() const { return mConfigData.mAsService; }
   uint64_t getTimestamp() const { return mConfigData.mTimestamp; }
   bool isNoGeant() const { return mConfigData.mNoGeant; }
+  bool isFlatSimData() const { return mConfigData.mFlatSimData; }
 
  private:
   SimConfigData mConfigData; //!
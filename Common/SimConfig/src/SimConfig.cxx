@@ -18,6 +18,7 @@
 #include <cmath>
 #include <chrono>
 #include <regex>
+#include <algorithm>
 
 using namespace o2::conf;
 namespace bpo = boost::program_options;
@@ -51,11 +52,13 @@ void SimConfig::initOptions(boost::program_options::options_description& options
     "seed", bpo::value<int>()->default_value(-1), "initial seed (default: -1 random)")(
     "field", bpo::value<std::string>()->default_value("-5"), "L3 field rounded to kGauss, allowed values +-2,+-5 and 0; +-<intKGaus>U for uniform field; \"ccdb\" for taking it from CCDB ")(
     "nworkers,j", bpo::value<int>()->default_value(nsimworkersdefault), "number of parallel simulation workers (only for parallel mode)")(
+    "nmergerworkers", bpo::value<int>()->default_value(1), "number of threads merging and writing kinematics and hits of different detectors in the hit merger (only for parallel mode)")(
     "noemptyevents", "only writes events with at least one hit")(
     "CCDBUrl", bpo::value<std::string>()->default_value("http://alice-ccdb.cern.ch"), "URL for CCDB to be used.")(
     "timestamp", bpo::value<uint64_t>(), "global timestamp value in ms (for anchoring) - default is now")(
     "asservice", bpo::value<bool>()->default_value(false), "run in service/server mode")(
-    "noGeant", bpo::bool_switch(), "prohibits any Geant transport/physics (by using tight cuts)");
+    "noGeant", bpo::bool_switch(), "prohibits any Geant transport/physics (by using tight cuts)")(
+    "flatsimdata", bpo::bool_switch(), "send hits, MCTracks and TrackRefs of POD type as flat (shared memory) buffers instead of ROOT TMessages to the hit merger");
 }
 
 bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const& vm)
@@ -158,6 +161,7 @@ bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const&
   mConfigData.mInternalChunkSize = vm["chunkSizeI"].as<int>();
   mConfigData.mStartSeed = vm["seed"].as<int>();
   mConfigData.mSimWorkers = vm["nworkers"].as<int>();
+  mConfigData.mMergerWorkers = std::max(1, vm["nmergerworkers"].as<int>());
   if (vm.count("timestamp")) {
     mConfigData.mTimestamp = vm["timestamp"].as<uint64_t>();
   } else {
@@ -166,6 +170,7 @@ bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const&
   mConfigData.mCCDBUrl = vm["CCDBUrl"].as<std::string>();
   mConfigData.mAsService = vm["asservice"].as<bool>();
   mConfigData.mNoGeant = vm["noGeant"].as<bool>();
+  mConfigData.mFlatSimData = vm["flatsimdata"].as<bool>();
   if (vm.count("noemptyevents")) {
     mConfigData.mFilterNoHitEvents = true;
   }
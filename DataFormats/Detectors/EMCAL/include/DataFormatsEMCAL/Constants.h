@@ -104,7 +104,8 @@ enum FitAlgorithm {
   Standard = 0,  ///< Standard raw fitter
   Gamma2 = 1,    ///< Gamma2 raw fitter
   NeuralNet = 2, ///< Neural net raw fitter
-  NONE = 3
+  Fast = 3,      ///< Lookup table raw fitter
+  NONE = 4
 };
 
 } // namespace emcal
@@ -27,6 +27,7 @@
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include <gsl/span>
 #include <memory>
+#include <memory_resource>
 
 // We forward declare the internal structures, to reduce header dependencies.
 // Please include headers for TPC Hits or TRD tracklets directly (DataFormatsTPC/WorkflowHelper.h / DataFormatsTRD/RecoInputContainer.h)
@@ -301,6 +302,8 @@ struct RecoContainer {
   std::unique_ptr<o2::tpc::internal::getWorkflowTPCInput_ret> inputsTPCclusters; // special struct for TPC clusters access
   std::unique_ptr<o2::trd::RecoInputContainer> inputsTRD;                        // special struct for TRD tracklets, trigger records
 
+  std::pmr::memory_resource* transientResource = nullptr; ///< for the temporary buffers, the TransientArena of the device when available
+
   void collectData(o2::framework::ProcessingContext& pc, const DataRequest& request);
   void createTracks(std::function<bool(const o2::track::TrackParCov&, GTrackID)> const& creator) const;
   template <class T>
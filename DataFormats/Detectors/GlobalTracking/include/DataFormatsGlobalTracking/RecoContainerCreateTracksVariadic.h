@@ -74,7 +74,8 @@ void o2::globaltracking::RecoContainer::createTracksVariadic(T creator) const
 
   auto start_time = std::chrono::high_resolution_clock::now();
   constexpr float PS2MUS = 1e-6;
-  std::array<std::vector<uint8_t>, GTrackID::NSources> usedData;
+  // the flags only live during this call, the TransientArena of the processing iteration is well suited
+  std::pmr::vector<std::pmr::vector<uint8_t>> usedData(GTrackID::NSources, transientResource ? transientResource : std::pmr::get_default_resource());
   auto flagUsed2 = [&usedData](int idx, int src) {
     if (!usedData[src].empty()) {
       usedData[src][idx] = 1;
@@ -36,6 +36,8 @@
 #include "Framework/ProcessingContext.h"
 #include "Framework/DataRefUtils.h"
 #include "Framework/CCDBParamSpec.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/TransientArena.h"
 
 using namespace o2::globaltracking;
 using namespace o2::framework;
@@ -485,6 +487,7 @@ void RecoContainer::collectData(ProcessingContext& pc, const DataRequest& reques
 
   const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(pc.inputs().getFirstValid(true));
   startIR = {0, dh->firstTForbit};
+  transientResource = pc.services().active<TransientArena>() ? &pc.services().get<TransientArena>() : nullptr;
 
   auto req = reqMap.find("trackITS");
   if (req != reqMap.end()) {
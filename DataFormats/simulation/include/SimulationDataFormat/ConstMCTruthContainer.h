@@ -32,7 +32,8 @@ namespace dataformats
 /// This provides access functionality to MCTruthContainer with optimized linear storage
 /// so that the data can easily be shared in memory or sent over network.
 /// This container needs to be initialized by calling "flatten_to" from an existing
-/// MCTruthContainer
+/// MCTruthContainer. The plain and the implicit index layouts can be accessed directly,
+/// the encoded one needs to be restored into a MCTruthContainer.
 template <typename TruthElement>
 class ConstMCTruthContainer : public std::vector<char>
 {
@@ -44,14 +45,14 @@ class ConstMCTruthContainer : public std::vector<char>
   // const data access
   // get individual const "view" container for a given data index
   // the caller can't do modifications on this view
-  MCTruthHeaderElement const& getMCTruthHeader(uint32_t dataindex) const
+  MCTruthHeaderElement getMCTruthHeader(uint32_t dataindex) const
   {
-    return getHeaderStart()[dataindex];
+    return hasImplicitIndex() ? MCTruthHeaderElement(dataindex) : getHeaderStart()[dataindex];
   }
 
   gsl::span<const TruthElement> getLabels(uint32_t dataindex) const
   {
-    if (dataindex >= getIndexedSize()) {
+    if (dataindex >= getIndexedSize() || isEncoded()) {
       return gsl::span<const TruthElement>();
     }
     const auto start = getMCTruthHeader(dataindex).index;
@@ -59,6 +60,23 @@ class ConstMCTruthContainer : public std::vector<char>
     return gsl::span<const TruthElement>(&labelsptr[start], getSize(dataindex));
   }
 
+  // bulk access to all labels, in order of the data index
+  // (empty for the encoded layout, which needs to be restored to a MCTruthContainer first)
+  gsl::span<const TruthElement> getTruthArray() const
+  {
+    if (isEncoded()) {
+      return gsl::span<const TruthElement>();
+    }
+    return gsl::span<const TruthElement>(getLabelStart(), getNElements());
+  }
+
+  // true if every data index has exactly one label, which is then the label at the same position
+  // of getTruthArray(); allows to process the labels without any indirection
+  bool hasImplicitIndex() const { return getVersion() == MCTruthContainer<TruthElement>::ImplicitIndex; }
+
+  // true if the labels are delta encoded and can't be accessed directly
+  bool isEncoded() const { return getVersion() == MCTruthContainer<TruthElement>::Encoded; }
+
   // return the number of original data indexed here
   size_t getIndexedSize() const { return size() >= sizeof(FlatHeader) ? getHeader().nofHeaderElements : 0; }
 
@@ -68,15 +86,22 @@ class ConstMCTruthContainer : public std::vector<char>
  private:
   using FlatHeader = typename MCTruthContainer<TruthElement>::FlatHeader;
 
+  size_t getBufferSize() const { return size(); }
+
   size_t getSize(uint32_t dataindex) const
   {
     // calculate size / number of labels from a difference in pointed indices
+    if (hasImplicitIndex()) {
+      return 1;
+    }
     const auto size = (dataindex < getIndexedSize() - 1)
                         ? getMCTruthHeader(dataindex + 1).index - getMCTruthHeader(dataindex).index
                         : getNElements() - getMCTruthHeader(dataindex).index;
     return size;
   }
 
+  uint8_t getVersion() const { return getBufferSize() >= sizeof(FlatHeader) ? getHeader().version : 0; }
+
   /// Restore internal vectors from a raw buffer
   /// The two vectors are resized according to the information in the \a FlatHeader
   /// struct at the beginning of the buffer. Data is copied to the vectors.
@@ -85,7 +110,7 @@ class ConstMCTruthContainer : public std::vector<char>
     auto* source = &(*this)[0];
     auto flatheader = getHeader();
     source += sizeof(FlatHeader);
-    const size_t headerSize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
+    const size_t headerSize = flatheader.sizeofHeaderElement * MCTruthContainer<TruthElement>::getNStoredHeaderElements(flatheader);
     source += headerSize;
     return (TruthElement const*)source;
   }
@@ -142,14 +167,14 @@ class ConstMCTruthContainerView
   // const data access
   // get individual const "view" container for a given data index
   // the caller can't do modifications on this view
-  MCTruthHeaderElement const& getMCTruthHeader(uint32_t dataindex) const
+  MCTruthHeaderElement getMCTruthHeader(uint32_t dataindex) const
   {
-    return getHeaderStart()[dataindex];
+    return hasImplicitIndex() ? MCTruthHeaderElement(dataindex) : getHeaderStart()[dataindex];
   }
 
   gsl::span<const TruthElement> getLabels(uint32_t dataindex) const
   {
-    if (dataindex >= getIndexedSize()) {
+    if (dataindex >= getIndexedSize() || isEncoded()) {
       return gsl::span<const TruthElement>();
     }
     const auto start = getMCTruthHeader(dataindex).index;
@@ -157,6 +182,23 @@ class ConstMCTruthContainerView
     return gsl::span<const TruthElement>(&labelsptr[start], getSize(dataindex));
   }
 
+  // bulk access to all labels, in order of the data index
+  // (empty for the encoded layout, which needs to be restored to a MCTruthContainer first)
+  gsl::span<const TruthElement> getTruthArray() const
+  {
+    if (isEncoded()) {
+      return gsl::span<const TruthElement>();
+    }
+    return gsl::span<const TruthElement>(getLabelStart(), getNElements());
+  }
+
+  // true if every data index has exactly one label, which is then the label at the same position
+  // of getTruthArray(); allows to process the labels without any indirection
+  bool hasImplicitIndex() const { return getVersion() == MCTruthContainer<TruthElement>::ImplicitIndex; }
+
+  // true if the labels are delta encoded and can't be accessed directly
+  bool isEncoded() const { return getVersion() == MCTruthContainer<TruthElement>::Encoded; }
+
   // return the number of original data indexed here
   size_t getIndexedSize() const { return (size_t)mStorage.size() >= sizeof(FlatHeader) ? getHeader().nofHeaderElements : 0; }
 
@@ -171,15 +213,22 @@ class ConstMCTruthContainerView
 
   using FlatHeader = typename MCTruthContainer<TruthElement>::FlatHeader;
 
+  size_t getBufferSize() const { return mStorage.size(); }
+
   size_t getSize(uint32_t dataindex) const
   {
     // calculate size / number of labels from a difference in pointed indices
+    if (hasImplicitIndex()) {
+      return 1;
+    }
     const auto size = (dataindex < getIndexedSize() - 1)
                         ? getMCTruthHeader(dataindex + 1).index - getMCTruthHeader(dataindex).index
                         : getNElements() - getMCTruthHeader(dataindex).index;
     return size;
   }
 
+  uint8_t getVersion() const { return getBufferSize() >= sizeof(FlatHeader) ? getHeader().version : 0; }
+
   /// Restore internal vectors from a raw buffer
   /// The two vectors are resized according to the information in the \a FlatHeader
   /// struct at the beginning of the buffer. Data is copied to the vectors.
@@ -188,7 +237,7 @@ class ConstMCTruthContainerView
     auto* source = &(mStorage)[0];
     auto flatheader = getHeader();
     source += sizeof(FlatHeader);
-    const size_t headerSize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
+    const size_t headerSize = flatheader.sizeofHeaderElement * MCTruthContainer<TruthElement>::getNStoredHeaderElements(flatheader);
     source += headerSize;
     return (TruthElement const*)source;
   }
@@ -57,6 +57,11 @@ struct MCTruthHeaderElement {
 /// multiple truth elements can be associated with one object, the header array stores the start
 /// of the associated truth element sequence.
 ///
+/// The flat buffer comes in different layouts (see @ref FlatVersion): the plain one, a compact one
+/// without header array when every data index has exactly one truth element (the most common case, the
+/// index is then implicit), and a delta encoded one with variable length integers for storage/streaming.
+/// The const containers/views give direct access to the plain and the implicit index layouts.
+///
 /// Since the class contains two subsequent vectors, it is not POD even if the TruthElement is
 /// POD. ROOT serialization is rather inefficient and in addition has a large memory footprint
 /// if the container has lots of (>1000000) elements. between 3 and 4x more than the actual
@@ -94,6 +99,7 @@ class MCTruthContainer
   /// TODO: use polymorphic allocator so that it can work on an underlying custom memory resource,
   /// e.g. directly on the memory of the incoming message.
   std::vector<char> mStreamerData; // buffer used for streaming a flat raw buffer
+  uint8_t mStreamerVersion = 1;    //! layout of the flat raw buffer used for streaming (see FlatVersion)
 
   size_t getSize(uint32_t dataindex) const
   {
@@ -133,6 +139,19 @@ class MCTruthContainer
     uint32_t nofTruthElements;
   };
 
+  /// Layouts of the flat buffer, stored as version in the \a FlatHeader
+  enum FlatVersion : uint8_t {
+    Plain = 1,         ///< header elements followed by the truth elements
+    ImplicitIndex = 2, ///< truth elements only, every data index has exactly one truth element
+    Encoded = 3        ///< delta encoded header indices and truth elements as variable length integers
+  };
+
+  /// number of header elements physically stored in a flat buffer of the plain or implicit index layout
+  static size_t getNStoredHeaderElements(FlatHeader const& flatheader)
+  {
+    return flatheader.version == ImplicitIndex ? 0 : flatheader.nofHeaderElements;
+  }
+
   // access
   MCTruthHeaderElement const& getMCTruthHeader(uint32_t dataindex) const { return mHeaderArray[dataindex]; }
   // access the element directly (can be encapsulated better away)... needs proper element index
@@ -148,6 +167,23 @@ class MCTruthContainer
     return mTruthArray;
   }
 
+  // true if every data index has exactly one element, the index can then be implicit
+  bool hasSingleElementPerIndex() const
+  {
+    if (mHeaderArray.size() != mTruthArray.size()) {
+      return false;
+    }
+    for (uint32_t i = 0; i < mHeaderArray.size(); ++i) {
+      if (mHeaderArray[i].index != i) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // set the layout of the flat buffer used when streaming (see FlatVersion)
+  void setStreamerVersion(uint8_t version) { mStreamerVersion = version; }
+
   // get individual "view" container for a given data index
   // the caller can do modifications on this view (such as sorting)
   gsl::span<TruthElement> getLabels(uint32_t dataindex)
@@ -328,21 +364,32 @@ class MCTruthContainer
   /// Copies the content of the two vectors of PODs to a contiguous container.
   /// The flattened data starts with a specific header @ref FlatHeader describing
   /// size and content of the two vectors within the raw buffer.
+  /// The layout is given by \a version (see @ref FlatVersion). The implicit index layout
+  /// falls back to the plain one if a data index has not exactly one truth element, the
+  /// encoded layout is only available for 64 bit truth elements (such as MCCompLabel).
   template <typename ContainerType>
-  size_t flatten_to(ContainerType& container) const
+  size_t flatten_to(ContainerType& container, uint8_t version = Plain) const
   {
-    size_t bufferSize = sizeof(FlatHeader) + sizeof(MCTruthHeaderElement) * mHeaderArray.size() + sizeof(TruthElement) * mTruthArray.size();
-    container.resize((bufferSize / sizeof(typename ContainerType::value_type)) + ((bufferSize % sizeof(typename ContainerType::value_type)) > 0 ? 1 : 0));
-    char* target = reinterpret_cast<char*>(container.data());
+    if constexpr (sizeof(TruthElement) == sizeof(uint64_t)) {
+      if (version == Encoded) {
+        return encode_to(container);
+      }
+    }
+    if (version != ImplicitIndex || !hasSingleElementPerIndex()) {
+      version = Plain;
+    }
+    const size_t nStoredHeaderElements = (version == ImplicitIndex) ? 0 : mHeaderArray.size();
+    size_t bufferSize = sizeof(FlatHeader) + sizeof(MCTruthHeaderElement) * nStoredHeaderElements + sizeof(TruthElement) * mTruthArray.size();
+    char* target = resizeFlatContainer(container, bufferSize);
     auto& flatheader = *reinterpret_cast<FlatHeader*>(target);
     target += sizeof(FlatHeader);
-    flatheader.version = 1;
+    flatheader.version = version;
     flatheader.sizeofHeaderElement = sizeof(MCTruthHeaderElement);
     flatheader.sizeofTruthElement = sizeof(TruthElement);
     flatheader.reserved = 0;
     flatheader.nofHeaderElements = mHeaderArray.size();
     flatheader.nofTruthElements = mTruthArray.size();
-    size_t copySize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
+    size_t copySize = flatheader.sizeofHeaderElement * nStoredHeaderElements;
     memcpy(target, mHeaderArray.data(), copySize);
     target += copySize;
     copySize = flatheader.sizeofTruthElement * flatheader.nofTruthElements;
@@ -361,14 +408,19 @@ class MCTruthContainer
     auto* source = buffer;
     auto& flatheader = *reinterpret_cast<FlatHeader const*>(source);
     source += sizeof(FlatHeader);
-    if (bufferSize < sizeof(FlatHeader) + flatheader.sizeofHeaderElement * flatheader.nofHeaderElements + flatheader.sizeofTruthElement * flatheader.nofTruthElements) {
-      throw std::runtime_error("inconsistent buffer size: too small");
-      return;
-    }
     if (flatheader.sizeofHeaderElement != sizeof(MCTruthHeaderElement) || flatheader.sizeofTruthElement != sizeof(TruthElement)) {
       // not yet handled
       throw std::runtime_error("member element sizes don't match");
     }
+    if (flatheader.version == Encoded) {
+      decode_from(flatheader, reinterpret_cast<const uint8_t*>(source), reinterpret_cast<const uint8_t*>(buffer + bufferSize));
+      return;
+    }
+    const size_t nStoredHeaderElements = getNStoredHeaderElements(flatheader);
+    if (bufferSize < sizeof(FlatHeader) + flatheader.sizeofHeaderElement * nStoredHeaderElements + flatheader.sizeofTruthElement * flatheader.nofTruthElements) {
+      throw std::runtime_error("inconsistent buffer size: too small");
+      return;
+    }
     // TODO: with a spectator memory ressource the vectors can be built directly
     // over the original buffer, there is the implementation for a memory ressource
     // working on a FairMQ message, here we would need two memory resources over
@@ -376,7 +428,12 @@ class MCTruthContainer
     // for now doing a copy
     mHeaderArray.resize(flatheader.nofHeaderElements);
     mTruthArray.resize(flatheader.nofTruthElements);
-    size_t copySize = flatheader.sizeofHeaderElement * flatheader.nofHeaderElements;
+    if (nStoredHeaderElements == 0) {
+      for (uint32_t i = 0; i < mHeaderArray.size(); ++i) {
+        mHeaderArray[i].index = i;
+      }
+    }
+    size_t copySize = flatheader.sizeofHeaderElement * nStoredHeaderElements;
     memcpy(mHeaderArray.data(), source, copySize);
     source += copySize;
     copySize = flatheader.sizeofTruthElement * flatheader.nofTruthElements;
@@ -417,10 +474,114 @@ class MCTruthContainer
       return;
     }
     mStreamerData.clear();
-    flatten_to(mStreamerData);
+    flatten_to(mStreamerData, mStreamerVersion);
     clear();
   }
 
+ private:
+  template <typename ContainerType>
+  static char* resizeFlatContainer(ContainerType& container, size_t bufferSize)
+  {
+    container.resize((bufferSize / sizeof(typename ContainerType::value_type)) + ((bufferSize % sizeof(typename ContainerType::value_type)) > 0 ? 1 : 0));
+    return reinterpret_cast<char*>(container.data());
+  }
+
+  static uint64_t zigzagEncode(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+  static int64_t zigzagDecode(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+  static void writeVarInt(std::vector<uint8_t>& output, uint64_t value)
+  {
+    while (value >= 0x80) {
+      output.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    output.push_back(static_cast<uint8_t>(value));
+  }
+
+  static uint64_t readVarInt(const uint8_t*& source, const uint8_t* end)
+  {
+    uint64_t value = 0;
+    for (int shift = 0; source < end && shift < 64; shift += 7) {
+      const uint8_t byte = *source++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw std::runtime_error("inconsistent buffer: truncated variable length integer");
+  }
+
+  /// Encoded layout: the header indices (omitted if implicit, flagged in FlatHeader::reserved) and the
+  /// raw 64 bit truth elements are stored as zigzag variable length integers of the difference to the
+  /// previous value. For MCCompLabels of the same event and source this is the difference of the track IDs,
+  /// which typically fits into one or two bytes.
+  template <typename ContainerType>
+  size_t encode_to(ContainerType& container) const
+  {
+    const bool implicitIndex = hasSingleElementPerIndex();
+    std::vector<uint8_t> encoded;
+    encoded.reserve(2 * mTruthArray.size() + (implicitIndex ? 0 : mHeaderArray.size()));
+    if (!implicitIndex) {
+      int64_t previous = 0;
+      for (auto const& header : mHeaderArray) {
+        writeVarInt(encoded, zigzagEncode(static_cast<int64_t>(header.index) - previous));
+        previous = header.index;
+      }
+    }
+    uint64_t previous = 0;
+    for (auto const& element : mTruthArray) {
+      uint64_t raw;
+      memcpy(&raw, &element, sizeof(raw));
+      writeVarInt(encoded, zigzagEncode(static_cast<int64_t>(raw - previous)));
+      previous = raw;
+    }
+
+    const size_t bufferSize = sizeof(FlatHeader) + encoded.size();
+    char* target = resizeFlatContainer(container, bufferSize);
+    auto& flatheader = *reinterpret_cast<FlatHeader*>(target);
+    flatheader.version = Encoded;
+    flatheader.sizeofHeaderElement = sizeof(MCTruthHeaderElement);
+    flatheader.sizeofTruthElement = sizeof(TruthElement);
+    flatheader.reserved = implicitIndex ? 1 : 0;
+    flatheader.nofHeaderElements = mHeaderArray.size();
+    flatheader.nofTruthElements = mTruthArray.size();
+    memcpy(target + sizeof(FlatHeader), encoded.data(), encoded.size());
+    return bufferSize;
+  }
+
+  void decode_from(FlatHeader const& flatheader, const uint8_t* source, const uint8_t* end)
+  {
+    if constexpr (sizeof(TruthElement) != sizeof(uint64_t)) {
+      throw std::runtime_error("encoded layout is only supported for 64 bit truth elements");
+    } else {
+      decode_from_impl(flatheader, source, end);
+    }
+  }
+
+  void decode_from_impl(FlatHeader const& flatheader, const uint8_t* source, const uint8_t* end)
+  {
+    mHeaderArray.resize(flatheader.nofHeaderElements);
+    mTruthArray.resize(flatheader.nofTruthElements);
+    if (flatheader.reserved & 1) {
+      for (uint32_t i = 0; i < mHeaderArray.size(); ++i) {
+        mHeaderArray[i].index = i;
+      }
+    } else {
+      int64_t previous = 0;
+      for (auto& header : mHeaderArray) {
+        previous += zigzagDecode(readVarInt(source, end));
+        header.index = static_cast<uint32_t>(previous);
+      }
+    }
+    uint64_t previous = 0;
+    for (auto& element : mTruthArray) {
+      previous += static_cast<uint64_t>(zigzagDecode(readVarInt(source, end)));
+      memcpy(static_cast<void*>(&element), &previous, sizeof(previous));
+    }
+  }
+
+ public:
+
   ClassDefNV(MCTruthContainer, 2);
 }; // end class
 
@@ -200,6 +200,75 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_flatten)
   BOOST_CHECK(cc.getLabels(2)[0] == 10);
 }
 
+BOOST_AUTO_TEST_CASE(MCTruthContainer_compact)
+{
+  using TruthContainer = dataformats::MCLabelContainer;
+  TruthContainer container;
+  const int n = 1000;
+  for (int i = 0; i < n; ++i) {
+    container.addElement(i, MCCompLabel(100 + i / 3, 5, 0));
+  }
+  BOOST_CHECK(container.hasSingleElementPerIndex());
+
+  // implicit index layout: no header elements stored
+  std::vector<char> plain, compact;
+  container.flatten_to(plain);
+  container.flatten_to(compact, TruthContainer::ImplicitIndex);
+  BOOST_CHECK(compact.size() == sizeof(TruthContainer::FlatHeader) + n * sizeof(MCCompLabel));
+  BOOST_CHECK(compact.size() < plain.size());
+
+  dataformats::ConstMCLabelContainer cc;
+  container.flatten_to(cc, TruthContainer::ImplicitIndex);
+  dataformats::ConstMCLabelContainerView view(cc);
+  BOOST_CHECK(cc.hasImplicitIndex());
+  BOOST_CHECK(view.hasImplicitIndex());
+  BOOST_CHECK(view.getIndexedSize() == n);
+  BOOST_CHECK(view.getTruthArray().size() == n);
+  for (uint32_t i = 0; i < n; ++i) {
+    BOOST_CHECK(view.getMCTruthHeader(i).index == i);
+    BOOST_CHECK(view.getLabels(i).size() == 1);
+    BOOST_CHECK(view.getLabels(i)[0] == container.getLabels(i)[0]);
+    BOOST_CHECK(view.getTruthArray()[i] == container.getElement(i));
+  }
+
+  // conversion back to the plain layout
+  TruthContainer restored;
+  restored.restore_from(compact.data(), compact.size());
+  std::vector<char> replain;
+  restored.flatten_to(replain);
+  BOOST_CHECK(replain == plain);
+
+  // with a second label for one index the implicit index is not possible anymore
+  container.addElement(n - 1, MCCompLabel(7, 5, 0, true));
+  container.addElement(n + 3, MCCompLabel(8, 6, 1));
+  BOOST_CHECK(!container.hasSingleElementPerIndex());
+  container.flatten_to(cc, TruthContainer::ImplicitIndex);
+  BOOST_CHECK(!cc.hasImplicitIndex());
+  BOOST_CHECK(cc.getLabels(n - 1).size() == 2);
+  BOOST_CHECK(cc.getLabels(n + 1).size() == 0);
+  BOOST_CHECK(cc.getLabels(n + 3)[0] == MCCompLabel(8, 6, 1));
+
+  // encoded layout: delta encoded labels, to be restored before use
+  std::vector<char> encoded;
+  container.flatten_to(plain);
+  container.flatten_to(encoded, TruthContainer::Encoded);
+  BOOST_CHECK(encoded.size() < plain.size() / 4);
+  container.flatten_to(cc, TruthContainer::Encoded);
+  BOOST_CHECK(cc.isEncoded());
+  BOOST_CHECK(cc.getIndexedSize() == container.getIndexedSize());
+  BOOST_CHECK(cc.getLabels(0).size() == 0);
+
+  restored.restore_from(encoded.data(), encoded.size());
+  BOOST_REQUIRE(restored.getIndexedSize() == container.getIndexedSize());
+  BOOST_REQUIRE(restored.getNElements() == container.getNElements());
+  for (size_t i = 0; i < container.getIndexedSize(); ++i) {
+    BOOST_CHECK(restored.getMCTruthHeader(i).index == container.getMCTruthHeader(i).index);
+  }
+  for (size_t i = 0; i < container.getNElements(); ++i) {
+    BOOST_CHECK(restored.getElement(i).getRawValue() == container.getElement(i).getRawValue());
+  }
+}
+
 BOOST_AUTO_TEST_CASE(LabelContainer_noncont)
 {
   using TruthElement = long;
@@ -206,6 +206,7 @@ class AODProducerWorkflowDPL : public Task
   int mRunNumber{-1};
   int mTruncate{1};
   int mRecoOnly{0};
+  int mNThreads{1}; // number of threads used to process the barrel tracks
   o2::InteractionRecord mStartIR{}; // TF 1st IR
   TString mResFile{"AO2D"};
   TString mLPMProdTag{""};
@@ -316,6 +317,10 @@ class AODProducerWorkflowDPL : public Task
     int bcSlice[2] = {-1, -1};
   };
 
+  // barrel tracks extra info precomputed in parallel by processBarrelTracks(), used when filling the tables
+  std::vector<TrackExtraInfo> mBarrelTrackInfos;
+  std::vector<int> mBarrelTrackInfoIndex; // index in mBarrelTrackInfos for each entry of the vertex-track indices, -1 if not precomputed
+
   // helper struct for mc track labels
   // using -1 as dummies for AOD
   struct MCLabels {
@@ -355,6 +360,12 @@ class AODProducerWorkflowDPL : public Task
 
   TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
 
+  // precompute the extra info of the barrel tracks of all collisions (unassigned tracks first) with mNThreads threads,
+  // the tables are then filled sequentially such that the order of the rows does not depend on the number of threads
+  void processBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                           const std::vector<std::uint64_t>& collisionBCs, const o2::globaltracking::RecoContainer& data,
+                           const std::map<uint64_t, int>& bcsMap);
+
   void cacheTriggers(const o2::globaltracking::RecoContainer& recoData);
 
   // helper for track tables
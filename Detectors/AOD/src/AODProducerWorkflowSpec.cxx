@@ -71,8 +71,13 @@
 #include "TMatrixD.h"
 #include "TString.h"
 #include "TObjString.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <vector>
 
@@ -330,7 +335,8 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           if (trackIndex.isAmbiguous() && mGIDToTableID.find(trackIndex) != mGIDToTableID.end()) { // was it already stored ?
             continue;
           }
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+          int infoIndex = mBarrelTrackInfoIndex.empty() ? -1 : mBarrelTrackInfoIndex[ti];
+          auto extraInfoHolder = infoIndex >= 0 ? mBarrelTrackInfos[infoIndex] : processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
           if (extraInfoHolder.trackTimeRes < 0.f) { // failed or rejected?
             LOG(warning) << "Barrel track " << trackIndex << " has no time set, rejection is not expected : time=" << extraInfoHolder.trackTime
                          << " timeErr=" << extraInfoHolder.trackTimeRes << " BCSlice: " << extraInfoHolder.bcSlice[0] << ":" << extraInfoHolder.bcSlice[1];
@@ -1036,6 +1042,7 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   mRecoOnly = ic.options().get<int>("reco-mctracks-only");
   mTruncate = ic.options().get<int>("enable-truncation");
   mRunNumber = ic.options().get<int>("run-number");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
 
   if (mTFNumber == -1L) {
     LOG(info) << "TFNumber will be obtained from CCDB";
@@ -1043,6 +1050,13 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   if (mRunNumber == -1L) {
     LOG(info) << "The Run number will be obtained from DPL headers";
   }
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "Compiled without OpenMP, barrel tracks will be processed in a single thread";
+    mNThreads = 1;
+  }
+#endif
+  LOG(info) << "Processing barrel tracks with " << mNThreads << " thread(s)";
 
   // set no truncation if selected by user
   if (mTruncate != 1) {
@@ -1484,6 +1498,17 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   cacheTriggers(recoData);
 
+  // the expensive part of the barrel tracks processing is done upfront for all collisions in parallel,
+  // the tables are then filled sequentially in the usual order
+  if (mNThreads > 1 && !primVer2TRefs.empty()) {
+    std::vector<std::uint64_t> collisionBCs;
+    collisionBCs.reserve(primVertices.size());
+    for (auto& vertex : primVertices) {
+      collisionBCs.push_back(relativeTime_to_GlobalBC(vertex.getTimeStamp().getTimeStamp() * 1E3));
+    }
+    processBarrelTracks(primVer2TRefs, primVerGIs, collisionBCs, recoData, bcsMap);
+  }
+
   // filling unassigned tracks first
   // so that all unassigned tracks are stored in the beginning of the table together
   auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
@@ -1606,6 +1631,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
   }
   mToStore.clear();
+  mBarrelTrackInfos.clear();
+  mBarrelTrackInfoIndex.clear();
   mGIDToTableID.clear();
   mTableTrID = 0;
   mGIDToTableFwdID.clear();
@@ -1796,6 +1823,53 @@ AODProducerWorkflowDPL::TrackExtraInfo AODProducerWorkflowDPL::processBarrelTrac
   return extraInfoHolder;
 }
 
+void AODProducerWorkflowDPL::processBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                                                 const std::vector<std::uint64_t>& collisionBCs, const o2::globaltracking::RecoContainer& data,
+                                                 const std::map<uint64_t, int>& bcsMap)
+{
+  // collect the barrel tracks in the order in which fillTrackTablesPerCollision will store them,
+  // ambiguous tracks are processed only for their first occurrence
+  struct BarrelTrackTask {
+    int collisionID;
+    std::uint64_t collisionBC;
+    GIndex trackIndex;
+  };
+  std::vector<BarrelTrackTask> tasks;
+  std::unordered_set<GIndex> ambiguousSeen;
+  mBarrelTrackInfoIndex.assign(GIndices.size(), -1);
+  auto collectTracks = [&](int collisionID, std::uint64_t collisionBC, const o2::dataformats::VtxTrackRef& trackRef) {
+    for (int src = GIndex::NSources; src--;) {
+      if (!GIndex::includesSource(src, mInputSources) || src == GIndex::Source::MFT || src == GIndex::Source::MCH || src == GIndex::Source::MFTMCH) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        const auto& trackIndex = GIndices[ti];
+        if (trackIndex.isAmbiguous() && !ambiguousSeen.insert(trackIndex).second) {
+          continue;
+        }
+        mBarrelTrackInfoIndex[ti] = tasks.size();
+        tasks.push_back({collisionID, collisionBC, trackIndex});
+      }
+    }
+  };
+  collectTracks(-1, std::uint64_t(-1), primVer2TRefs.back());
+  for (int collisionID = 0; collisionID < (int)collisionBCs.size(); collisionID++) {
+    collectTracks(collisionID, collisionBCs[collisionID], primVer2TRefs[collisionID]);
+  }
+
+  mBarrelTrackInfos.resize(tasks.size());
+  const int ntasks = tasks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(mNThreads)
+#endif
+  for (int itask = 0; itask < ntasks; itask++) {
+    const auto& task = tasks[itask];
+    mBarrelTrackInfos[itask] = processBarrelTrack(task.collisionID, task.collisionBC, task.trackIndex, data, bcsMap);
+  }
+}
+
 void AODProducerWorkflowDPL::updateTimeDependentParams(ProcessingContext& pc)
 {
   // here we follow eventual updates of CCDB objects this processor depends on
@@ -1989,7 +2063,8 @@ DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool enableSV, boo
       ConfigParamSpec{"anchor-pass", VariantType::String, "", {"AnchorPassName"}},
       ConfigParamSpec{"anchor-prod", VariantType::String, "", {"AnchorProduction"}},
       ConfigParamSpec{"reco-pass", VariantType::String, "", {"RecoPassName"}},
-      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}}};
+      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}},
+      ConfigParamSpec{"nthreads", VariantType::Int, 1, {"Number of threads used to process the barrel tracks"}}}};
 }
 
 } // namespace o2::aodproducer
@@ -277,6 +277,69 @@ T decodeTMessage(FairMQParts& dataparts, int index)
 
 void attachDetIDHeaderMessage(int id, FairMQChannel& channel, FairMQParts& parts);
 
+// a trait to determine if a container can be sent as a flat buffer of its elements
+// (instead of being serialized using TMessage)
+template <typename Container>
+struct IsFlatTransportable : std::false_type {
+};
+
+template <typename T>
+struct IsFlatTransportable<std::vector<T>> : std::is_trivially_copyable<T> {
+};
+
+/// whether flat transport of simulation data is asked for in the simulation configuration
+bool useFlatSimData();
+
+void attachFlatMessageCore(void const* data, size_t elementsize, size_t nelements, FairMQChannel& channel, FairMQParts& parts);
+void* decodeFlatMessageCore(FairMQParts& dataparts, int index, size_t elementsize, void* (*make)(void const* data, size_t nelements));
+
+/// attaches the elements of a vector of POD type as one flat message (in shared memory if this
+/// is the transport of the channel) without any streaming
+template <typename Container>
+void attachFlatMessage(Container const& data, FairMQChannel& channel, FairMQParts& parts)
+{
+  static_assert(IsFlatTransportable<Container>::value, "flat transport requires a vector of trivially copyable elements");
+  attachFlatMessageCore(data.data(), sizeof(typename Container::value_type), data.size(), channel, parts);
+}
+
+/// decodes a message created with attachFlatMessage into a new container
+template <typename Container>
+Container* decodeFlatMessage(FairMQParts& dataparts, int index)
+{
+  using T = typename Container::value_type;
+  auto make = [](void const* data, size_t nelements) -> void* {
+    auto first = static_cast<T const*>(data);
+    return new Container(first, first + nelements);
+  };
+  return static_cast<Container*>(decodeFlatMessageCore(dataparts, index, sizeof(T), make));
+}
+
+/// attaches simulation data (hits, MCTracks, TrackRefs) as flat message when asked for and possible,
+/// as TMessage otherwise
+template <typename Container>
+void attachSimDataMessage(Container const& data, FairMQChannel& channel, FairMQParts& parts)
+{
+  if constexpr (IsFlatTransportable<Container>::value) {
+    if (useFlatSimData()) {
+      attachFlatMessage(data, channel, parts);
+      return;
+    }
+  }
+  attachTMessage(data, channel, parts);
+}
+
+/// decodes simulation data attached with attachSimDataMessage
+template <typename Container>
+Container* decodeSimDataMessage(FairMQParts& dataparts, int index)
+{
+  if constexpr (IsFlatTransportable<Container>::value) {
+    if (useFlatSimData()) {
+      return decodeFlatMessage<Container>(dataparts, index);
+    }
+  }
+  return decodeTMessage<Container*>(dataparts, index);
+}
+
 template <typename T>
 TBranch* getOrMakeBranch(TTree& tree, const char* brname, T* ptr)
 {
@@ -342,7 +405,7 @@ class DetImpl : public o2::base::Detector
 
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-        attachTMessage(*hits, channel, parts);
+        attachSimDataMessage(*hits, channel, parts);
       } else {
         // this is the shared mem variant
         // we will just send the sharedmem ID and the offset inside
@@ -540,7 +603,8 @@ class DetImpl : public o2::base::Detector
     using HitPtr_t = decltype(static_cast<Det*>(this)->Det::getHits(probe));
     std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
 
-    auto copyToBuffer = [this, eventID](HitPtr_t hitdata, Collector_t& collectbuffer, int probe) {
+    // when owning is set, the buffer takes over hitdata instead of copying it
+    auto copyToBuffer = [this, eventID](HitPtr_t hitdata, Collector_t& collectbuffer, int probe, bool owning = false) {
       std::vector<std::vector<std::unique_ptr<Hit_t>>>* hitvector = nullptr;
       {
         auto eventIter = collectbuffer.find(eventID);
@@ -554,6 +618,10 @@ class DetImpl : public o2::base::Detector
       if (probe >= hitvector->size()) {
         hitvector->resize(probe + 1);
       }
+      if (owning) {
+        (*hitvector)[probe].emplace_back(hitdata);
+        return;
+      }
       // add empty hit bucket to list for this event and probe
       (*hitvector)[probe].emplace_back(new Hit_t());
       // copy the data into this bucket
@@ -563,11 +631,10 @@ class DetImpl : public o2::base::Detector
     while (name.size() > 0) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<HitPtr_t>(parts, index++);
+        auto hitsptr = decodeSimDataMessage<Hit_t>(parts, index++);
         if (hitsptr) {
-          // ... and copy them to the buffer
-          copyToBuffer(hitsptr, hitcollector, probe);
-          delete hitsptr;
+          // ... and move them to the buffer (the decoded object is ours)
+          copyToBuffer(hitsptr, hitcollector, probe, true);
         }
       } else {
         // for each branch name we extract/decode hits from the message parts ...
@@ -596,7 +663,7 @@ class DetImpl : public o2::base::Detector
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
 
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        auto hitsptr = decodeSimDataMessage<std::remove_pointer_t<Hit_t>>(parts, index++);
         if (hitsptr) {
           // ... and fill the tree branch
           auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
@@ -22,6 +22,7 @@
 
 #ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
 #include "MathUtils/Cartesian.h"
+#include <cstdint>
 #endif // !GPUCA_ALIGPUCODE
 
 /**********************************************************************
@@ -47,6 +48,27 @@ struct MatLayerCylSetLayout {
   int* mInterval2LrID;  //[mNRIntervals] mapping from r2 interval to layer ID
 };
 
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+/// header of the raw flat file with the material LUT buffer, see MatLayerCylSet::writeToFlatFile
+struct MatLayerCylSetFlatFileHeader {
+  static constexpr char Magic[8] = {'O', '2', 'M', 'A', 'T', 'L', 'U', 'T'};
+  static constexpr uint32_t Version = 1;
+  static constexpr uint64_t CanonicalAddress = 0x600000000000; ///< preferred mapping address, pointers in the file are relocated to it
+
+  char mMagic[8];          ///< file type identifier
+  uint32_t mVersion;       ///< format version
+  uint32_t mHeaderSize;    ///< size of this header, the flat buffer follows it
+  uint64_t mBufferSize;    ///< size of the flat buffer
+  uint64_t mBufferAddress; ///< address of the flat buffer assumed by the pointers stored in the file
+  uint32_t mLayoutSize;    ///< sizeof(MatLayerCylSetLayout) at writing
+  uint32_t mLayerSize;     ///< sizeof(MatLayerCyl) at writing
+  uint32_t mCellSize;      ///< sizeof(MatCell) at writing
+  int32_t mNLayers;        ///< number of layers
+  uint64_t mChecksum;      ///< FNV-1a hash of the flat buffer
+  uint64_t mReserved;      ///< padding to 64 bytes
+};
+#endif // !GPUCA_ALIGPUCODE
+
 class MatLayerCylSet : public o2::gpu::FlatObject
 {
 
@@ -79,6 +101,11 @@ class MatLayerCylSet : public o2::gpu::FlatObject
   static MatLayerCylSet* loadFromFile(const std::string& inpFName = "matbud.root");
   static MatLayerCylSet* rectifyPtrFromFile(MatLayerCylSet* ptr);
 
+  // raw flat-buffer file which can be memory-mapped and shared between processes
+  bool writeToFlatFile(const std::string& outFName = "matbud.bin") const;
+  static MatLayerCylSet* loadFromFlatFile(const std::string& inpFName = "matbud.bin", bool verifyChecksum = false);
+  static bool isFlatFile(const std::string& inpFName);
+
   void flatten();
 
 #endif // !GPUCA_ALIGPUCODE
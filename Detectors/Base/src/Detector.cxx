@@ -19,6 +19,8 @@
 #include "Field/MagneticField.h"
 #include "TString.h" // for TString
 #include "TGeoManager.h"
+#include "SimConfig/SimConfig.h"
+#include <cstring>
 
 using std::cout;
 using std::endl;
@@ -243,6 +245,45 @@ void* decodeShmCore(FairMQParts& dataparts, int index, bool*& busy)
   return info->object_ptr;
 }
 
+bool useFlatSimData()
+{
+  return o2::conf::SimConfig::Instance().isFlatSimData();
+}
+
+namespace
+{
+// header of a flat message, followed by the elements
+struct FlatMessageHeader {
+  uint64_t elementsize; // size of one element (to check consistency of sender and receiver)
+  uint64_t nelements;   // number of elements
+};
+} // namespace
+
+void attachFlatMessageCore(void const* data, size_t elementsize, size_t nelements, FairMQChannel& channel, FairMQParts& parts)
+{
+  const size_t payload = elementsize * nelements;
+  std::unique_ptr<FairMQMessage> message(channel.NewMessage(sizeof(FlatMessageHeader) + payload));
+  auto header = static_cast<FlatMessageHeader*>(message->GetData());
+  header->elementsize = elementsize;
+  header->nelements = nelements;
+  if (payload > 0) {
+    std::memcpy(header + 1, data, payload);
+  }
+  parts.AddPart(std::move(message));
+}
+
+void* decodeFlatMessageCore(FairMQParts& dataparts, int index, size_t elementsize, void* (*make)(void const* data, size_t nelements))
+{
+  auto rawmessage = std::move(dataparts.At(index));
+  auto header = static_cast<FlatMessageHeader const*>(rawmessage->GetData());
+  if (rawmessage->GetSize() < sizeof(FlatMessageHeader) || header->elementsize != elementsize ||
+      rawmessage->GetSize() != sizeof(FlatMessageHeader) + header->elementsize * header->nelements) {
+    LOG(error) << "Inconsistent flat message of size " << rawmessage->GetSize() << " for element size " << elementsize;
+    return nullptr;
+  }
+  return make(header + 1, header->nelements);
+}
+
 void* decodeTMessageCore(FairMQParts& dataparts, int index)
 {
   class TMessageWrapper : public TMessage
@@ -20,6 +20,12 @@
 #include "GPUCommonLogger.h"
 #include <TFile.h>
 #include "CommonUtils/TreeStreamRedirector.h"
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 //#define _DBG_LOC_ // for local debugging only
 
 #endif // !GPUCA_ALIGPUCODE
@@ -172,6 +178,9 @@ void MatLayerCylSet::writeToFile(const std::string& outFName)
 //________________________________________________________________________________
 MatLayerCylSet* MatLayerCylSet::loadFromFile(const std::string& inpFName)
 {
+  if (isFlatFile(inpFName)) {
+    return loadFromFlatFile(inpFName);
+  }
   TFile inpf(inpFName.data());
   if (inpf.IsZombie()) {
     LOG(error) << "Failed to open input file " << inpFName;
@@ -195,6 +204,136 @@ MatLayerCylSet* MatLayerCylSet::rectifyPtrFromFile(MatLayerCylSet* ptr)
   return ptr;
 }
 
+namespace
+{
+static_assert(sizeof(MatLayerCylSetFlatFileHeader) == 64, "flat file header must be 64 bytes long");
+
+uint64_t flatBufferChecksum(const char* buf, size_t size)
+{
+  // FNV-1a hash
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned char>(buf[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+} // namespace
+
+//________________________________________________________________________________
+bool MatLayerCylSet::writeToFlatFile(const std::string& outFName) const
+{
+  /// store the flat buffer as a raw file which can be memory-mapped by loadFromFlatFile.
+  /// The pointers in the buffer are relocated to the canonical address, so that the file
+  /// mapped at this address is used without modification and its pages are shared by all processes
+  if (!get() || !isConstructed()) {
+    LOG(error) << "Material LUT is not constructed, cannot write it to " << outFName;
+    return false;
+  }
+  MatLayerCylSetFlatFileHeader header{};
+  std::memcpy(header.mMagic, MatLayerCylSetFlatFileHeader::Magic, sizeof(header.mMagic));
+  header.mVersion = MatLayerCylSetFlatFileHeader::Version;
+  header.mHeaderSize = sizeof(MatLayerCylSetFlatFileHeader);
+  header.mBufferSize = mFlatBufferSize;
+  header.mBufferAddress = MatLayerCylSetFlatFileHeader::CanonicalAddress + header.mHeaderSize;
+  header.mLayoutSize = sizeof(MatLayerCylSetLayout);
+  header.mLayerSize = sizeof(MatLayerCyl);
+  header.mCellSize = sizeof(MatCell);
+  header.mNLayers = getNLayers();
+
+  std::vector<char> buffer(mFlatBufferSize);
+  MatLayerCylSet copy;
+  copy.cloneFromObject(*this, buffer.data());
+  copy.setFutureBufferAddress(reinterpret_cast<char*>(header.mBufferAddress));
+  header.mChecksum = flatBufferChecksum(buffer.data(), buffer.size());
+
+  std::ofstream outf(outFName, std::ios::binary | std::ios::trunc);
+  if (!outf) {
+    LOG(error) << "Failed to open output file " << outFName;
+    return false;
+  }
+  outf.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outf.write(buffer.data(), buffer.size());
+  if (!outf) {
+    LOG(error) << "Failed to write material LUT to " << outFName;
+    return false;
+  }
+  return true;
+}
+
+//________________________________________________________________________________
+bool MatLayerCylSet::isFlatFile(const std::string& inpFName)
+{
+  /// check if the file is a raw flat file produced by writeToFlatFile
+  std::ifstream inpf(inpFName, std::ios::binary);
+  char magic[sizeof(MatLayerCylSetFlatFileHeader::Magic)] = {0};
+  return inpf.read(magic, sizeof(magic)) && std::memcmp(magic, MatLayerCylSetFlatFileHeader::Magic, sizeof(magic)) == 0;
+}
+
+//________________________________________________________________________________
+MatLayerCylSet* MatLayerCylSet::loadFromFlatFile(const std::string& inpFName, bool verifyChecksum)
+{
+  /// memory-map the raw flat file produced by writeToFlatFile. If the file can be mapped at its
+  /// canonical address, the mapping is read-only and shared between all processes using the file,
+  /// otherwise a private copy-on-write mapping is created and the pointers are relocated (only the
+  /// pages holding the layout and the layers descriptors are then copied).
+  /// The mapping is never released, the returned object must not outlive the process.
+  int fd = open(inpFName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(error) << "Failed to open input file " << inpFName;
+    return nullptr;
+  }
+  MatLayerCylSetFlatFileHeader header{};
+  struct stat st {
+  };
+  if (fstat(fd, &st) != 0 || pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+      std::memcmp(header.mMagic, MatLayerCylSetFlatFileHeader::Magic, sizeof(header.mMagic)) != 0) {
+    LOG(error) << inpFName << " is not a flat material LUT file";
+    close(fd);
+    return nullptr;
+  }
+  if (header.mVersion != MatLayerCylSetFlatFileHeader::Version || header.mHeaderSize != sizeof(MatLayerCylSetFlatFileHeader) ||
+      header.mLayoutSize != sizeof(MatLayerCylSetLayout) || header.mLayerSize != sizeof(MatLayerCyl) || header.mCellSize != sizeof(MatCell) ||
+      static_cast<uint64_t>(st.st_size) != header.mHeaderSize + header.mBufferSize) {
+    LOG(error) << "Flat material LUT file " << inpFName << " is incompatible with this build or corrupted";
+    close(fd);
+    return nullptr;
+  }
+  size_t mapSize = st.st_size;
+  void* hint = reinterpret_cast<void*>(header.mBufferAddress - header.mHeaderSize);
+  char* base = static_cast<char*>(mmap(hint, mapSize, PROT_READ, MAP_SHARED, fd, 0));
+  bool relocate = false;
+  if (base != MAP_FAILED && base != hint) {
+    munmap(base, mapSize);
+    base = static_cast<char*>(MAP_FAILED);
+  }
+  if (base == MAP_FAILED) {
+    relocate = true;
+    base = static_cast<char*>(mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0));
+  }
+  close(fd);
+  if (base == MAP_FAILED) {
+    LOG(error) << "Failed to memory-map material LUT file " << inpFName;
+    return nullptr;
+  }
+  char* buffer = base + header.mHeaderSize;
+  if (verifyChecksum && flatBufferChecksum(buffer, header.mBufferSize) != header.mChecksum) {
+    LOG(error) << "Checksum mismatch for flat material LUT file " << inpFName;
+    munmap(base, mapSize);
+    return nullptr;
+  }
+  auto* mb = new MatLayerCylSet();
+  mb->mFlatBufferContainer = nullptr;
+  mb->mFlatBufferPtr = buffer;
+  mb->mFlatBufferSize = header.mBufferSize;
+  mb->mConstructionMask = ConstructionState::Constructed;
+  if (relocate) {
+    mb->setActualBufferAddress(buffer);
+  }
+  LOG(info) << "Memory-mapped material LUT from " << inpFName << (relocate ? " with relocation" : " at canonical address");
+  return mb;
+}
+
 //________________________________________________________________________________
 void MatLayerCylSet::optimizePhiSlices(float maxRelDiff)
 {
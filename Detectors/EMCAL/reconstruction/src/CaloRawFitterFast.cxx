@@ -0,0 +1,275 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CaloRawFitterFast.cxx
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "DataFormatsEMCAL/Constants.h"
+
+#include "EMCALReconstruction/CaloRawFitterFast.h"
+
+using namespace o2::emcal;
+
+CaloRawFitterFast::CaloRawFitterFast() : CaloRawFitter("Lookup table ( Fast )", "Fast")
+{
+  mAlgo = FitAlgorithm::Fast;
+}
+
+const std::array<float, CaloRawFitterFast::NTABLEBINS + 1>& CaloRawFitterFast::getResponseTable()
+{
+  static const std::array<float, NTABLEBINS + 1> table = []() {
+    std::array<float, NTABLEBINS + 1> values;
+    for (int ibin = 0; ibin <= NTABLEBINS; ibin++) {
+      double xx = (TABLEMIN + static_cast<double>(ibin) / NSTEPSPERBIN + constants::TAU) / constants::TAU;
+      values[ibin] = xx <= 0 ? 0. : std::pow(xx, constants::ORDER) * std::exp(constants::ORDER * (1 - xx));
+    }
+    return values;
+  }();
+  return table;
+}
+
+float CaloRawFitterFast::response(float dt)
+{
+  static const auto& table = getResponseTable();
+  float x = (dt - TABLEMIN) * NSTEPSPERBIN;
+  if (x <= 0.f || x >= NTABLEBINS) {
+    return 0.f;
+  }
+  int ibin = static_cast<int>(x);
+  float frac = x - ibin;
+  return table[ibin] + frac * (table[ibin + 1] - table[ibin]);
+}
+
+CaloFitResults CaloRawFitterFast::evaluate(const gsl::span<const Bunch> bunchlist)
+{
+  resetBatch();
+  prepareChannel(bunchlist);
+  fitBatch();
+  return makeResults(0);
+}
+
+void CaloRawFitterFast::evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<BatchResult>& results)
+{
+  results.clear();
+  results.resize(channels.size());
+  resetBatch();
+
+  // Pre-fit selection, has to be done sequentially as it uses the sample buffer of the base class
+  for (std::size_t ichannel = 0; ichannel < channels.size(); ichannel++) {
+    try {
+      prepareChannel(channels[ichannel]);
+      mBatchChannel.emplace_back(ichannel);
+    } catch (RawFitterError_t& e) {
+      results[ichannel].mError = e;
+    }
+  }
+
+  fitBatch();
+
+  for (std::size_t ientry = 0; ientry < mBatchChannel.size(); ientry++) {
+    auto& result = results[mBatchChannel[ientry]];
+    try {
+      result.mFitResults = makeResults(ientry);
+      result.mSuccess = true;
+    } catch (RawFitterError_t& e) {
+      result.mError = e;
+    }
+  }
+}
+
+void CaloRawFitterFast::resetBatch()
+{
+  mBatchSamples.clear();
+  mBatchOffset.clear();
+  mBatchNSamples.clear();
+  mBatchFirstTimeBin.clear();
+  mBatchTimebinOffset.clear();
+  mBatchAmpEstimate.clear();
+  mBatchTimeEstimate.clear();
+  mBatchPedestal.clear();
+  mBatchMaxADC.clear();
+  mBatchAmp.clear();
+  mBatchTime.clear();
+  mBatchChi2.clear();
+  mBatchChannel.clear();
+}
+
+void CaloRawFitterFast::prepareChannel(const gsl::span<const Bunch> bunchlist)
+{
+  auto [nsamples, bunchIndex, ampEstimate,
+        maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, mAmpCut);
+
+  int nfit = 0, timebinOffset = 0;
+  float amp = 0, time = 0;
+  if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
+    time = timeEstimate;
+    amp = ampEstimate;
+    timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+    // same selection as the standard fitter: at least 3 samples in the peak region and no overflow
+    if (nsamples > 1 && maxADC < constants::OVERFLOWCUT && last - first + 1 >= 3) {
+      nfit = last - first + 1;
+    }
+  }
+
+  mBatchOffset.emplace_back(mBatchSamples.size());
+  mBatchNSamples.emplace_back(nfit);
+  mBatchFirstTimeBin.emplace_back(first);
+  mBatchTimebinOffset.emplace_back(timebinOffset);
+  mBatchAmpEstimate.emplace_back(amp);
+  mBatchTimeEstimate.emplace_back(time);
+  mBatchPedestal.emplace_back(pedEstimate);
+  mBatchMaxADC.emplace_back(maxADC);
+  for (int isample = 0; isample < nfit; isample++) {
+    mBatchSamples.emplace_back(getReversed(first + isample));
+  }
+}
+
+void CaloRawFitterFast::fitBatch()
+{
+  const std::size_t nentries = mBatchNSamples.size();
+  mBatchAmp.resize(nentries);
+  mBatchTime.resize(nentries);
+  mBatchChi2.resize(nentries);
+  for (std::size_t ientry = 0; ientry < nentries; ientry++) {
+    mBatchAmp[ientry] = mBatchAmpEstimate[ientry];
+    mBatchTime[ientry] = mBatchTimeEstimate[ientry];
+    mBatchChi2[ientry] = -1.f;
+    if (!mBatchNSamples[ientry]) {
+      continue;
+    }
+    float amp = 0, time = 0;
+    float chi2 = fitSamples(mBatchSamples.data() + mBatchOffset[ientry], mBatchNSamples[ientry], mBatchFirstTimeBin[ientry], mBatchTimeEstimate[ientry], amp, time);
+    if (chi2 >= 0) {
+      mBatchAmp[ientry] = amp;
+      mBatchTime[ientry] = time;
+      mBatchChi2[ientry] = chi2;
+    }
+  }
+}
+
+float CaloRawFitterFast::fitSamples(const float* samples, int nsamples, int firstTimeBin, float timeEstimate, float& amp, float& time) const
+{
+  // chi2 for a given peak time, with the amplitude obtained in closed form.
+  // The sums are kept in double precision: for large pulses the chi2 is a small
+  // difference of two large numbers and would be dominated by rounding in float.
+  auto evalChi2 = [samples, nsamples, firstTimeBin](float t0, float& ampl) {
+    double syf = 0, sff = 0, syy = 0;
+    for (int isample = 0; isample < nsamples; isample++) {
+      double f = response(firstTimeBin + isample - t0);
+      double y = samples[isample];
+      syf += y * f;
+      sff += f * f;
+      syy += y * y;
+    }
+    if (sff < FLT_EPSILON) {
+      ampl = 0;
+      return FLT_MAX;
+    }
+    double amplitude = syf / sff;
+    ampl = static_cast<float>(amplitude);
+    return static_cast<float>(syy - syf * amplitude);
+  };
+
+  // coarse scan around the time estimate
+  float step = 2 * SCANRANGE / (NSCANSTEPS - 1);
+  std::array<float, NSCANSTEPS> chi2scan;
+  int best = 0;
+  for (int iscan = 0; iscan < NSCANSTEPS; iscan++) {
+    float ampl;
+    chi2scan[iscan] = evalChi2(timeEstimate - SCANRANGE + iscan * step, ampl);
+    if (chi2scan[iscan] < chi2scan[best]) {
+      best = iscan;
+    }
+  }
+  if (chi2scan[best] == FLT_MAX) {
+    return -1.f;
+  }
+
+  // parabolic refinement around the minimum, the step is reduced at each iteration
+  float t0 = timeEstimate - SCANRANGE + best * step;
+  float chi2center = chi2scan[best];
+  float chi2left = best > 0 ? chi2scan[best - 1] : FLT_MAX;
+  float chi2right = best < NSCANSTEPS - 1 ? chi2scan[best + 1] : FLT_MAX;
+  for (int istep = 0; istep < mNRefinementSteps; istep++) {
+    float ampl;
+    if (chi2left == FLT_MAX) {
+      chi2left = evalChi2(t0 - step, ampl);
+    }
+    if (chi2right == FLT_MAX) {
+      chi2right = evalChi2(t0 + step, ampl);
+    }
+    if (chi2left == FLT_MAX || chi2right == FLT_MAX) {
+      break;
+    }
+    float denom = chi2left - 2 * chi2center + chi2right;
+    if (denom <= FLT_EPSILON) {
+      break;
+    }
+    float shift = 0.5f * step * (chi2left - chi2right) / denom;
+    shift = std::max(-step, std::min(step, shift));
+    t0 += shift;
+    step /= 4;
+    chi2center = evalChi2(t0, ampl);
+    chi2left = FLT_MAX;
+    chi2right = FLT_MAX;
+  }
+
+  float chi2 = evalChi2(t0, amp);
+  if (amp <= 0) {
+    return -1.f;
+  }
+  time = t0;
+  return chi2;
+}
+
+CaloFitResults CaloRawFitterFast::makeResults(int ientry) const
+{
+  float amp = mBatchAmp[ientry];
+  float time = mBatchTime[ientry];
+  float ampEstimate = mBatchAmpEstimate[ientry];
+  float timeEstimate = mBatchTimeEstimate[ientry];
+  float chi2 = 0;
+  int ndf = 0;
+  bool fitDone = mBatchChi2[ientry] >= 0;
+
+  if (fitDone) {
+    chi2 = mBatchChi2[ientry];
+    ndf = mBatchNSamples[ientry] - 2;
+    time += mBatchTimebinOffset[ientry];
+    timeEstimate += mBatchTimebinOffset[ientry];
+
+    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
+    float timeDiff = time - timeEstimate;
+    if ((std::abs(ampAsymm) > 0.1) || (std::abs(timeDiff) > 2)) {
+      amp = ampEstimate;
+      time = timeEstimate;
+      fitDone = false;
+    }
+  }
+  if (amp >= mAmpCut) {
+    if (!fitDone) {
+      std::default_random_engine generator;
+      std::uniform_real_distribution<float> distribution(0.0, 1.0);
+      amp += (0.5 - distribution(generator));
+    }
+    time = time * constants::EMCAL_TIMESAMPLE;
+    time -= mL1Phase;
+
+    return CaloFitResults(mBatchMaxADC[ientry], mBatchPedestal[ientry], mAlgo, amp, time, (int)time, chi2, ndf);
+  }
+  throw RawFitterError_t::FIT_ERROR;
+}
@@ -24,6 +24,7 @@
 #pragma link C++ class o2::emcal::CaloRawFitter + ;
 #pragma link C++ class o2::emcal::CaloRawFitterStandard + ;
 #pragma link C++ class o2::emcal::CaloRawFitterGamma2 + ;
+#pragma link C++ class o2::emcal::CaloRawFitterFast + ;
 
 //#pragma link C++ namespace o2::emcal+;
 #pragma link C++ class o2::emcal::ClusterizerParameters + ;
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_CaloRawFitter.cxx
+/// \brief Benchmark of the EMCAL raw fitters on simulated pulses, comparing speed and precision
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterStandard.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
+
+using namespace o2::emcal;
+
+namespace
+{
+constexpr int NChannels = 2000; // number of channels in one iteration
+
+struct Pulse {
+  float amplitude;
+  float time; // peak time in ns
+  std::vector<Bunch> bunches;
+};
+
+/// generate zero suppressed single bunch pulses with the shape of the EMCAL response function and gaussian noise
+std::vector<Pulse> generatePulses()
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> ampDist(10.f, 800.f);
+  std::uniform_real_distribution<float> timeDist(4.f, 9.f);
+  std::normal_distribution<float> noiseDist(0.f, 1.f);
+
+  std::vector<Pulse> pulses(NChannels);
+  for (auto& pulse : pulses) {
+    pulse.amplitude = ampDist(gen);
+    float t0 = timeDist(gen);
+    pulse.time = t0 * constants::EMCAL_TIMESAMPLE;
+    Bunch bunch(constants::EMCAL_MAXTIMEBINS, constants::EMCAL_MAXTIMEBINS - 1);
+    // ADC values are stored in reversed order in time
+    for (int itime = constants::EMCAL_MAXTIMEBINS - 1; itime >= 0; itime--) {
+      double signal = pulse.amplitude * CaloRawFitterFast::response(itime - t0) + noiseDist(gen);
+      bunch.addADC(static_cast<uint16_t>(std::max(0., std::round(signal))));
+    }
+    pulse.bunches.push_back(bunch);
+  }
+  return pulses;
+}
+
+std::unique_ptr<CaloRawFitter> createFitter(int type)
+{
+  switch (type) {
+    case 0:
+      return std::make_unique<CaloRawFitterStandard>();
+    case 1:
+      return std::make_unique<CaloRawFitterGamma2>();
+    default:
+      return std::make_unique<CaloRawFitterFast>();
+  }
+}
+} // namespace
+
+static void BM_CaloRawFitter(benchmark::State& state)
+{
+  const int fitterType = state.range(0);
+  const bool batched = fitterType == 3;
+  const auto pulses = generatePulses();
+  auto fitter = createFitter(fitterType);
+  fitter->setIsZeroSuppressed(true);
+  state.SetLabel(std::string(fitter->getAlgoName()) + (batched ? " batched" : ""));
+
+  std::vector<gsl::span<const Bunch>> channels;
+  for (const auto& pulse : pulses) {
+    channels.emplace_back(pulse.bunches);
+  }
+  std::vector<CaloRawFitterFast::BatchResult> batchResults;
+
+  std::vector<CaloFitResults> results(NChannels);
+  std::vector<bool> success(NChannels);
+  for (auto _ : state) {
+    if (batched) {
+      static_cast<CaloRawFitterFast*>(fitter.get())->evaluateBatch(channels, batchResults);
+      for (int ichannel = 0; ichannel < NChannels; ichannel++) {
+        results[ichannel] = batchResults[ichannel].mFitResults;
+        success[ichannel] = batchResults[ichannel].mSuccess;
+      }
+    } else {
+      for (int ichannel = 0; ichannel < NChannels; ichannel++) {
+        try {
+          results[ichannel] = fitter->evaluate(channels[ichannel]);
+          success[ichannel] = true;
+        } catch (CaloRawFitter::RawFitterError_t& e) {
+          success[ichannel] = false;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(results);
+  }
+
+  // precision with respect to the simulated pulses
+  double sumDiffTime = 0, sumDiffAmp = 0;
+  int nsuccess = 0;
+  for (int ichannel = 0; ichannel < NChannels; ichannel++) {
+    if (!success[ichannel]) {
+      continue;
+    }
+    nsuccess++;
+    sumDiffTime += std::abs(results[ichannel].getTime() - pulses[ichannel].time);
+    sumDiffAmp += std::abs(results[ichannel].getAmp() - pulses[ichannel].amplitude) / pulses[ichannel].amplitude;
+  }
+  state.counters["success"] = static_cast<double>(nsuccess) / NChannels;
+  state.counters["dtime_ns"] = nsuccess ? sumDiffTime / nsuccess : 0.;
+  state.counters["damp_rel"] = nsuccess ? sumDiffAmp / nsuccess : 0.;
+  state.counters["channels"] = benchmark::Counter(NChannels, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// arguments: fitter type (0 = standard, 1 = gamma2, 2 = fast, 3 = fast batched)
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int type = 0; type < 4; ++type) {
+    bench->Args({type});
+  }
+}
+
+BENCHMARK(BM_CaloRawFitter)->Apply(CustomArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterStandard.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \brief Comparison of the fast raw fitter with the standard one
+///
+/// Zero suppressed single bunch pulses with the EMCAL response function and
+/// gaussian noise are fitted by both fitters, one channel at a time and in a
+/// batch for the fast fitter. Amplitude and time must agree within 1% and
+/// 0.05 time bins, as documented for CaloRawFitterFast.
+BOOST_AUTO_TEST_CASE(CaloRawFitterFast_test)
+{
+  constexpr int nPulses = 500;
+  constexpr double ampTolerance = 0.01;
+  constexpr double timeTolerance = 0.05 * constants::EMCAL_TIMESAMPLE;
+
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<float> ampDist(50.f, 800.f);
+  std::uniform_real_distribution<float> timeDist(4.f, 9.f);
+  std::normal_distribution<float> noiseDist(0.f, 1.f);
+
+  std::vector<std::vector<Bunch>> pulses(nPulses);
+  for (auto& pulse : pulses) {
+    float amplitude = ampDist(gen);
+    float t0 = timeDist(gen);
+    Bunch bunch(constants::EMCAL_MAXTIMEBINS, constants::EMCAL_MAXTIMEBINS - 1);
+    // ADC values are stored in reversed order in time
+    for (int itime = constants::EMCAL_MAXTIMEBINS - 1; itime >= 0; itime--) {
+      double signal = amplitude * CaloRawFitterFast::response(itime - t0) + noiseDist(gen);
+      bunch.addADC(static_cast<uint16_t>(std::max(0., std::round(signal))));
+    }
+    pulse.push_back(bunch);
+  }
+
+  CaloRawFitterStandard standard;
+  CaloRawFitterFast fast;
+  standard.setIsZeroSuppressed(true);
+  fast.setIsZeroSuppressed(true);
+
+  std::vector<gsl::span<const Bunch>> channels(pulses.begin(), pulses.end());
+  std::vector<CaloRawFitterFast::BatchResult> batchResults;
+  fast.evaluateBatch(channels, batchResults);
+  BOOST_REQUIRE_EQUAL(batchResults.size(), nPulses);
+
+  int nCompared = 0;
+  for (int ipulse = 0; ipulse < nPulses; ipulse++) {
+    CaloFitResults reference;
+    try {
+      reference = standard.evaluate(channels[ipulse]);
+    } catch (CaloRawFitter::RawFitterError_t& e) {
+      continue;
+    }
+    nCompared++;
+
+    CaloFitResults result;
+    BOOST_REQUIRE_NO_THROW(result = fast.evaluate(channels[ipulse]));
+    BOOST_CHECK_SMALL(result.getAmp() / reference.getAmp() - 1., ampTolerance);
+    BOOST_CHECK_SMALL(result.getTime() - reference.getTime(), timeTolerance);
+
+    const auto& batchResult = batchResults[ipulse];
+    BOOST_REQUIRE(batchResult.mSuccess);
+    BOOST_CHECK_CLOSE(batchResult.mFitResults.getAmp(), result.getAmp(), 1e-3);
+    BOOST_CHECK_CLOSE(batchResult.mFitResults.getTime(), result.getTime(), 1e-3);
+  }
+  // the simulated pulses are well within the fit range, hence fitted by the standard fitter
+  BOOST_CHECK_GT(nCompared, 0.95 * nPulses);
+}
+
+} // namespace emcal
+
+} // namespace o2
@@ -9,7 +9,9 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <utility>
 #include <vector>
+#include <gsl/span>
 
 #include "DataFormatsEMCAL/Cell.h"
 #include "DataFormatsEMCAL/TriggerRecord.h"
@@ -17,6 +19,7 @@
 #include "Framework/Task.h"
 #include "EMCALBase/Geometry.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
 #include "EMCALReconstruction/AltroHelper.h"
 
 namespace o2
@@ -77,11 +80,15 @@ class CellConverterSpec : public framework::Task
   std::vector<AltroBunch> findBunches(const std::vector<const o2::emcal::Digit*>& channelDigits);
 
  private:
-  bool mPropagateMC = false;                             ///< Switch whether to process MC true labels
-  o2::emcal::Geometry* mGeometry = nullptr;              ///!<! Geometry pointer
-  std::unique_ptr<o2::emcal::CaloRawFitter> mRawFitter;  ///!<! Raw fitter
-  std::vector<o2::emcal::Cell> mOutputCells;             ///< Container with output cells
-  std::vector<o2::emcal::TriggerRecord> mOutputTriggers; ///< Container with output trigger records
+  bool mPropagateMC = false;                                            ///< Switch whether to process MC true labels
+  o2::emcal::Geometry* mGeometry = nullptr;                             ///!<! Geometry pointer
+  std::unique_ptr<o2::emcal::CaloRawFitter> mRawFitter;                 ///!<! Raw fitter
+  o2::emcal::CaloRawFitterFast* mFastFitter = nullptr;                  ///!<! Raw fitter as fast fitter (if selected), fitting all channels of an event in one batch
+  std::vector<std::pair<int, o2::emcal::ChannelType_t>> mEventChannels; ///!<! Tower and channel type of the channels of the current event
+  std::vector<gsl::span<const o2::emcal::Bunch>> mEventBunches;         ///!<! Bunches of the channels of the current event
+  std::vector<o2::emcal::CaloRawFitterFast::BatchResult> mBatchResults; ///!<! Fit results of the batch evaluation
+  std::vector<o2::emcal::Cell> mOutputCells;                            ///< Container with output cells
+  std::vector<o2::emcal::TriggerRecord> mOutputTriggers;                ///< Container with output trigger records
 };
 
 /// \brief Creating DataProcessorSpec for the EMCAL Cell Converter Spec
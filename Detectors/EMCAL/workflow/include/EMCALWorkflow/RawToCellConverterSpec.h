@@ -11,6 +11,7 @@
 
 #include <chrono>
 #include <vector>
+#include <gsl/span>
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
@@ -20,6 +21,8 @@
 #include "EMCALBase/Geometry.h"
 #include "EMCALBase/Mapper.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
+#include "EMCALReconstruction/Channel.h"
 
 namespace o2
 {
@@ -103,6 +106,15 @@ class RawToCellConverterSpec : public framework::Task
     int mHWAddressLG;          ///< HW address of LG (for monitoring)
     int mHWAddressHG;          ///< HW address of HG (for monitoring)
   };
+
+  /// \struct ChannelToFit
+  /// \brief Valid channel of a DDL, kept until all channels of the DDL are fitted
+  struct ChannelToFit {
+    const Channel* mChannel; ///< Decoded channel
+    int mCellID;             ///< Cell ID of the channel
+    ChannelType_t mChanType; ///< Channel type (high/low gain)
+  };
+
   bool isLostTimeframe(framework::ProcessingContext& ctx) const;
 
   /// \brief Send data to output channels
@@ -128,6 +140,10 @@ class RawToCellConverterSpec : public framework::Task
   Geometry* mGeometry = nullptr;                                     ///!<! Geometry pointer
   std::unique_ptr<MappingHandler> mMapper = nullptr;                 ///!<! Mapper
   std::unique_ptr<CaloRawFitter> mRawFitter;                         ///!<! Raw fitter
+  CaloRawFitterFast* mFastFitter = nullptr;                          ///!<! Raw fitter as fast fitter (if selected), fitting all channels of a DDL in one batch
+  std::vector<ChannelToFit> mChannelsToFit;                          ///!<! Valid channels of the current DDL
+  std::vector<gsl::span<const Bunch>> mChannelBunches;               ///!<! Bunches of the channels of the current DDL (fast fitter)
+  std::vector<CaloRawFitterFast::BatchResult> mBatchResults;         ///!<! Fit results of the batch evaluation
   std::vector<Cell> mOutputCells;                                    ///< Container with output cells
   std::vector<TriggerRecord> mOutputTriggerRecords;                  ///< Container with output cells
   std::vector<ErrorTypeFEE> mOutputDecoderErrors;                    ///< Container with decoder errors
@@ -20,6 +20,7 @@
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include "EMCALReconstruction/CaloRawFitterStandard.h"
 #include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
 
 using namespace o2::emcal::reco_workflow;
 
@@ -41,6 +42,11 @@ void CellConverterSpec::init(framework::InitContext& ctx)
   } else if (fitmethod == "gamma2") {
     LOG(info) << "Using gamma2 raw fitter";
     mRawFitter = std::unique_ptr<o2::emcal::CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+  } else if (fitmethod == "fast") {
+    LOG(info) << "Using fast (lookup table) raw fitter";
+    auto fastfitter = new o2::emcal::CaloRawFitterFast;
+    mFastFitter = fastfitter;
+    mRawFitter = std::unique_ptr<o2::emcal::CaloRawFitter>(fastfitter);
   }
   mRawFitter->setAmpCut(0.);
   mRawFitter->setL1Phase(0.);
@@ -64,32 +70,53 @@ void CellConverterSpec::run(framework::ProcessingContext& ctx)
     }
     gsl::span<const o2::emcal::Digit> digits(digitsAll.data() + trg.getFirstEntry(), trg.getNumberOfObjects());
 
-    for (const auto& srucont : digitsToBunches(digits)) {
+    // collect the channels of the event first, so that the fast raw fitter can fit them in one batch
+    auto sruContainers = digitsToBunches(digits);
+    mEventChannels.clear();
+    mEventBunches.clear();
+    for (const auto& srucont : sruContainers) {
 
       if (srucont.mSRUid == 21 || srucont.mSRUid == 22 || srucont.mSRUid == 36 || srucont.mSRUid == 39) {
         continue;
       }
 
       for (const auto& [tower, channelData] : srucont.mChannelsData) {
+        mEventChannels.emplace_back(tower, channelData.mChanType);
+        mEventBunches.emplace_back(channelData.mChannelsBunches);
+      }
+    }
+    if (mFastFitter) {
+      mFastFitter->evaluateBatch(mEventBunches, mBatchResults);
+    }
 
-        // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
-        CaloFitResults fitResults;
-        try {
-          fitResults = mRawFitter->evaluate(channelData.mChannelsBunches);
+    for (std::size_t ichannel = 0; ichannel < mEventChannels.size(); ichannel++) {
+      const auto& [tower, chantype] = mEventChannels[ichannel];
 
-          if (fitResults.getAmp() < 0) {
-            fitResults.setAmp(0.);
-          }
-          if (fitResults.getTime() < 0) {
-            fitResults.setTime(0.);
+      // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
+      CaloFitResults fitResults;
+      try {
+        if (mFastFitter) {
+          const auto& batchresult = mBatchResults[ichannel];
+          if (!batchresult.mSuccess) {
+            throw batchresult.mError;
           }
-        } catch (CaloRawFitter::RawFitterError_t& fiterror) {
-          LOG(error) << "Failure in raw fitting: " << CaloRawFitter::createErrorMessage(fiterror);
+          fitResults = batchresult.mFitResults;
+        } else {
+          fitResults = mRawFitter->evaluate(mEventBunches[ichannel]);
         }
 
-        mOutputCells.emplace_back(tower, fitResults.getAmp() * CONVADCGEV, fitResults.getTime(), channelData.mChanType);
-        ncellsTrigger++;
+        if (fitResults.getAmp() < 0) {
+          fitResults.setAmp(0.);
+        }
+        if (fitResults.getTime() < 0) {
+          fitResults.setTime(0.);
+        }
+      } catch (CaloRawFitter::RawFitterError_t& fiterror) {
+        LOG(error) << "Failure in raw fitting: " << CaloRawFitter::createErrorMessage(fiterror);
       }
+
+      mOutputCells.emplace_back(tower, fitResults.getAmp() * CONVADCGEV, fitResults.getTime(), chantype);
+      ncellsTrigger++;
     }
     mOutputTriggers.emplace_back(trg.getBCData(), trg.getTriggerBits(), currentstart, ncellsTrigger);
     currentstart = mOutputCells.size();
@@ -251,5 +278,5 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getCellConverterSpec(
                                           outputs,
                                           o2::framework::adaptFromTask<o2::emcal::reco_workflow::CellConverterSpec>(propagateMC),
                                           o2::framework::Options{
-                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard or gamma2)"}}}};
+                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard, gamma2 or fast)"}}}};
 }
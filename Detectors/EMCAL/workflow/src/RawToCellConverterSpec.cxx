@@ -32,6 +32,7 @@
 #include "EMCALReconstruction/Bunch.h"
 #include "EMCALReconstruction/CaloRawFitterStandard.h"
 #include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterFast.h"
 #include "EMCALReconstruction/AltroDecoder.h"
 #include "EMCALReconstruction/RawDecodingError.h"
 #include "EMCALWorkflow/RawToCellConverterSpec.h"
@@ -75,6 +76,11 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
   } else if (fitmethod == "gamma2") {
     LOG(info) << "Using gamma2 raw fitter";
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+  } else if (fitmethod == "fast") {
+    LOG(info) << "Using fast (lookup table) raw fitter";
+    auto fastfitter = new o2::emcal::CaloRawFitterFast;
+    mFastFitter = fastfitter;
+    mRawFitter = std::unique_ptr<CaloRawFitter>(fastfitter);
   } else {
     LOG(fatal) << "Unknown fit method" << fitmethod;
   }
@@ -274,6 +280,7 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
 
       // Loop over all the channels
       int nBunchesNotOK = 0;
+      mChannelsToFit.clear();
       for (auto& chan : decoder.getChannels()) {
 
         int iRow, iCol;
@@ -362,10 +369,34 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
           continue;
         }
 
+        mChannelsToFit.push_back({&chan, CellID, chantype});
+      }
+
+      // Fit all valid channels of the DDL - in one batch in case of the fast raw fitter
+      if (mFastFitter) {
+        mChannelBunches.clear();
+        for (const auto& channelinfo : mChannelsToFit) {
+          mChannelBunches.emplace_back(channelinfo.mChannel->getBunches());
+        }
+        mFastFitter->evaluateBatch(mChannelBunches, mBatchResults);
+      }
+      for (std::size_t ichannel = 0; ichannel < mChannelsToFit.size(); ichannel++) {
+        const auto& chan = *mChannelsToFit[ichannel].mChannel;
+        auto CellID = mChannelsToFit[ichannel].mCellID;
+        auto chantype = mChannelsToFit[ichannel].mChanType;
+
         // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
         CaloFitResults fitResults;
         try {
-          fitResults = mRawFitter->evaluate(chan.getBunches());
+          if (mFastFitter) {
+            const auto& batchresult = mBatchResults[ichannel];
+            if (!batchresult.mSuccess) {
+              throw batchresult.mError;
+            }
+            fitResults = batchresult.mFitResults;
+          } else {
+            fitResults = mRawFitter->evaluate(chan.getBunches());
+          }
           // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
           if (fitResults.getAmp() < 0) {
             fitResults.setAmp(0.);
@@ -581,7 +612,7 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getRawToCellConverter
                                           outputs,
                                           o2::framework::adaptFromTask<o2::emcal::reco_workflow::RawToCellConverterSpec>(subspecification, !disableDecodingErrors),
                                           o2::framework::Options{
-                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard or gamma2)"}},
+                                            {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard, gamma2 or fast)"}},
                                             {"maxmessage", o2::framework::VariantType::Int, 100, {"Max. amout of error messages to be displayed"}},
                                             {"printtrailer", o2::framework::VariantType::Bool, false, {"Print RCU trailer (for debugging)"}},
                                             {"no-mergeHGLG", o2::framework::VariantType::Bool, false, {"Do not merge HG and LG channels for same tower"}},
@@ -21,7 +21,7 @@
 #include "ITSMFTBase/SegmentationAlpide.h"
 #include "ITSMFTSimulation/PreDigit.h"
 #include "DataFormatsITSMFT/NoiseMap.h"
-#include <map>
+#include <algorithm>
 #include <vector>
 
 namespace o2
@@ -32,6 +32,10 @@ class DigiParams;
 
 /// @class ChipDigitsContainer
 /// @brief Container for similated points connected to a given chip
+///
+/// The predigits of every readout frame are stored in a vector indexed by an open addressing
+/// hash table on the pixel (column, row), the frames are sorted in the output order (column, row)
+/// only when they are extracted by extractPreDigits.
 
 class ChipDigitsContainer
 {
@@ -42,17 +46,24 @@ class ChipDigitsContainer
   /// Destructor
   ~ChipDigitsContainer() = default;
 
-  std::map<ULong64_t, o2::itsmft::PreDigit>& getPreDigits() { return mDigits; }
-  bool isEmpty() const { return mDigits.empty(); }
+  bool isEmpty() const { return mNPreDigits == 0; }
+  size_t getNPreDigits() const { return mNPreDigits; }
   void setNoiseMap(const o2::itsmft::NoiseMap* mp) { mNoiseMap = mp; }
   void setDeadChanMap(const o2::itsmft::NoiseMap* mp) { mDeadChanMap = mp; }
   void setChipIndex(UShort_t ind) { mChipIndex = ind; }
   UShort_t getChipIndex() const { return mChipIndex; }
 
+  /// find the predigit for the global key, the pointer is valid until the next addDigit call
   o2::itsmft::PreDigit* findDigit(ULong64_t key);
+  /// add new predigit, the existing predigit for the same key is preserved
   void addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col, int charge, o2::MCCompLabel lbl);
   void addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmft::DigiParams* params, int maxRows = o2::itsmft::SegmentationAlpide::NRows, int maxCols = o2::itsmft::SegmentationAlpide::NCols);
 
+  /// call func(PreDigit&) for the predigits of all frames up to roframe, in the increasing order of their
+  /// ordering key (frame, column, row), then remove them from the container
+  template <typename F>
+  void extractPreDigits(UInt_t roframe, F&& func);
+
   /// Get global ordering key made of readout frame, column and row
   static ULong64_t getOrderingKey(UInt_t roframe, UShort_t row, UShort_t col)
   {
@@ -65,32 +76,151 @@ class ChipDigitsContainer
     return static_cast<UInt_t>(key >> (8 * sizeof(UInt_t)));
   }
 
+  /// Get pixel (column, row) part of the ordering key
+  static UInt_t key2Pixel(ULong64_t key)
+  {
+    return static_cast<UInt_t>(key);
+  }
+
   bool isDisabled() const { return mDisabled; }
   void disable(bool v) { mDisabled = v; }
 
  protected:
-  UShort_t mChipIndex = 0;                           ///< chip index
+  /// predigits of a single readout frame with open addressing (linear probing) hash table on the pixel key
+  struct ROFrameDigits {
+    static constexpr UInt_t EmptySlot = 0xffffffff; ///< pixel key of free slot (not a valid column, row)
+    static constexpr int MinHashBits = 6;           ///< log2 of minimal hash table size
+
+    UInt_t roFrame = 0;                       ///< readout frame
+    int hashBits = 0;                         ///< log2 of the hash table size
+    std::vector<UInt_t> pixels;               ///< pixel key of every slot of the hash table
+    std::vector<int> slots;                   ///< index of the predigit of every slot of the hash table
+    std::vector<o2::itsmft::PreDigit> digits; ///< predigits in the order of their creation
+
+    UInt_t getSlot(UInt_t pixel) const { return static_cast<UInt_t>((pixel * 0x9E3779B97F4A7C15ULL) >> (64 - hashBits)); }
+    UInt_t getMask() const { return (1u << hashBits) - 1; }
+    o2::itsmft::PreDigit* find(UInt_t pixel);
+    bool add(UInt_t pixel, const o2::itsmft::PreDigit& digit);
+    void rehash(int nBits);
+    void clear();
+  };
+
+  ROFrameDigits* findFrame(UInt_t roframe);
+  ROFrameDigits& getFrame(UInt_t roframe);
+  void releaseFrame(int ind);
+
+  UShort_t mChipIndex = 0;               ///< chip index
   bool mDisabled = false;
   const o2::itsmft::NoiseMap* mNoiseMap = nullptr;
   const o2::itsmft::NoiseMap* mDeadChanMap = nullptr;
-  std::map<ULong64_t, o2::itsmft::PreDigit> mDigits; ///< Map of fired pixels, possibly in multiple frames
+  std::vector<ROFrameDigits> mFrames;    //! frames with fired pixels
+  std::vector<ROFrameDigits> mFramePool; //! released frames kept to reuse their memory
+  std::vector<ULong64_t> mSortBuffer;    //! (pixel key, predigit index) pairs for sorting of the frame
+  int mLastFrame = -1;                   //! index of the last accessed frame
+  size_t mNPreDigits = 0;                //! total number of predigits
 
-  ClassDefNV(ChipDigitsContainer, 1);
+  ClassDefNV(ChipDigitsContainer, 2);
 };
 
+//_______________________________________________________________________
+inline o2::itsmft::PreDigit* ChipDigitsContainer::ROFrameDigits::find(UInt_t pixel)
+{
+  if (digits.empty()) {
+    return nullptr;
+  }
+  const auto mask = getMask();
+  for (auto slot = getSlot(pixel);; slot = (slot + 1) & mask) {
+    if (pixels[slot] == pixel) {
+      return &digits[slots[slot]];
+    }
+    if (pixels[slot] == EmptySlot) {
+      return nullptr;
+    }
+  }
+}
+
+//_______________________________________________________________________
+inline bool ChipDigitsContainer::ROFrameDigits::add(UInt_t pixel, const o2::itsmft::PreDigit& digit)
+{
+  // keep the load factor below 1/2
+  if (2 * (digits.size() + 1) > pixels.size()) {
+    rehash(std::max(MinHashBits, hashBits + 1));
+  }
+  const auto mask = getMask();
+  auto slot = getSlot(pixel);
+  for (; pixels[slot] != EmptySlot; slot = (slot + 1) & mask) {
+    if (pixels[slot] == pixel) {
+      return false;
+    }
+  }
+  pixels[slot] = pixel;
+  slots[slot] = digits.size();
+  digits.push_back(digit);
+  return true;
+}
+
+//_______________________________________________________________________
+inline ChipDigitsContainer::ROFrameDigits* ChipDigitsContainer::findFrame(UInt_t roframe)
+{
+  // the hits of an event fill only few consecutive frames, start from the last used one
+  if (mLastFrame >= 0 && mFrames[mLastFrame].roFrame == roframe) {
+    return &mFrames[mLastFrame];
+  }
+  for (int i = mFrames.size(); i--;) {
+    if (mFrames[i].roFrame == roframe) {
+      mLastFrame = i;
+      return &mFrames[i];
+    }
+  }
+  return nullptr;
+}
+
 //_______________________________________________________________________
 inline o2::itsmft::PreDigit* ChipDigitsContainer::findDigit(ULong64_t key)
 {
   // finds the digit corresponding to global key
-  auto digitentry = mDigits.find(key);
-  return digitentry != mDigits.end() ? &(digitentry->second) : nullptr;
+  auto* frame = findFrame(key2ROFrame(key));
+  return frame ? frame->find(key2Pixel(key)) : nullptr;
 }
 
 //_______________________________________________________________________
 inline void ChipDigitsContainer::addDigit(ULong64_t key, UInt_t roframe, UShort_t row, UShort_t col,
                                           int charge, o2::MCCompLabel lbl)
 {
-  mDigits.emplace(std::make_pair(key, o2::itsmft::PreDigit(roframe, row, col, charge, lbl)));
+  if (getFrame(roframe).add(key2Pixel(key), o2::itsmft::PreDigit(roframe, row, col, charge, lbl))) {
+    mNPreDigits++;
+  }
+}
+
+//_______________________________________________________________________
+template <typename F>
+void ChipDigitsContainer::extractPreDigits(UInt_t roframe, F&& func)
+{
+  while (mNPreDigits) {
+    // find the lowest frame not above the requested one
+    int sel = -1;
+    for (int i = 0; i < int(mFrames.size()); i++) {
+      if (mFrames[i].roFrame <= roframe && (sel < 0 || mFrames[i].roFrame < mFrames[sel].roFrame)) {
+        sel = i;
+      }
+    }
+    if (sel < 0) {
+      break;
+    }
+    // sort the predigits in the (column, row) order
+    auto& frame = mFrames[sel];
+    mSortBuffer.clear();
+    for (size_t id = 0; id < frame.digits.size(); id++) {
+      const auto& dig = frame.digits[id];
+      mSortBuffer.push_back((static_cast<ULong64_t>(key2Pixel(getOrderingKey(0, dig.row, dig.col))) << 32) + id);
+    }
+    std::sort(mSortBuffer.begin(), mSortBuffer.end());
+    for (auto entry : mSortBuffer) {
+      func(frame.digits[static_cast<UInt_t>(entry)]);
+    }
+    mNPreDigits -= frame.digits.size();
+    releaseFrame(sel);
+  }
 }
 } // namespace itsmft
 } // namespace o2
@@ -53,3 +53,63 @@ void ChipDigitsContainer::addNoise(UInt_t rofMin, UInt_t rofMax, const o2::itsmf
     }
   }
 }
+
+//______________________________________________________________________
+ChipDigitsContainer::ROFrameDigits& ChipDigitsContainer::getFrame(UInt_t roframe)
+{
+  // get the frame, creating it if needed
+  auto* frame = findFrame(roframe);
+  if (frame) {
+    return *frame;
+  }
+  if (mFramePool.empty()) {
+    mFrames.emplace_back();
+  } else {
+    mFrames.emplace_back(std::move(mFramePool.back()));
+    mFramePool.pop_back();
+  }
+  mLastFrame = mFrames.size() - 1;
+  mFrames.back().roFrame = roframe;
+  return mFrames.back();
+}
+
+//______________________________________________________________________
+void ChipDigitsContainer::releaseFrame(int ind)
+{
+  // clear the frame and move it to the pool for later reuse of its memory
+  mFrames[ind].clear();
+  if (ind != int(mFrames.size()) - 1) {
+    std::swap(mFrames[ind], mFrames.back());
+  }
+  mFramePool.emplace_back(std::move(mFrames.back()));
+  mFrames.pop_back();
+  mLastFrame = -1;
+}
+
+//______________________________________________________________________
+void ChipDigitsContainer::ROFrameDigits::rehash(int nBits)
+{
+  hashBits = nBits;
+  pixels.assign(1u << hashBits, EmptySlot);
+  slots.resize(1u << hashBits);
+  const auto mask = getMask();
+  for (size_t id = 0; id < digits.size(); id++) {
+    const auto pixel = key2Pixel(getOrderingKey(0, digits[id].row, digits[id].col));
+    auto slot = getSlot(pixel);
+    while (pixels[slot] != EmptySlot) {
+      slot = (slot + 1) & mask;
+    }
+    pixels[slot] = pixel;
+    slots[slot] = id;
+  }
+}
+
+//______________________________________________________________________
+void ChipDigitsContainer::ROFrameDigits::clear()
+{
+  // clear the content keeping the allocated memory
+  if (!digits.empty()) {
+    std::fill(pixels.begin(), pixels.end(), EmptySlot);
+    digits.clear();
+  }
+}
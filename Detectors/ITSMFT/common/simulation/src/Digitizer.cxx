@@ -185,18 +185,8 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
         continue;
       }
       chip.addNoise(mROFrameMin, mROFrameMin, &mParams);
-      auto& buffer = chip.getPreDigits();
-      if (buffer.empty()) {
-        continue;
-      }
-      auto itBeg = buffer.begin();
-      auto iter = itBeg;
-      ULong64_t maxKey = chip.getOrderingKey(mROFrameMin + 1, 0, 0) - 1; // fetch digits with key below that
-      for (; iter != buffer.end(); ++iter) {
-        if (iter->first > maxKey) {
-          break; // is the digit ROFrame from the key > the max requested frame
-        }
-        auto& preDig = iter->second; // preDigit
+      // fetch digits of the frames up to the current one, in the output order
+      chip.extractPreDigits(mROFrameMin, [&](PreDigit& preDig) {
         if (preDig.charge >= mParams.getChargeThreshold()) {
           int digID = mDigits->size();
           mDigits->emplace_back(chip.getChipIndex(), preDig.row, preDig.col, preDig.charge);
@@ -207,8 +197,7 @@ void Digitizer::fillOutputContainer(uint32_t frameLast)
             mMCLabels->addElement(digID, nextRef.label);
           }
         }
-      }
-      buffer.erase(itBeg, iter);
+      });
     }
     // finalize ROF record
     rcROF.setNEntries(mDigits->size() - rcROF.getFirstEntry()); // number of digits
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_ChipDigitsContainer.cxx
+/// \brief Benchmark of the predigits accumulation in a chip, compared with the std::map based storage
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <vector>
+#include <TRandom.h>
+
+#include "ITSMFTSimulation/ChipDigitsContainer.h"
+
+using namespace o2::itsmft;
+using Segmentation = o2::itsmft::SegmentationAlpide;
+
+namespace
+{
+struct PixelResponse {
+  UInt_t roFrame;
+  UShort_t row;
+  UShort_t col;
+  int charge;
+  o2::MCCompLabel label;
+};
+
+/// pixel responses of hits in an inner barrel chip at Pb-Pb pile-up: clusters of few pixels, spread over 1-2 readout frames
+/// and overlapping with the clusters of the same track in the next frames
+std::vector<PixelResponse> makeResponses(int nHitsPerROF, int nROFs)
+{
+  std::vector<PixelResponse> responses;
+  gRandom->SetSeed(1);
+  for (int rof = 0; rof < nROFs; rof++) {
+    for (int ih = 0; ih < nHitsPerROF; ih++) {
+      o2::MCCompLabel lbl(ih, rof, 0);
+      int row0 = gRandom->Integer(Segmentation::NRows - 3), col0 = gRandom->Integer(Segmentation::NCols - 3);
+      int nFrames = gRandom->Rndm() < 0.3 ? 2 : 1;
+      for (int ifr = 0; ifr < nFrames; ifr++) {
+        for (int dr = 0; dr < 3; dr++) {
+          for (int dc = 0; dc < 3; dc++) {
+            if (gRandom->Rndm() < 0.3) {
+              continue;
+            }
+            responses.push_back({UInt_t(rof + ifr), UShort_t(row0 + dr), UShort_t(col0 + dc), 50 + int(gRandom->Integer(200)), lbl});
+          }
+        }
+      }
+    }
+  }
+  return responses;
+}
+
+const std::vector<PixelResponse>& getResponses(int nHitsPerROF)
+{
+  static std::map<int, std::vector<PixelResponse>> cache;
+  auto& resp = cache[nHitsPerROF];
+  if (resp.empty()) {
+    resp = makeResponses(nHitsPerROF, 32);
+  }
+  return resp;
+}
+} // namespace
+
+static void BM_PreDigitsMap(benchmark::State& state)
+{
+  const auto& responses = getResponses(state.range(0));
+  std::map<ULong64_t, PreDigit> digits;
+  for (auto _ : state) {
+    size_t nOut = 0;
+    UInt_t rofDone = 0;
+    for (const auto& resp : responses) {
+      if (resp.roFrame > rofDone + 1) { // flush frames which cannot receive new contributions
+        ULong64_t maxKey = ChipDigitsContainer::getOrderingKey(rofDone + 1, 0, 0) - 1;
+        auto iter = digits.begin();
+        for (; iter != digits.end() && iter->first <= maxKey; ++iter) {
+          nOut += iter->second.charge;
+        }
+        digits.erase(digits.begin(), iter);
+        rofDone++;
+      }
+      auto key = ChipDigitsContainer::getOrderingKey(resp.roFrame, resp.row, resp.col);
+      auto it = digits.find(key);
+      if (it == digits.end()) {
+        digits.emplace(key, PreDigit(resp.roFrame, resp.row, resp.col, resp.charge, resp.label));
+      } else {
+        it->second.charge += resp.charge;
+      }
+    }
+    for (auto& dig : digits) {
+      nOut += dig.second.charge;
+    }
+    digits.clear();
+    benchmark::DoNotOptimize(nOut);
+  }
+  state.SetItemsProcessed(state.iterations() * responses.size());
+}
+
+static void BM_PreDigitsChipContainer(benchmark::State& state)
+{
+  const auto& responses = getResponses(state.range(0));
+  ChipDigitsContainer chip;
+  for (auto _ : state) {
+    size_t nOut = 0;
+    UInt_t rofDone = 0;
+    for (const auto& resp : responses) {
+      if (resp.roFrame > rofDone + 1) { // flush frames which cannot receive new contributions
+        chip.extractPreDigits(rofDone, [&nOut](PreDigit& dig) { nOut += dig.charge; });
+        rofDone++;
+      }
+      auto key = ChipDigitsContainer::getOrderingKey(resp.roFrame, resp.row, resp.col);
+      auto* pd = chip.findDigit(key);
+      if (!pd) {
+        chip.addDigit(key, resp.roFrame, resp.row, resp.col, resp.charge, resp.label);
+      } else {
+        pd->charge += resp.charge;
+      }
+    }
+    chip.extractPreDigits(0xffffffff, [&nOut](PreDigit& dig) { nOut += dig.charge; });
+    benchmark::DoNotOptimize(nOut);
+  }
+  state.SetItemsProcessed(state.iterations() * responses.size());
+}
+
+BENCHMARK(BM_PreDigitsMap)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_PreDigitsChipContainer)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,7 @@
 #ifndef O2_MCH_CLUSTERFINDERORIGINAL_H_
 #define O2_MCH_CLUSTERFINDERORIGINAL_H_
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -26,9 +27,11 @@
 #include <gsl/span>
 
 #include <TH2D.h>
+#include <TRandom.h>
 
 #include "DataFormatsMCH/Digit.h"
 #include "DataFormatsMCH/Cluster.h"
+#include "MCHBase/PreCluster.h"
 #include "MCHMappingInterface/Segmentation.h"
 #include "MCHPreClustering/PreClusterFinder.h"
 
@@ -57,11 +60,18 @@ class ClusterFinderOriginal
   void reset();
 
   void findClusters(gsl::span<const Digit> digits);
+  void findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits, int nThreads);
+
+  void setRandomSeed(uint32_t seed);
+  /// reseed the random generator per precluster also in the sequential processing of several preclusters
+  void setReseedPerPreCluster(bool reseed) { mReseedPerPreCluster = reseed; }
 
   /// return the list of reconstructed clusters
   const std::vector<Cluster>& getClusters() const { return mClusters; }
   /// return the list of digits used in reconstructed clusters
   const std::vector<Digit>& getUsedDigits() const { return mUsedDigits; }
+  /// return the index of the first cluster reconstructed from each precluster given to the last multi-precluster call
+  const std::vector<uint32_t>& getPreClusterFirstClusters() const { return mPreClusterFirstClusters; }
 
  private:
   static constexpr double SDistancePrecision = 1.e-3;            ///< precision used to check overlaps and so on (cm)
@@ -69,6 +79,17 @@ class ClusterFinderOriginal
   static constexpr int SNFitParamMax = 3 * SNFitClustersMax - 1; ///< maximum number of fit parameters
   static constexpr double SLowestCoupling = 1.e-2;               ///< minimum coupling between clusters of pixels and pads
 
+  /// location of the clusters and digits reconstructed from one precluster by one of the threads
+  struct PreClusterStat {
+    int thread = 0;            ///< index of the thread that processed the precluster
+    uint32_t firstCluster = 0; ///< index of the first cluster in the list of the thread
+    uint32_t nClusters = 0;    ///< number of clusters
+    uint32_t firstDigit = 0;   ///< index of the first used digit in the list of the thread
+    uint32_t nDigits = 0;      ///< number of used digits
+  };
+
+  void mergeThreadResults();
+
   void resetPreCluster(gsl::span<const Digit>& digits);
   void simplifyPreCluster(std::vector<int>& removedDigits);
   void processPreCluster();
@@ -92,6 +113,7 @@ class ClusterFinderOriginal
   int fit(const std::vector<const std::vector<int>*>& clustersOfPixels, const double fitRange[2][2], double fitParam[SNFitParamMax + 1]);
   double fit(double currentParam[SNFitParamMax + 2], const double parmin[SNFitParamMax], const double parmax[SNFitParamMax],
              int nParamUsed, int& nTrials) const;
+  void prepareFitPads();
   double computeChi2(const double param[SNFitParamMax + 2], int nParamUsed) const;
   void param2ChargeFraction(const double param[SNFitParamMax], int nParamUsed, double fraction[SNFitClustersMax]) const;
   float chargeIntegration(double x, double y, const PadOriginal& pad) const;
@@ -123,12 +145,28 @@ class ClusterFinderOriginal
   std::unique_ptr<ClusterOriginal> mPreCluster; ///< precluster currently processed
   std::vector<PadOriginal> mPixels;             ///< list of pixels for the current precluster
 
+  std::vector<double> mFitPadX{};             ///< position in x of the pads used in the current fit (cm)
+  std::vector<double> mFitPadY{};             ///< position in y of the pads used in the current fit (cm)
+  std::vector<double> mFitPadDX{};            ///< half dimension in x of the pads used in the current fit (cm)
+  std::vector<double> mFitPadDY{};            ///< half dimension in y of the pads used in the current fit (cm)
+  std::vector<double> mFitPadCharge{};        ///< charge of the pads used in the current fit
+  mutable std::vector<float> mFitAreas{};     ///< integration areas of the pads (xMin, yMin, xMax, yMax blocks)
+  mutable std::vector<float> mFitIntegrals{}; ///< Mathieson integrals over the pads for each fitted cluster
+
   const mapping::Segmentation* mSegmentation = nullptr; ///< pointer to the DE segmentation for the current precluster
 
   std::vector<Cluster> mClusters{}; ///< list of reconstructed clusters
   std::vector<Digit> mUsedDigits{}; ///< list of digits used in reconstructed clusters
 
   PreClusterFinder mPreClusterFinder{}; ///< preclusterizer
+
+  std::unique_ptr<TRandom> mRandom{}; ///< own random generator, if any (use gRandom otherwise)
+
+  bool mReseedPerPreCluster = false;                                    ///< reseed per precluster also when not running in parallel
+  bool mRun2Config = false;                                             ///< setup used for the thread cluster finders
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mThreadFinders{}; ///< cluster finders used by each thread
+  std::vector<PreClusterStat> mPreClusterStats{};                       ///< results of each precluster processed in parallel
+  std::vector<uint32_t> mPreClusterFirstClusters{};                     ///< index of the first cluster of each precluster
 };
 
 } // namespace mch
@@ -30,8 +30,11 @@
 
 #include <TH2I.h>
 #include <TAxis.h>
+#include <TDirectory.h>
 #include <TMath.h>
 #include <TRandom.h>
+#include <TRandom3.h>
+#include <TROOT.h>
 
 #include <FairLogger.h>
 
@@ -40,6 +43,10 @@
 #include "ClusterOriginal.h"
 #include "MathiesonOriginal.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mch
@@ -61,6 +68,7 @@ void ClusterFinderOriginal::init(bool run2Config)
 {
   /// initialize the clustering for run2 or run3 data
 
+  mRun2Config = run2Config;
   mPreClusterFinder.init();
 
   if (run2Config) {
@@ -111,6 +119,10 @@ void ClusterFinderOriginal::deinit()
 {
   /// deinitialize the clustering
   mPreClusterFinder.deinit();
+  for (auto& finder : mThreadFinders) {
+    finder->deinit();
+  }
+  mThreadFinders.clear();
 }
 
 //_________________________________________________________________________________________________
@@ -132,6 +144,10 @@ void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
     return;
   }
 
+  // do not attach the temporary histograms to the current directory, which is shared by the threads
+  // processing preclusters in parallel and where histograms with the same name would replace each other
+  TDirectory::TContext context(nullptr);
+
   // set the Mathieson function to be used
   mMathieson = (digits[0].getDetID() < 300) ? &mMathiesons[0] : &mMathiesons[1];
 
@@ -192,6 +208,105 @@ void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
   }
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits, int nThreads)
+{
+  /// reconstruct the clusters from a list of preclusters pointing to the given digits
+  /// reconstructed clusters and associated digits are added to the internal lists
+  /// with nThreads > 1 the preclusters are distributed over several threads, each one using its own
+  /// cluster finder, and the results are merged back in the order of the preclusters such that the
+  /// internal lists are the same as with the sequential processing, including the cluster unique IDs
+  /// with nThreads > 1 the random generator used in the fit is reseeded per precluster, with the precluster
+  /// index + 1. The sequential processing does the same if setReseedPerPreCluster(true) was called, such that
+  /// the results do not depend on the number of threads, and uses gRandom otherwise, as findClusters(digits)
+
+  mPreClusterFirstClusters.clear();
+  mPreClusterFirstClusters.reserve(preClusters.size());
+
+#ifndef WITH_OPENMP
+  nThreads = 1;
+#endif
+
+  if (nThreads < 2 || preClusters.size() < 2) {
+    for (size_t iPreCluster = 0; iPreCluster < preClusters.size(); ++iPreCluster) {
+      mPreClusterFirstClusters.push_back(mClusters.size());
+      if (mReseedPerPreCluster) {
+        setRandomSeed(iPreCluster + 1);
+      }
+      const auto& preCluster = preClusters[iPreCluster];
+      findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+    }
+    return;
+  }
+
+#ifdef WITH_OPENMP
+  // prepare one cluster finder per thread, configured as this one
+  if (static_cast<size_t>(nThreads) > mThreadFinders.size()) {
+    ROOT::EnableThreadSafety();
+    for (size_t iThread = mThreadFinders.size(); iThread < static_cast<size_t>(nThreads); ++iThread) {
+      auto& finder = mThreadFinders.emplace_back(std::make_unique<ClusterFinderOriginal>());
+      finder->init(mRun2Config);
+    }
+  }
+  for (auto& finder : mThreadFinders) {
+    finder->reset();
+  }
+
+  // clusterize the preclusters in parallel and keep track of where the results are stored
+  mPreClusterStats.resize(preClusters.size());
+  int nPreClusters = preClusters.size();
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+  for (int iPreCluster = 0; iPreCluster < nPreClusters; ++iPreCluster) {
+    int iThread = omp_get_thread_num();
+    auto& finder = *mThreadFinders[iThread];
+    auto& stat = mPreClusterStats[iPreCluster];
+    stat.thread = iThread;
+    stat.firstCluster = finder.mClusters.size();
+    stat.firstDigit = finder.mUsedDigits.size();
+    finder.setRandomSeed(iPreCluster + 1);
+    const auto& preCluster = preClusters[iPreCluster];
+    finder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+    stat.nClusters = finder.mClusters.size() - stat.firstCluster;
+    stat.nDigits = finder.mUsedDigits.size() - stat.firstDigit;
+  }
+
+  mergeThreadResults();
+#endif
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::mergeThreadResults()
+{
+  /// append the clusters and associated digits reconstructed by the threads to the internal lists,
+  /// in the order of the preclusters, and update their unique ID and the references to the digits
+
+  for (const auto& stat : mPreClusterStats) {
+
+    mPreClusterFirstClusters.push_back(mClusters.size());
+    const auto& finder = *mThreadFinders[stat.thread];
+
+    uint32_t digitOffset = mUsedDigits.size();
+    auto itFirstDigit = finder.mUsedDigits.begin() + stat.firstDigit;
+    mUsedDigits.insert(mUsedDigits.end(), itFirstDigit, itFirstDigit + stat.nDigits);
+
+    for (uint32_t iCluster = stat.firstCluster; iCluster < stat.firstCluster + stat.nClusters; ++iCluster) {
+      auto& cluster = mClusters.emplace_back(finder.mClusters[iCluster]);
+      cluster.uid = Cluster::buildUniqueId(cluster.getChamberId(), cluster.getDEId(), mClusters.size() - 1);
+      cluster.firstDigit = cluster.firstDigit - stat.firstDigit + digitOffset;
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::setRandomSeed(uint32_t seed)
+{
+  /// use an own random generator with the given seed in the fit instead of gRandom
+  if (!mRandom) {
+    mRandom = std::make_unique<TRandom3>();
+  }
+  mRandom->SetSeed(seed);
+}
+
 //_________________________________________________________________________________________________
 void ClusterFinderOriginal::resetPreCluster(gsl::span<const Digit>& digits)
 {
@@ -1390,6 +1505,9 @@ int ClusterFinderOriginal::fit(const std::vector<const std::vector<int>*>& clust
     }
   }
 
+  // cache the pads to be used in the fit in a vectorization-friendly layout
+  prepareFitPads();
+
   // try to fit with only 1 cluster, then 2 (if any), then 3 (if any) and stop if the fit gets worse
   // the fitted parameters are used as initial parameters of the corresponding cluster(s) for the next fit
   double chi2n0(std::numeric_limits<float>::max());
@@ -1620,7 +1738,7 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
       }
       if (nFail > 10) {
         currentParam[iDerivMax] -= shift[iDerivMax];
-        shift[iDerivMax] = 4. * shiftSave * (gRandom->Rndm(0) - 0.5);
+        shift[iDerivMax] = 4. * shiftSave * ((mRandom ? mRandom.get() : gRandom)->Rndm(0) - 0.5);
         currentParam[iDerivMax] += shift[iDerivMax];
       }
     }
@@ -1633,6 +1751,32 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
   return chi2[iBestParam];
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::prepareFitPads()
+{
+  /// store the position, size and charge of the pads to be used in the fit in contiguous arrays,
+  /// in the order they appear in the precluster, for the batched evaluation of the chi2
+
+  mFitPadX.clear();
+  mFitPadY.clear();
+  mFitPadDX.clear();
+  mFitPadDY.clear();
+  mFitPadCharge.clear();
+
+  for (const auto& pad : *mPreCluster) {
+    if (pad.status() == PadOriginal::kUseForFit) {
+      mFitPadX.push_back(pad.x());
+      mFitPadY.push_back(pad.y());
+      mFitPadDX.push_back(pad.dx());
+      mFitPadDY.push_back(pad.dy());
+      mFitPadCharge.push_back(pad.charge());
+    }
+  }
+
+  mFitAreas.resize(4 * mFitPadCharge.size());
+  mFitIntegrals.resize(SNFitClustersMax * mFitPadCharge.size());
+}
+
 //_________________________________________________________________________________________________
 double ClusterFinderOriginal::computeChi2(const double param[SNFitParamMax + 2], int nParamUsed) const
 {
@@ -1641,29 +1785,43 @@ double ClusterFinderOriginal::computeChi2(const double param[SNFitParamMax + 2],
   /// param[SNFitParamMax] is the total pixel charge associated to this part of the precluster
   /// param[SNFitParamMax+1] is the average pad charge
   /// nParamUsed is the number of cluster parameters effectively used (= #cluster * 3 - 1)
+  /// the pads to be used must have been cached beforehand with prepareFitPads()
 
   // get the fraction of charge carried by each cluster
   double chargeFraction[SNFitClustersMax] = {0.};
   param2ChargeFraction(param, nParamUsed, chargeFraction);
 
-  double chi2(0.);
-  for (const auto& pad : *mPreCluster) {
-
-    // skip pads not to be used for this fit
-    if (pad.status() != PadOriginal::kUseForFit) {
-      continue;
+  // integrate the Mathieson of each cluster over all the pads at once
+  int nPads = mFitPadCharge.size();
+  float* xMin = mFitAreas.data();
+  float* yMin = xMin + nPads;
+  float* xMax = yMin + nPads;
+  float* yMax = xMax + nPads;
+  for (int iParam = 0; iParam < nParamUsed; iParam += 3) {
+    for (int iPad = 0; iPad < nPads; ++iPad) {
+      double xPad = mFitPadX[iPad] - param[iParam];
+      double yPad = mFitPadY[iPad] - param[iParam + 1];
+      xMin[iPad] = xPad - mFitPadDX[iPad];
+      yMin[iPad] = yPad - mFitPadDY[iPad];
+      xMax[iPad] = xPad + mFitPadDX[iPad];
+      yMax[iPad] = yPad + mFitPadDY[iPad];
     }
+    mMathieson->integrate(nPads, xMin, yMin, xMax, yMax, &mFitIntegrals[iParam / 3 * nPads]);
+  }
+
+  double chi2(0.);
+  for (int iPad = 0; iPad < nPads; ++iPad) {
 
     // compute the expected pad charge with these cluster parameters
     double padChargeFit(0.);
     for (int iParam = 0; iParam < nParamUsed; iParam += 3) {
-      padChargeFit += chargeIntegration(param[iParam], param[iParam + 1], pad) * chargeFraction[iParam / 3];
+      padChargeFit += mFitIntegrals[iParam / 3 * nPads + iPad] * chargeFraction[iParam / 3];
     }
     padChargeFit *= param[SNFitParamMax];
 
     // compute the chi2
-    double delta = padChargeFit - pad.charge();
-    chi2 += delta * delta / pad.charge();
+    double delta = padChargeFit - mFitPadCharge[iPad];
+    chi2 += delta * delta / mFitPadCharge[iPad];
   }
 
   return chi2 / param[SNFitParamMax + 1];
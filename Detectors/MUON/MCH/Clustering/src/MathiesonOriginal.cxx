@@ -16,6 +16,8 @@
 
 #include "MathiesonOriginal.h"
 
+#include <cmath>
+
 #include <TMath.h>
 
 namespace o2
@@ -66,5 +68,27 @@ float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMa
                             mKy4 * (TMath::ATan(uyMax) - TMath::ATan(uyMin)));
 }
 
+//_________________________________________________________________________________________________
+void MathiesonOriginal::integrate(int n, const float* xMin, const float* yMin, const float* xMax, const float* yMax,
+                                  float* integrals) const
+{
+  /// integrate the Mathieson over x and y in the n given areas and store the results in integrals
+  /// the areas are given as contiguous arrays (SoA) so that the loop can be vectorized
+  /// the order of the operations is the same as for a single area to give identical results
+
+  for (int i = 0; i < n; ++i) {
+    float xMinScaled = xMin[i] * mInversePitch;
+    float xMaxScaled = xMax[i] * mInversePitch;
+    float yMinScaled = yMin[i] * mInversePitch;
+    float yMaxScaled = yMax[i] * mInversePitch;
+    double uxMin = mSqrtKx3 * std::tanh(static_cast<double>(mKx2 * xMinScaled));
+    double uxMax = mSqrtKx3 * std::tanh(static_cast<double>(mKx2 * xMaxScaled));
+    double uyMin = mSqrtKy3 * std::tanh(static_cast<double>(mKy2 * yMinScaled));
+    double uyMax = mSqrtKy3 * std::tanh(static_cast<double>(mKy2 * yMaxScaled));
+    integrals[i] = static_cast<float>(4. * mKx4 * (std::atan(uxMax) - std::atan(uxMin)) *
+                                      mKy4 * (std::atan(uyMax) - std::atan(uyMin)));
+  }
+}
+
 } // namespace mch
 } // namespace o2
@@ -41,6 +41,7 @@ class MathiesonOriginal
   void setSqrtKy3AndDeriveKy2Ky4(float sqrtKy3);
 
   float integrate(float xMin, float yMin, float xMax, float yMax) const;
+  void integrate(int n, const float* xMin, const float* yMin, const float* xMax, const float* yMax, float* integrals) const;
 
  private:
   float mSqrtKx3 = 0.;      ///< Mathieson Sqrt(Kx3)
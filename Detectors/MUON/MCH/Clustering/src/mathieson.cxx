@@ -26,7 +26,6 @@ const double sqrtK3x3_10 = 0.7131; // Pitch= 0.25 cm
 const double sqrtK3y3_10 = 0.7642; // Pitch= 0.25 cm
 const double pitch3_10 = 0.25;
 
-int mathiesonType; // 0 for Station 1 or 1 for station 2-5
 static double K1x[2], K1y[2];
 static double K2x[2], K2y[2];
 static const double sqrtK3x[2] = {sqrtK3x1_2, sqrtK3x3_10},
@@ -55,12 +54,10 @@ void compute2DPadIntegrals(const double* xInf, const double* xSup, const double*
                            int N, int chamberId, double Integrals[])
 {
   // Returning array: Charge Integral on all the pads
+  // The Mathieson type is local so that the function is re-entrant
+  // and can be used concurrently by several clustering threads
   //
-  if (chamberId <= 2) {
-    mathiesonType = 0;
-  } else {
-    mathiesonType = 1;
-  }
+  int mathiesonType = (chamberId <= 2) ? 0 : 1; // 0 for Station 1 or 1 for station 2-5
   //
   // Select Mathieson coef.
   double curK2x = K2x[mathiesonType];
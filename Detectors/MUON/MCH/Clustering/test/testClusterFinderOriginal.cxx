@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCHClustering ClusterFinderOriginal
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "DataFormatsMCH/Cluster.h"
+#include "DataFormatsMCH/Digit.h"
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ClusterFinderOriginal.h"
+#include "MCHMappingInterface/Segmentation.h"
+
+using namespace o2::mch;
+
+namespace
+{
+/// generate preclusters of one or two nearby hits with a gaussian charge spread
+/// on a few detection elements of each station
+void generatePreClusters(std::vector<PreCluster>& preClusters, std::vector<Digit>& digits)
+{
+  std::mt19937 gen(42);
+  for (int deId : {100, 300, 500, 709, 1025}) {
+    const auto& segmentation = mapping::segmentation(deId);
+    std::uniform_int_distribution<int> padDist(0, segmentation.nofPads() - 1);
+    for (int iPreCluster = 0; iPreCluster < 40; ++iPreCluster) {
+      int pad = padDist(gen);
+      double x = segmentation.padPositionX(pad);
+      double y = segmentation.padPositionY(pad);
+      std::vector<std::pair<double, double>> hits{{x, y}};
+      if (iPreCluster % 2 == 1) {
+        hits.emplace_back(x + 1., y + 0.5);
+      }
+      std::map<int, double> charges{};
+      segmentation.forEachPadInArea(x - 3., y - 3., x + 4., y + 3.5, [&](int padIndex) {
+        double charge = 0.;
+        for (const auto& hit : hits) {
+          double dx = segmentation.padPositionX(padIndex) - hit.first;
+          double dy = segmentation.padPositionY(padIndex) - hit.second;
+          charge += 1000. * std::exp(-(dx * dx + dy * dy) / 0.72);
+        }
+        if (charge > 5.) {
+          charges[padIndex] = charge;
+        }
+      });
+      if (charges.size() < 2) {
+        continue;
+      }
+      preClusters.push_back({static_cast<uint32_t>(digits.size()), static_cast<uint32_t>(charges.size())});
+      for (const auto& [padIndex, charge] : charges) {
+        digits.emplace_back(deId, padIndex, static_cast<uint32_t>(std::lround(charge)), 0);
+      }
+    }
+  }
+}
+} // namespace
+
+/// The clusters found by several threads are the same as the ones found sequentially,
+/// provided the random generator used in the fit is reseeded per precluster in both cases
+BOOST_AUTO_TEST_CASE(ParallelClustersIdenticalToSequentialOnes)
+{
+  std::vector<PreCluster> preClusters{};
+  std::vector<Digit> digits{};
+  generatePreClusters(preClusters, digits);
+  BOOST_REQUIRE_GT(preClusters.size(), 100);
+
+  ClusterFinderOriginal sequential{};
+  sequential.init(false);
+  sequential.setReseedPerPreCluster(true);
+  sequential.findClusters(preClusters, digits, 1);
+
+  ClusterFinderOriginal parallel{};
+  parallel.init(false);
+  parallel.findClusters(preClusters, digits, 4);
+
+  const auto& clusters = sequential.getClusters();
+  const auto& parallelClusters = parallel.getClusters();
+  BOOST_REQUIRE_GT(clusters.size(), 0);
+  BOOST_REQUIRE_EQUAL(parallelClusters.size(), clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    BOOST_TEST_CONTEXT("cluster " << i)
+    {
+      BOOST_CHECK_EQUAL(parallelClusters[i].x, clusters[i].x);
+      BOOST_CHECK_EQUAL(parallelClusters[i].y, clusters[i].y);
+      BOOST_CHECK_EQUAL(parallelClusters[i].z, clusters[i].z);
+      BOOST_CHECK_EQUAL(parallelClusters[i].ex, clusters[i].ex);
+      BOOST_CHECK_EQUAL(parallelClusters[i].ey, clusters[i].ey);
+      BOOST_CHECK_EQUAL(parallelClusters[i].uid, clusters[i].uid);
+      BOOST_CHECK_EQUAL(parallelClusters[i].firstDigit, clusters[i].firstDigit);
+      BOOST_CHECK_EQUAL(parallelClusters[i].nDigits, clusters[i].nDigits);
+    }
+  }
+  BOOST_CHECK(parallel.getUsedDigits() == sequential.getUsedDigits());
+  BOOST_CHECK(parallel.getPreClusterFirstClusters() == sequential.getPreClusterFirstClusters());
+
+  sequential.deinit();
+  parallel.deinit();
+}
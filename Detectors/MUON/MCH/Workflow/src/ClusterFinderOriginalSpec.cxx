@@ -16,6 +16,7 @@
 
 #include "MCHWorkflow/ClusterFinderOriginalSpec.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -66,6 +67,8 @@ class ClusterFinderOriginalTask
     mClusterFinder.init(run2Config);
 
     mAttachInitalPrecluster = ic.options().get<bool>("attach-initial-precluster");
+    mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+    mClusterFinder.setReseedPerPreCluster(ic.options().get<bool>("reseed-per-precluster"));
 
     /// Print the timer and clear the clusterizer when the processing is over
     ic.services().get<CallbackService>().set(CallbackService::Id::Stop, [this]() {
@@ -96,20 +99,21 @@ class ClusterFinderOriginalTask
       auto clusterOffset = clusters.size();
       mClusterFinder.reset();
 
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-
-        auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
-        auto firstClusterIdx = mClusterFinder.getClusters().size();
-
-        // clusterize the current precluster
-        auto tStart = std::chrono::high_resolution_clock::now();
-        mClusterFinder.findClusters(preclusterDigits);
-        auto tEnd = std::chrono::high_resolution_clock::now();
-        mTimeClusterFinder += tEnd - tStart;
-
-        if (mAttachInitalPrecluster) {
-          // store the new clusters and associate them to all the digits of the precluster
-          writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
+      // clusterize the preclusters of the current ROF, possibly in parallel
+      auto rofPreClusters = preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries());
+      auto tStart = std::chrono::high_resolution_clock::now();
+      mClusterFinder.findClusters(rofPreClusters, digits, mNThreads);
+      auto tEnd = std::chrono::high_resolution_clock::now();
+      mTimeClusterFinder += tEnd - tStart;
+
+      if (mAttachInitalPrecluster) {
+        // store the new clusters of each precluster and associate them to all the digits of the precluster
+        const auto& firstClusters = mClusterFinder.getPreClusterFirstClusters();
+        for (size_t iPreCluster = 0; iPreCluster < rofPreClusters.size(); ++iPreCluster) {
+          const auto& preCluster = rofPreClusters[iPreCluster];
+          auto lastClusterIdx = (iPreCluster + 1 < firstClusters.size()) ? firstClusters[iPreCluster + 1] : mClusterFinder.getClusters().size();
+          writeClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits), firstClusters[iPreCluster], lastClusterIdx,
+                        clusters, usedDigits);
         }
       }
 
@@ -129,19 +133,19 @@ class ClusterFinderOriginalTask
 
  private:
   //_________________________________________________________________________________________________
-  void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx,
+  void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx, size_t lastClusterIdx,
                      std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
-    /// fill the output messages with the new clusters and all the digits from the corresponding precluster
+    /// fill the output messages with the new clusters [firstClusterIdx, lastClusterIdx[ and all the digits from the corresponding precluster
     /// modify the references to the attached digits according to their position in the global vector
 
-    if (firstClusterIdx == mClusterFinder.getClusters().size()) {
+    if (firstClusterIdx == lastClusterIdx) {
       return;
     }
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin() + firstClusterIdx, mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin() + firstClusterIdx, mClusterFinder.getClusters().begin() + lastClusterIdx);
 
     auto digitOffset = usedDigits.size();
     usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
@@ -171,6 +175,7 @@ class ClusterFinderOriginalTask
   }
 
   bool mAttachInitalPrecluster = false;               ///< attach all digits of initial precluster to cluster
+  int mNThreads = 1;                                  ///< number of threads used to clusterize the preclusters of a ROF
   ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
   std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
 };
@@ -189,7 +194,9 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* specNa
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
             {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
-            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}}}};
+            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}},
+            {"nthreads", VariantType::Int, 1, {"Number of clustering threads"}},
+            {"reseed-per-precluster", VariantType::Bool, false, {"reseed the fit per precluster also with 1 thread, for results independent of nthreads"}}}};
 }
 
 } // end namespace mch
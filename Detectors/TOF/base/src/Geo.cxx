@@ -156,7 +156,6 @@ void Geo::InitIndices()
   if (!mToBeInitIndexing) {
     return;
   }
-  mToBeInitIndexing = kFALSE;
   // initialization of some indices arrays
 
   for (Int_t istrip = 0; istrip < NSTRIPXSECTOR; ++istrip) {
@@ -190,6 +189,8 @@ void Geo::InitIndices()
       mDistances[iplate].push_back(DISTANCES[iplate][nstrips - i - 1]);
     }
   }
+  // only flag the indices as initialized once they are all filled
+  mToBeInitIndexing = kFALSE;
 }
 
 std::string Geo::getVolumePath(const Int_t* ind)
@@ -21,6 +21,8 @@
 #include "Framework/DataProcessorSpec.h"
 #include "TOFCompression/Compressor.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 
 using namespace o2::framework;
 
@@ -39,8 +41,17 @@ class CompressorTask : public Task
   void run(ProcessingContext& pc) final;
 
  private:
+  /** compress all input parts on mNThreads threads into the part buffers **/
+  void compressParallel(const std::vector<DataRef>& parts);
+
   Compressor<RDH, verbose, paranoid> mCompressor;
   int mOutputBufferSize;
+
+  /** multi-threaded mode, independent parts (links, superpages) are compressed in parallel **/
+  int mNThreads = 1;
+  std::vector<std::unique_ptr<Compressor<RDH, verbose, paranoid>>> mThreadCompressors;
+  std::vector<std::vector<char>> mPartBuffers;
+  std::vector<uint32_t> mPartSizes;
 };
 
 } // namespace tof
@@ -1338,6 +1338,35 @@ void Compressor<RDH, verbose, paranoid>::resetCounters()
   }
 }
 
+template <typename RDH, bool verbose, bool paranoid>
+void Compressor<RDH, verbose, paranoid>::addCounters(const Compressor& other)
+{
+  mEventCounter += other.mEventCounter;
+  mFatalCounter += other.mFatalCounter;
+  mErrorCounter += other.mErrorCounter;
+  mDRMCounters.Headers += other.mDRMCounters.Headers;
+  mDRMCounters.EventWordsMismatch += other.mDRMCounters.EventWordsMismatch;
+  mDRMCounters.clockStatus += other.mDRMCounters.clockStatus;
+  mDRMCounters.Fault += other.mDRMCounters.Fault;
+  mDRMCounters.RTOBit += other.mDRMCounters.RTOBit;
+  for (int itrm = 0; itrm < 10; ++itrm) {
+    mTRMCounters[itrm].Headers += other.mTRMCounters[itrm].Headers;
+    mTRMCounters[itrm].Empty += other.mTRMCounters[itrm].Empty;
+    mTRMCounters[itrm].EventCounterMismatch += other.mTRMCounters[itrm].EventCounterMismatch;
+    mTRMCounters[itrm].EventWordsMismatch += other.mTRMCounters[itrm].EventWordsMismatch;
+    mTRMCounters[itrm].EBit += other.mTRMCounters[itrm].EBit;
+    for (int ichain = 0; ichain < 2; ++ichain) {
+      mTRMChainCounters[itrm][ichain].Headers += other.mTRMChainCounters[itrm][ichain].Headers;
+      mTRMChainCounters[itrm][ichain].EventCounterMismatch += other.mTRMChainCounters[itrm][ichain].EventCounterMismatch;
+      mTRMChainCounters[itrm][ichain].BadStatus += other.mTRMChainCounters[itrm][ichain].BadStatus;
+      mTRMChainCounters[itrm][ichain].BunchIDMismatch += other.mTRMChainCounters[itrm][ichain].BunchIDMismatch;
+      mTRMChainCounters[itrm][ichain].TDCerror += other.mTRMChainCounters[itrm][ichain].TDCerror;
+    }
+  }
+  mIntegratedBytes += other.mIntegratedBytes;
+  mIntegratedTime += other.mIntegratedTime;
+}
+
 template <typename RDH, bool verbose, bool paranoid>
 void Compressor<RDH, verbose, paranoid>::checkSummary()
 {
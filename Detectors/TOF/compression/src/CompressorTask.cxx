@@ -24,6 +24,12 @@
 #include "CommonUtils/VerbosityConfig.h"
 
 #include <fairmq/FairMQDevice.h>
+#include <algorithm>
+#include <cstring>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::framework;
 
@@ -42,13 +48,38 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
+  mNThreads = std::max(1, ic.options().get<int>("tof-compressor-nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "Compressor compiled without OpenMP support, running with 1 thread";
+    mNThreads = 1;
+  }
+#endif
 
   mCompressor.setDecoderCONET(decoderCONET);
   mCompressor.setDecoderVerbose(decoderVerbose);
   mCompressor.setEncoderVerbose(encoderVerbose);
   mCompressor.setCheckerVerbose(checkerVerbose);
 
+  /** one compressor per thread, they only share the read-only input **/
+  mThreadCompressors.clear();
+  if (mNThreads > 1) {
+    LOG(info) << "Compressor running on " << mNThreads << " threads";
+    for (int ithread = 0; ithread < mNThreads; ++ithread) {
+      auto& compressor = mThreadCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+      compressor->setDecoderCONET(decoderCONET);
+      compressor->setDecoderVerbose(decoderVerbose);
+      compressor->setEncoderVerbose(encoderVerbose);
+      compressor->setCheckerVerbose(checkerVerbose);
+      compressor->resetCounters();
+    }
+  }
+
   auto finishFunction = [this]() {
+    for (auto& compressor : mThreadCompressors) {
+      mCompressor.addCounters(*compressor);
+      compressor->resetCounters();
+    }
     mCompressor.checkSummary();
   };
 
@@ -132,6 +163,16 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     //  }
   }
 
+  /** multi-threaded mode: compress all parts first, in the order they are written out **/
+  std::vector<DataRef> allParts;
+  if (mNThreads > 1) {
+    for (auto& subspecPartEntry : subspecPartMap) {
+      allParts.insert(allParts.end(), subspecPartEntry.second.begin(), subspecPartEntry.second.end());
+    }
+    compressParallel(allParts);
+  }
+  size_t ipart = 0;
+
   /** loop over subspecs **/
   for (auto& subspecPartEntry : subspecPartMap) {
 
@@ -148,12 +189,28 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
 
     /** initialise output message **/
     auto bufferSize = mOutputBufferSize >= 0 ? mOutputBufferSize + subspecBufferSize[subspec] : std::abs(mOutputBufferSize);
+    if (mNThreads > 1) {
+      /** the compressed size is known already **/
+      bufferSize = 0;
+      for (size_t jpart = ipart; jpart < ipart + parts.size(); ++jpart) {
+        bufferSize += mPartSizes[jpart];
+      }
+    }
     auto payloadMessage = device->NewMessage(bufferSize);
     auto bufferPointer = (char*)payloadMessage->GetData();
 
     /** loop over subspec parts **/
     for (const auto& ref : parts) {
 
+      /** already compressed in parallel, copy the output **/
+      if (mNThreads > 1) {
+        std::memcpy(bufferPointer, mPartBuffers[ipart].data(), mPartSizes[ipart]);
+        bufferPointer += mPartSizes[ipart];
+        headerOut.payloadSize += mPartSizes[ipart];
+        ++ipart;
+        continue;
+      }
+
       /** input **/
       auto headerIn = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
       auto dataProcessingHeaderIn = DataRefUtils::getHeader<o2::framework::DataProcessingHeader*>(ref);
@@ -189,6 +246,41 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
   device->Send(partsOut, fairMQChannel);
 }
 
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorTask<RDH, verbose, paranoid>::compressParallel(const std::vector<DataRef>& parts)
+{
+  if (mPartBuffers.size() < parts.size()) {
+    mPartBuffers.resize(parts.size());
+  }
+  mPartSizes.assign(parts.size(), 0);
+
+  /** each part holds complete HBFs of a single link and is compressed independently **/
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ipart = 0; ipart < (int)parts.size(); ++ipart) {
+#ifdef WITH_OPENMP
+    auto& compressor = *mThreadCompressors[omp_get_thread_num()];
+#else
+    auto& compressor = *mThreadCompressors[0];
+#endif
+    const auto& ref = parts[ipart];
+    auto payloadInSize = DataRefUtils::getPayloadSize(ref);
+    auto bufferSize = mOutputBufferSize >= 0 ? mOutputBufferSize + payloadInSize : std::abs(mOutputBufferSize);
+    auto& buffer = mPartBuffers[ipart];
+    if (buffer.size() < bufferSize) {
+      buffer.resize(bufferSize);
+    }
+
+    compressor.setDecoderBuffer(ref.payload);
+    compressor.setDecoderBufferSize(payloadInSize);
+    compressor.setEncoderBuffer(buffer.data());
+    compressor.setEncoderBufferSize(bufferSize);
+    compressor.run();
+    mPartSizes[ipart] = compressor.getEncoderByteCounter();
+  }
+}
+
 template class CompressorTask<o2::header::RAWDataHeaderV6, false, false>;
 template class CompressorTask<o2::header::RAWDataHeaderV6, false, true>;
 template class CompressorTask<o2::header::RAWDataHeaderV6, true, false>;
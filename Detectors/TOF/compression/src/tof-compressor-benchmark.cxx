@@ -0,0 +1,203 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   tof-compressor-benchmark.cxx
+/// @brief  Standalone benchmark of the TOF compressor replaying raw data files
+
+#include "TOFCompression/Compressor.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include "Framework/Logger.h"
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace bpo = boost::program_options;
+
+using RDHUtils = o2::raw::RDHUtils;
+using Compressor = o2::tof::Compressor<o2::header::RAWDataHeaderV6, false, false>;
+
+/** a sequence of complete HBFs of one link, compressed independently like a DPL input part **/
+struct Chunk {
+  std::vector<char> input;
+  std::vector<char> output;
+  uint32_t outputSize = 0;
+};
+
+/** read the raw file, demultiplex the pages by link and cut the link streams into chunks of nHBF HBFs **/
+bool readChunks(const std::string& fname, int nHBF, std::vector<Chunk>& chunks)
+{
+  std::ifstream file(fname, std::ios::binary | std::ios::ate);
+  if (!file.good()) {
+    LOG(error) << "Cannot open file " << fname;
+    return false;
+  }
+  std::vector<char> buffer(size_t(file.tellg()));
+  file.seekg(0);
+  file.read(buffer.data(), buffer.size());
+
+  std::map<uint16_t, std::vector<char>> linkStreams;
+  std::map<uint16_t, int> linkHBFs;
+  std::map<uint16_t, std::vector<size_t>> linkCuts;
+  size_t offset = 0;
+  while (offset + sizeof(o2::header::RAWDataHeaderV6) <= buffer.size()) {
+    const char* rdh = buffer.data() + offset;
+    auto offsetToNext = RDHUtils::getOffsetToNext(rdh);
+    if (!RDHUtils::checkRDH(rdh, false) || offsetToNext == 0 || offset + offsetToNext > buffer.size()) {
+      LOG(error) << "Corrupted RDH at offset " << offset << ", stop reading";
+      break;
+    }
+    auto feeId = RDHUtils::getFEEID(rdh);
+    auto& stream = linkStreams[feeId];
+    /** cut only in front of an HBF opening page **/
+    if (RDHUtils::getPageCounter(rdh) == 0 && linkHBFs[feeId]++ == nHBF) {
+      linkCuts[feeId].push_back(stream.size());
+      linkHBFs[feeId] = 1;
+    }
+    stream.insert(stream.end(), rdh, rdh + offsetToNext);
+    offset += offsetToNext;
+  }
+
+  for (auto& [feeId, stream] : linkStreams) {
+    auto& cuts = linkCuts[feeId];
+    cuts.push_back(stream.size());
+    size_t start = 0;
+    for (auto cut : cuts) {
+      auto& chunk = chunks.emplace_back();
+      chunk.input.assign(stream.begin() + start, stream.begin() + cut);
+      /** the compressed output is smaller than the input, keep some margin for tiny chunks **/
+      chunk.output.resize(chunk.input.size() + 65536);
+      start = cut;
+    }
+  }
+  LOG(info) << "Read " << buffer.size() << " bytes from " << linkStreams.size() << " links into " << chunks.size() << " chunks";
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> fnames;
+  bpo::variables_map vm;
+  bpo::options_description descOpt("Options");
+  auto desc_add_option = descOpt.add_options();
+  desc_add_option("help,h", "print this help message.");
+  desc_add_option("threads,t", bpo::value<int>()->default_value(1), "number of threads compressing chunks in parallel");
+  desc_add_option("hbf-per-chunk,n", bpo::value<int>()->default_value(128), "number of HBFs of a link compressed in one go");
+  desc_add_option("repeat,r", bpo::value<int>()->default_value(10), "number of times the input is replayed");
+  desc_add_option("conet", "decode CONET mode data");
+
+  bpo::options_description hiddenOpt("hidden");
+  hiddenOpt.add_options()("files", bpo::value(&fnames)->composing(), "");
+
+  bpo::options_description fullOpt("cmd");
+  fullOpt.add(descOpt).add(hiddenOpt);
+
+  bpo::positional_options_description posOpt;
+  posOpt.add("files", -1);
+
+  auto printHelp = [&](std::ostream& stream) {
+    stream << "Usage:   " << argv[0] << " [options] file0 [... fileN]" << std::endl;
+    stream << descOpt << std::endl;
+  };
+
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv)
+                 .options(fullOpt)
+                 .positional(posOpt)
+                 .run(),
+               vm);
+    bpo::notify(vm);
+    if (argc == 1 || vm.count("help") || fnames.empty()) {
+      printHelp(std::cout);
+      return 0;
+    }
+  } catch (const bpo::error& e) {
+    std::cerr << e.what() << "\n\n";
+    std::cerr << "Error parsing command line arguments\n";
+    printHelp(std::cerr);
+    return -1;
+  }
+
+  auto nThreads = std::max(1, vm["threads"].as<int>());
+  auto nHBF = std::max(1, vm["hbf-per-chunk"].as<int>());
+  auto nRepeat = std::max(1, vm["repeat"].as<int>());
+#ifndef WITH_OPENMP
+  if (nThreads > 1) {
+    LOG(warning) << "Benchmark compiled without OpenMP support, running with 1 thread";
+    nThreads = 1;
+  }
+#endif
+
+  std::vector<Chunk> chunks;
+  for (const auto& fname : fnames) {
+    if (!readChunks(fname, nHBF, chunks)) {
+      return 1;
+    }
+  }
+  double inputBytes = 0;
+  for (const auto& chunk : chunks) {
+    inputBytes += chunk.input.size();
+  }
+
+  std::vector<std::unique_ptr<Compressor>> compressors;
+  for (int ithread = 0; ithread < nThreads; ++ithread) {
+    auto& compressor = compressors.emplace_back(std::make_unique<Compressor>());
+    compressor->setDecoderCONET(vm.count("conet"));
+    compressor->resetCounters();
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int irepeat = 0; irepeat < nRepeat; ++irepeat) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+    for (int ichunk = 0; ichunk < (int)chunks.size(); ++ichunk) {
+#ifdef WITH_OPENMP
+      auto& compressor = *compressors[omp_get_thread_num()];
+#else
+      auto& compressor = *compressors[0];
+#endif
+      auto& chunk = chunks[ichunk];
+      compressor.setDecoderBuffer(chunk.input.data());
+      compressor.setDecoderBufferSize(chunk.input.size());
+      compressor.setEncoderBuffer(chunk.output.data());
+      compressor.setEncoderBufferSize(chunk.output.size());
+      compressor.run();
+      chunk.outputSize = compressor.getEncoderByteCounter();
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+  double outputBytes = 0;
+  for (const auto& chunk : chunks) {
+    outputBytes += chunk.outputSize;
+  }
+  for (int ithread = 1; ithread < nThreads; ++ithread) {
+    compressors[0]->addCounters(*compressors[ithread]);
+  }
+  compressors[0]->checkSummary();
+
+  double throughput = inputBytes * nRepeat / elapsed.count() / 1.e9;
+  LOG(info) << "Compressed " << inputBytes * nRepeat / 1.e9 << " GB in " << elapsed.count() << " s on " << nThreads << " threads";
+  LOG(info) << "Throughput: " << throughput << " GB/s, " << throughput / nThreads << " GB/s per core";
+  LOG(info) << "Compression ratio: " << (inputBytes > 0 ? outputBytes / inputBytes : 0.);
+
+  return 0;
+}
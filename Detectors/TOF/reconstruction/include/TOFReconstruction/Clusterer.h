@@ -14,6 +14,7 @@
 #ifndef ALICEO2_TOF_CLUSTERER_H
 #define ALICEO2_TOF_CLUSTERER_H
 
+#include <memory>
 #include <utility>
 #include <vector>
 #include "DataFormatsTOF/Cluster.h"
@@ -62,6 +63,10 @@ class Clusterer
   void setCalibFromCluster(bool val = 1) { mCalibFromCluster = val; }
   bool isCalibFromCluster() const { return mCalibFromCluster; }
 
+  /// number of threads used to clusterize the strips in parallel (needs OpenMP)
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   void setDeltaTforClustering(float val) { mDeltaTforClustering = val; }
   float getDeltaTforClustering() const { return mDeltaTforClustering; }
   std::vector<o2::tof::CalibInfoCluster>* getInfoFromCluster() { return &mCalibInfosFromCluster; }
@@ -77,12 +82,32 @@ class Clusterer
   }
 
  private:
+  /// location of the clusters, labels and calibration infos produced from one strip by one of the threads
+  struct StripStat {
+    int thread = 0;            ///< index of the thread that processed the strip
+    uint32_t firstCluster = 0; ///< index of the first cluster in the list of the thread
+    uint32_t nClusters = 0;    ///< number of clusters
+    uint32_t firstLabel = 0;   ///< index of the first label entry in the container of the thread
+    uint32_t nLabels = 0;      ///< number of label entries
+    uint32_t firstCalib = 0;   ///< index of the first calibration info in the list of the thread
+    uint32_t nCalibs = 0;      ///< number of calibration infos
+  };
+
+  void processParallel(DataReader& reader, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+  void mergeThreadResults(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+
   void calibrateStrip();
+  void fillStripSoA();
   void processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
   //void fetchMCLabels(const Digit* dig, std::array<Label, Cluster::maxLabels>& labels, int& nfilled) const;
 
   StripData mStripData; ///< single strip data provided by the reader
 
+  // SoA copy of the quantities of the strip digits used in the clustering loop
+  std::vector<double> mStripTimes; //! calibrated time of the digits
+  std::vector<int> mStripPhi;      //! phi index of the digits
+  std::vector<int> mStripEta;      //! eta index of the digits
+
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mClsLabels = nullptr; // Cluster MC labels
 
   Digit* mContributingDigit[6];    //! array of digits contributing to the cluster; this will not be stored, it is temporary to build the final cluster
@@ -99,6 +124,13 @@ class Clusterer
   bool mIsNoisy[Geo::NCHANNELS];     //! noisy channel map
 
   std::vector<o2::tof::CalibInfoCluster> mCalibInfosFromCluster;
+
+  int mNThreads = 1;                                         //! number of threads used for the clusterization
+  std::vector<std::unique_ptr<Clusterer>> mThreadClusterers; //! clusterers used by each thread
+  std::vector<Cluster> mThreadClusters;                      //! clusters produced by this clusterer when used by a thread
+  MCLabelContainer mThreadLabels;                            //! cluster labels produced by this clusterer when used by a thread
+  std::vector<StripData> mStrips;                            //! strips of the TF, processed in parallel
+  std::vector<StripStat> mStripStats;                        //! results of each strip processed in parallel
 };
 
 } // namespace tof
@@ -18,6 +18,9 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include <TStopwatch.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::tof;
 
@@ -27,6 +30,12 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
   TStopwatch timerProcess;
   timerProcess.Start();
 
+  if (mNThreads > 1) {
+    processParallel(reader, clusters, digitMCTruth);
+    timerProcess.Stop();
+    return;
+  }
+
   reader.init();
   int totNumDigits = 0;
 
@@ -43,6 +52,107 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
   timerProcess.Stop();
 }
 
+//__________________________________________________
+void Clusterer::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(warning) << "TOF Clusterer compiled without OpenMP, using 1 thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
+//__________________________________________________
+void Clusterer::processParallel(DataReader& reader, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // strips are independent: they are read sequentially, clusterized in parallel by one clusterer per thread,
+  // and the results are merged in the order of the strips, such that the output does not depend on the number of threads
+
+  reader.init();
+  int nStrips = 0;
+  while (true) {
+    if (nStrips == (int)mStrips.size()) {
+      mStrips.emplace_back();
+    }
+    if (!reader.getNextStripData(mStrips[nStrips])) {
+      break;
+    }
+    nStrips++;
+  }
+
+  mThreadClusterers.resize(mNThreads);
+  for (auto& threadClusterer : mThreadClusterers) {
+    if (!threadClusterer) {
+      threadClusterer = std::make_unique<Clusterer>();
+    }
+    threadClusterer->mCalibApi = mCalibApi;
+    threadClusterer->mFirstOrbit = mFirstOrbit;
+    threadClusterer->mBCOffset = mBCOffset;
+    threadClusterer->mDeltaTforClustering = mDeltaTforClustering;
+    threadClusterer->mCalibFromCluster = mCalibFromCluster;
+    if (mCalibFromCluster) {
+      memcpy(threadClusterer->mIsNoisy, mIsNoisy, Geo::NCHANNELS * sizeof(mIsNoisy[0]));
+    }
+    threadClusterer->mClsLabels = &threadClusterer->mThreadLabels;
+    threadClusterer->mThreadClusters.clear();
+    threadClusterer->mThreadLabels.clear();
+    threadClusterer->mCalibInfosFromCluster.clear();
+  }
+  mStripStats.assign(nStrips, StripStat{});
+
+  // the geometry (pad positions, strip indices) is initialized at first use, which must not happen in the threads
+  Geo::Init();
+  Geo::InitIndices();
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iStrip = 0; iStrip < nStrips; ++iStrip) {
+#ifdef WITH_OPENMP
+    int thread = omp_get_thread_num();
+#else
+    int thread = 0;
+#endif
+    auto& clusterer = *mThreadClusterers[thread];
+    auto& stat = mStripStats[iStrip];
+    stat.thread = thread;
+    stat.firstCluster = clusterer.mThreadClusters.size();
+    stat.firstLabel = clusterer.mThreadLabels.getIndexedSize();
+    stat.firstCalib = clusterer.mCalibInfosFromCluster.size();
+    std::swap(clusterer.mStripData, mStrips[iStrip]);
+    clusterer.calibrateStrip();
+    clusterer.processStrip(clusterer.mThreadClusters, digitMCTruth);
+    std::swap(clusterer.mStripData, mStrips[iStrip]);
+    stat.nClusters = clusterer.mThreadClusters.size() - stat.firstCluster;
+    stat.nLabels = clusterer.mThreadLabels.getIndexedSize() - stat.firstLabel;
+    stat.nCalibs = clusterer.mCalibInfosFromCluster.size() - stat.firstCalib;
+  }
+
+  mergeThreadResults(clusters, digitMCTruth);
+}
+
+//__________________________________________________
+void Clusterer::mergeThreadResults(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // merge the clusters, labels and calibration infos produced by the threads, in the order of the strips
+
+  for (const auto& stat : mStripStats) {
+    auto& clusterer = *mThreadClusterers[stat.thread];
+    auto itFirst = clusterer.mThreadClusters.begin() + stat.firstCluster;
+    clusters.insert(clusters.end(), itFirst, itFirst + stat.nClusters);
+    if (digitMCTruth != nullptr) {
+      for (uint32_t i = 0; i < stat.nLabels; ++i) {
+        mClsLabels->addElements(mClsLabels->getIndexedSize(), clusterer.mThreadLabels.getLabels(stat.firstLabel + i));
+      }
+    }
+    auto itFirstCalib = clusterer.mCalibInfosFromCluster.begin() + stat.firstCalib;
+    mCalibInfosFromCluster.insert(mCalibInfosFromCluster.end(), itFirstCalib, itFirstCalib + stat.nCalibs);
+  }
+}
+
 //__________________________________________________
 void Clusterer::calibrateStrip()
 {
@@ -62,6 +172,23 @@ void Clusterer::calibrateStrip()
   }
 }
 
+//__________________________________________________
+void Clusterer::fillStripSoA()
+{
+  // copy the calibrated times and the phi/eta indices of the strip digits into contiguous arrays,
+  // such that the pairwise comparison in processStrip does not need to touch the digits
+
+  const int nDigits = mStripData.digits.size();
+  mStripTimes.resize(nDigits);
+  mStripPhi.resize(nDigits);
+  mStripEta.resize(nDigits);
+  for (int idig = 0; idig < nDigits; idig++) {
+    const Digit& dig = mStripData.digits[idig];
+    mStripTimes[idig] = dig.getCalibratedTime();
+    dig.getPhiAndEtaIndex(mStripPhi[idig], mStripEta[idig]);
+  }
+}
+
 //__________________________________________________
 void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
 {
@@ -73,6 +200,8 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
   Int_t iphi, iphi2, iphi3;
   Int_t ieta, ieta2, ieta3; // it is the number of padz-row increasing along the various strips
 
+  fillStripSoA();
+
   for (int idig = 0; idig < mStripData.digits.size(); idig++) {
     //    LOG(debug) << "Checking digit " << idig;
     Digit* dig = &mStripData.digits[idig];
@@ -82,7 +211,8 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
     }
 
     mNumberOfContributingDigits = 0;
-    dig->getPhiAndEtaIndex(iphi, ieta);
+    iphi = mStripPhi[idig];
+    ieta = mStripEta[idig];
     if (mStripData.digits.size() > 1) {
       LOG(debug) << "idig = " << idig;
     }
@@ -93,7 +223,7 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
     clusters.emplace_back();
     Cluster& c = clusters[noc];
     addContributingDigit(dig);
-    double timeDig = dig->getCalibratedTime();
+    double timeDig = mStripTimes[idig];
 
     for (int idigNext = idig + 1; idigNext < mStripData.digits.size(); idigNext++) {
       Digit* digNext = &mStripData.digits[idigNext];
@@ -101,12 +231,13 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
         continue; // the digit was already used to build a cluster, or was problematic
       }
       // check if the TOF time are close enough to be merged; if not, it means that nothing else will contribute to the cluster (since digits are ordered in time)
-      double timeDigNext = digNext->getCalibratedTime(); // in ps
+      double timeDigNext = mStripTimes[idigNext]; // in ps
       LOG(debug) << "Time difference = " << timeDigNext - timeDig;
       if (timeDigNext - timeDig > mDeltaTforClustering /*in ps*/) { // to be change to 500 ps
         break;
       }
-      digNext->getPhiAndEtaIndex(iphi2, ieta2);
+      iphi2 = mStripPhi[idigNext];
+      ieta2 = mStripEta[idigNext];
 
       // check if the fired pad are close in space
       LOG(debug) << "phi difference = " << iphi - iphi2;
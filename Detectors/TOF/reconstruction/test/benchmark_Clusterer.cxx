@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_Clusterer.cxx
+/// \brief Benchmark of the sequential and the multi-threaded TOF clusterization of a high multiplicity TF
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "CommonConstants/LHCConstants.h"
+#include "DataFormatsTOF/CalibLHCphaseTOF.h"
+#include "DataFormatsTOF/CalibTimeSlewingParamTOF.h"
+#include "TOFBase/CalibTOFapi.h"
+#include "TOFBase/Digit.h"
+#include "TOFBase/Geo.h"
+#include "TOFReconstruction/Clusterer.h"
+#include "TOFReconstruction/DataReader.h"
+
+using namespace o2::tof;
+
+namespace
+{
+constexpr int NOrbits = 128; // length of the TF
+
+/// generate digits uniformly distributed over the detector and over the TF, ordered by channel as done by the digitizer
+std::vector<Digit> generateDigits(int nDigits)
+{
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> channelDist(0, Geo::NCHANNELS - 1);
+  std::uniform_int_distribution<uint64_t> bcDist(0, uint64_t(NOrbits) * o2::constants::lhc::LHCMaxBunches - 1);
+  std::uniform_int_distribution<int> tdcDist(0, 1023);
+  std::uniform_int_distribution<int> totDist(100, 2000);
+  std::uniform_int_distribution<int> neighbourDist(-1, 1);
+
+  std::vector<Digit> digits;
+  digits.reserve(nDigits);
+  while (int(digits.size()) < nDigits) {
+    int channel = channelDist(gen);
+    uint64_t bc = bcDist(gen);
+    int tdc = tdcDist(gen);
+    digits.emplace_back(channel, tdc, totDist(gen), bc, int(digits.size()));
+    // half of the hits also fire a neighbouring pad of the same strip, close in time
+    int neighbour = channel + neighbourDist(gen);
+    if ((gen() & 1) && neighbour != channel && neighbour >= 0 && neighbour / Geo::NPADS == channel / Geo::NPADS) {
+      digits.emplace_back(neighbour, tdc + 5, totDist(gen), bc, int(digits.size()));
+    }
+  }
+  std::stable_sort(digits.begin(), digits.end(), [](const Digit& a, const Digit& b) { return a.getChannel() < b.getChannel(); });
+  return digits;
+}
+
+/// calibration with all corrections set to zero, as used by the clusterizer workflow when running without CCDB
+CalibTOFapi* createDummyCalibration()
+{
+  auto* lhcPhaseDummy = new o2::dataformats::CalibLHCphaseTOF();
+  auto* channelCalibDummy = new o2::dataformats::CalibTimeSlewingParamTOF();
+  lhcPhaseDummy->addLHCphase(0, 0);
+  lhcPhaseDummy->addLHCphase(2000000000, 0);
+  for (int ich = 0; ich < o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELS; ich++) {
+    channelCalibDummy->addTimeSlewingInfo(ich, 0, 0);
+    int sector = ich / o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELXSECTOR;
+    int channelInSector = ich % o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELXSECTOR;
+    channelCalibDummy->setFractionUnderPeak(sector, channelInSector, 1);
+  }
+  return new CalibTOFapi(long(0), lhcPhaseDummy, channelCalibDummy);
+}
+} // namespace
+
+static void BM_Clusterer(benchmark::State& state)
+{
+  static auto* calibApi = createDummyCalibration();
+  const int nThreads = state.range(0);
+  const auto digits = generateDigits(state.range(1));
+  const gsl::span<const Digit> digitSpan(digits);
+
+  Clusterer clusterer;
+  clusterer.setCalibApi(calibApi);
+  clusterer.setNThreads(nThreads);
+  DigitDataReader reader;
+  reader.setDigitArray(&digitSpan);
+
+  std::vector<o2::tof::Cluster> clusters;
+  for (auto _ : state) {
+    clusters.clear();
+    clusterer.process(reader, clusters, nullptr);
+    benchmark::DoNotOptimize(clusters);
+  }
+
+  state.counters["threads"] = clusterer.getNThreads();
+  state.counters["clusters"] = clusters.size();
+  state.counters["digits"] = benchmark::Counter(digits.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// arguments: number of threads, number of digits in the TF
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int nDigits : {100000, 1000000}) {
+    for (int nThreads : {1, 2, 4, 8}) {
+      bench->Args({nThreads, nDigits});
+    }
+  }
+}
+
+BENCHMARK(BM_Clusterer)->Apply(CustomArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
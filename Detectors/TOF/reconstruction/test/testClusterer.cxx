@@ -0,0 +1,185 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TOFClusterer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMatrix.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <TMath.h>
+#include <TString.h>
+
+#include "CommonConstants/LHCConstants.h"
+#include "DataFormatsTOF/CalibLHCphaseTOF.h"
+#include "DataFormatsTOF/CalibTimeSlewingParamTOF.h"
+#include "TOFBase/CalibTOFapi.h"
+#include "TOFBase/Digit.h"
+#include "TOFBase/Geo.h"
+#include "TOFReconstruction/Clusterer.h"
+#include "TOFReconstruction/DataReader.h"
+
+using namespace o2::tof;
+
+namespace
+{
+/// minimal geometry with the volume hierarchy of the TOF pads, such that Geo::Init() finds all of them
+/// without loading the full geometry
+void buildPadGeometry()
+{
+  auto* geom = new TGeoManager("TOFtest", "TOF pads");
+  auto* vacuum = new TGeoMedium("vacuum", 1, new TGeoMaterial("vacuum", 0., 0., 0.));
+  auto box = [geom, vacuum](const char* name) { return geom->MakeBox(name, vacuum, 1., 1., 1.); };
+
+  auto* pad = box("FPAD");
+  auto* padRow = box("FSEZ");
+  for (int ipadx = 0; ipadx < Geo::NPADX; ++ipadx) {
+    padRow->AddNode(pad, ipadx + 1, new TGeoTranslation((ipadx - 0.5 * Geo::NPADX) * Geo::XPAD, 0., 0.));
+  }
+  auto* sensitive = box("FSEN");
+  for (int ipadz = 0; ipadz < Geo::NPADZ; ++ipadz) {
+    sensitive->AddNode(padRow, ipadz + 1, new TGeoTranslation(0., 0., (ipadz - 0.5) * Geo::ZPAD));
+  }
+  auto* pcb = box("FPCB");
+  pcb->AddNode(sensitive, 1);
+  auto* strip = box("FSTR");
+  strip->AddNode(pcb, 1);
+
+  // strips are numbered from 1 along z, the sectors in front of PHOS miss the ones of the central plate
+  auto makeModule = [&](const char* module, const char* layer, int firstStrip, int lastStrip) {
+    auto* stripLayer = box(layer);
+    for (int istrip = firstStrip; istrip <= lastStrip; ++istrip) {
+      stripLayer->AddNode(strip, istrip, new TGeoTranslation(0., 0., (istrip - 0.5 * Geo::NSTRIPXSECTOR) * 8.));
+    }
+    auto* tofModule = box(module);
+    tofModule->AddNode(stripLayer, 0);
+    return tofModule;
+  };
+  auto* fullModule = makeModule("FTOA", "FLTA", 1, Geo::NSTRIPXSECTOR);
+  auto* frontModule = makeModule("FTOB", "FLTB", 1, Geo::NSTRIPC + Geo::NSTRIPB);
+  auto* backModule = makeModule("FTOC", "FLTC", Geo::NSTRIPC + Geo::NSTRIPB + Geo::NSTRIPA + 1, Geo::NSTRIPXSECTOR);
+
+  auto* tofBarrel = box("B077");
+  for (int isector = 0; isector < Geo::NSECTORS; ++isector) {
+    auto* tofSector = box(Form("BTOF%d", isector));
+    if (isector == 13 || isector == 14 || isector == 15) {
+      tofSector->AddNode(frontModule, 0);
+      tofSector->AddNode(backModule, 0);
+    } else {
+      tofSector->AddNode(fullModule, 0);
+    }
+    auto* segment = box(Form("BSEGMO%d", isector));
+    segment->AddNode(tofSector, 1);
+    double phi = (isector + 0.5) * Geo::PHISEC;
+    auto* rotation = new TGeoRotation();
+    rotation->RotateZ(phi - 90.);
+    tofBarrel->AddNode(segment, 1, new TGeoCombiTrans(Geo::XTOF * std::cos(phi * TMath::DegToRad()), Geo::XTOF * std::sin(phi * TMath::DegToRad()), 0., rotation));
+  }
+  auto* barrel = box("barrel");
+  barrel->AddNode(tofBarrel, 1);
+  auto* cave = box("cave");
+  cave->AddNode(barrel, 1);
+  geom->SetTopVolume(cave);
+  geom->CloseGeometry();
+}
+
+/// digits over the whole detector and a TF of 32 orbits, half of the hits also firing a neighbouring pad,
+/// ordered by channel as done by the digitizer
+std::vector<Digit> generateDigits(int nDigits)
+{
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> channelDist(0, Geo::NCHANNELS - 1);
+  std::uniform_int_distribution<uint64_t> bcDist(0, 32 * o2::constants::lhc::LHCMaxBunches - 1);
+  std::uniform_int_distribution<int> tdcDist(0, 1023);
+  std::uniform_int_distribution<int> totDist(100, 2000);
+  std::uniform_int_distribution<int> neighbourDist(-1, 1);
+
+  std::vector<Digit> digits;
+  while (int(digits.size()) < nDigits) {
+    int channel = channelDist(gen);
+    uint64_t bc = bcDist(gen);
+    int tdc = tdcDist(gen);
+    digits.emplace_back(channel, tdc, totDist(gen), bc, int(digits.size()));
+    int neighbour = channel + neighbourDist(gen);
+    if ((gen() & 1) && neighbour != channel && neighbour >= 0 && neighbour / Geo::NPADS == channel / Geo::NPADS) {
+      digits.emplace_back(neighbour, tdc + 5, totDist(gen), bc, int(digits.size()));
+    }
+  }
+  std::stable_sort(digits.begin(), digits.end(), [](const Digit& a, const Digit& b) { return a.getChannel() < b.getChannel(); });
+  return digits;
+}
+
+/// calibration with all corrections set to zero
+CalibTOFapi* createDummyCalibration()
+{
+  auto* lhcPhaseDummy = new o2::dataformats::CalibLHCphaseTOF();
+  auto* channelCalibDummy = new o2::dataformats::CalibTimeSlewingParamTOF();
+  lhcPhaseDummy->addLHCphase(0, 0);
+  lhcPhaseDummy->addLHCphase(2000000000, 0);
+  for (int ich = 0; ich < o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELS; ich++) {
+    channelCalibDummy->addTimeSlewingInfo(ich, 0, 0);
+    int sector = ich / o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELXSECTOR;
+    int channelInSector = ich % o2::dataformats::CalibTimeSlewingParamTOF::NCHANNELXSECTOR;
+    channelCalibDummy->setFractionUnderPeak(sector, channelInSector, 1);
+  }
+  return new CalibTOFapi(long(0), lhcPhaseDummy, channelCalibDummy);
+}
+
+std::vector<o2::tof::Cluster> findClusters(gsl::span<const Digit> digits, CalibTOFapi* calibApi, int nThreads)
+{
+  Clusterer clusterer;
+  clusterer.setCalibApi(calibApi);
+  clusterer.setNThreads(nThreads);
+  DigitDataReader reader;
+  reader.setDigitArray(&digits);
+  std::vector<o2::tof::Cluster> clusters;
+  clusterer.process(reader, clusters, nullptr);
+  return clusters;
+}
+} // namespace
+
+/// The clusters found with several threads are the same, and in the same order, as the sequential ones.
+/// The geometry is not initialized beforehand, such that the parallel processing is the first to use it.
+BOOST_AUTO_TEST_CASE(ParallelClustersIdenticalToSequentialOnes)
+{
+  buildPadGeometry();
+  auto* calibApi = createDummyCalibration();
+  const auto digits = generateDigits(50000);
+
+  auto parallelClusters = findClusters(digits, calibApi, 4);
+  auto clusters = findClusters(digits, calibApi, 1);
+
+  BOOST_REQUIRE_GT(clusters.size(), 0);
+  BOOST_REQUIRE_EQUAL(parallelClusters.size(), clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    BOOST_TEST_CONTEXT("cluster " << i)
+    {
+      BOOST_CHECK_EQUAL(parallelClusters[i].getMainContributingChannel(), clusters[i].getMainContributingChannel());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getAdditionalContributingChannels(), clusters[i].getAdditionalContributingChannels());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getTimeRaw(), clusters[i].getTimeRaw());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getTime(), clusters[i].getTime());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getTot(), clusters[i].getTot());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getDeltaBC(), clusters[i].getDeltaBC());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getX(), clusters[i].getX());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getY(), clusters[i].getY());
+      BOOST_CHECK_EQUAL(parallelClusters[i].getZ(), clusters[i].getZ());
+    }
+  }
+}
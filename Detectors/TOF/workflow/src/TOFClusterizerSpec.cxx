@@ -78,6 +78,8 @@ class TOFDPLClustererTask
 
     mClusterer.setCalibFromCluster(mIsCalib);
     mClusterer.setDeltaTforClustering(mTimeWin);
+    mClusterer.setNThreads(ic.options().get<int>("nthreads"));
+    LOG(debug) << "Number of threads for clusterization = " << mClusterer.getNThreads();
 
     // initialize collision context
     if (gSystem->AccessPathName("collisioncontext.root")) {
@@ -319,7 +321,8 @@ o2::framework::DataProcessorSpec getTOFClusterizerSpec(bool useMC, bool useCCDB,
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<TOFDPLClustererTask>(useMC, useCCDB, doCalib, isCosmic, ccdb_url)},
-    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}}}};
+    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads used to clusterize the strips in parallel"}}}};
 }
 
 } // end namespace tof
@@ -18,6 +18,7 @@
 #define ALICEO2_IDCFOURIERTRANSFORM_H_
 
 #include <vector>
+#include <string>
 #include "Rtypes.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCCalibration/IDCContainer.h"
@@ -63,6 +64,15 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// \param fft use FFTW3 or not (naive approach)
   static void setFFT(const bool fft) { sFftw = fft; }
 
+  /// set batched fast fourier transform using FFTW3: the transforms of all intervals are performed directly on the 1D-IDC buffer using FFTW_MEASURE plans.
+  /// If the intervals are equidistant all of them are transformed with one batched plan per thread, otherwise one plan is executed for each interval
+  /// \param batched use batched FFTW3 plans
+  static void setBatchedFFT(const bool batched) { sBatchedFftw = batched; }
+
+  /// set file used to store the FFTW wisdom of the batched plans between runs. The wisdom is loaded before the first plan is created and updated after each new plan
+  /// \param wisdomFile path to the wisdom file (empty: no wisdom is stored)
+  static void setFFTWWisdomFile(const std::string& wisdomFile) { sWisdomFile = wisdomFile; }
+
   /// This function has to be called before the constructor is called
   /// \param nThreads set the number of threads used for calculation of the fourier coefficients
   template <bool IsEnabled = true, typename std::enable_if<(IsEnabled && (std::is_same<Type, IDCFourierTransformBaseAggregator>::value)), int>::type = 0>
@@ -87,6 +97,12 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// get type of used fourier transform
   static bool getFFT() { return sFftw; }
 
+  /// get if batched FFTW3 plans are used
+  static bool getBatchedFFT() { return sBatchedFftw; }
+
+  /// get file used to store the FFTW wisdom
+  static const std::string& getFFTWWisdomFile() { return sWisdomFile; }
+
   /// get the number of threads used for calculation of the fourier coefficients
   static int getNThreads() { return sNThreads; }
 
@@ -103,12 +119,22 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   void printFFTWPlan() const;
 
  private:
-  FourierCoeff mFourierCoefficients;         ///< fourier coefficients. side -> interval -> coefficient
-  inline static int sFftw{1};                ///< using fftw or naive approach for calculation of fourier coefficients
-  inline static int sNThreads{1};            ///< number of threads which are used during the calculation of the fourier coefficients
-  fftwf_plan mFFTWPlan{nullptr};             ///<! FFTW plan which is used during the ft
-  std::vector<float*> mVal1DIDCs;            ///<! buffer for the 1D-IDC values for SIMD usage (each thread will get his one obejct)
-  std::vector<fftwf_complex*> mCoefficients; ///<! buffer for coefficients (each thread will get his one obejct)
+  FourierCoeff mFourierCoefficients;          ///< fourier coefficients. side -> interval -> coefficient
+  inline static int sFftw{1};                 ///< using fftw or naive approach for calculation of fourier coefficients
+  inline static int sNThreads{1};             ///< number of threads which are used during the calculation of the fourier coefficients
+  fftwf_plan mFFTWPlan{nullptr};              ///<! FFTW plan which is used during the ft
+  std::vector<float*> mVal1DIDCs;             ///<! buffer for the 1D-IDC values for SIMD usage (each thread will get his one obejct)
+  std::vector<fftwf_complex*> mCoefficients;  ///<! buffer for coefficients (each thread will get his one obejct)
+  inline static bool sBatchedFftw{false};     ///< using batched FFTW plans on the 1D-IDC buffer
+  inline static std::string sWisdomFile{};    ///< file in which the FFTW wisdom is stored
+  inline static bool sWisdomLoaded{false};    ///< flag if the FFTW wisdom was already loaded
+  fftwf_plan mFFTWPlanUnaligned{nullptr};     ///<! FFTW plan for a single interval which can be executed directly on the (unaligned) 1D-IDC buffer
+  fftwf_plan mFFTWPlanBatch{nullptr};         ///<! FFTW plan for a batch of equidistant intervals
+  fftwf_plan mFFTWPlanBatchLast{nullptr};     ///<! FFTW plan for the last batch of equidistant intervals
+  unsigned int mBatchDist{0};                 ///<! distance between the intervals for which the batched plans were created
+  unsigned int mBatchSize{0};                 ///<! number of intervals per batch for which the batched plans were created
+  unsigned int mBatchSizeLast{0};             ///<! number of intervals in the last batch for which the batched plans were created
+  fftwf_complex* mCoefficientsBatch{nullptr}; ///<! buffer for the coefficients of all intervals
 
   /// calculate fourier coefficients
   void calcFourierCoefficientsNaive();
@@ -145,6 +171,24 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   /// initalizing fftw members
   void initFFTW3Members();
 
+  /// performing of ft using batched FFTW plans directly on the 1D-IDC buffer
+  void fftwBatched(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const o2::tpc::Side side);
+
+  /// creating the plans for the batched ft
+  /// \param dist distance between the equidistant intervals (0 if the intervals are not equidistant)
+  /// \param batchSize number of intervals per batch
+  /// \param batchSizeLast number of intervals in the last batch
+  void initFFTW3BatchPlans(const unsigned int dist, const unsigned int batchSize, const unsigned int batchSizeLast);
+
+  /// create FFTW_MEASURE plan for howmany intervals separated by dist which can be executed on unaligned buffers
+  fftwf_plan createFFTWMeasurePlan(const unsigned int howmany, const unsigned int dist) const;
+
+  /// loading the FFTW wisdom from sWisdomFile
+  static void importFFTWWisdom();
+
+  /// storing the FFTW wisdom to sWisdomFile
+  static void exportFFTWWisdom();
+
   /// performing of ft using FFTW
   void fftwLoop(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const unsigned int interval, const o2::tpc::Side side, const unsigned int thread);
 
@@ -30,6 +30,12 @@ o2::tpc::IDCFourierTransform<Type>::~IDCFourierTransform()
     fftwf_free(mCoefficients[thread]);
   }
   fftwf_destroy_plan(mFFTWPlan);
+  for (auto plan : {mFFTWPlanUnaligned, mFFTWPlanBatch, mFFTWPlanBatchLast}) {
+    if (plan) {
+      fftwf_destroy_plan(plan);
+    }
+  }
+  fftwf_free(mCoefficientsBatch);
 }
 
 template <class Type>
@@ -116,7 +122,9 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsFFTW3(const o2::
   const std::vector<unsigned int> offsetIndex = this->getLastIntervals(side);
   const std::vector<float>& idcOneExpanded{this->getExpandedIDCOne(side)}; // 1D-IDC values which will be used for the FFT
 
-  if constexpr (std::is_same_v<Type, IDCFourierTransformBaseAggregator>) {
+  if (sBatchedFftw) {
+    fftwBatched(idcOneExpanded, offsetIndex, side);
+  } else if constexpr (std::is_same_v<Type, IDCFourierTransformBaseAggregator>) {
 #pragma omp parallel for num_threads(sNThreads)
     for (unsigned int interval = 0; interval < this->getNIntervals(); ++interval) {
       fftwLoop(idcOneExpanded, offsetIndex, interval, side, omp_get_thread_num());
@@ -136,6 +144,124 @@ inline void o2::tpc::IDCFourierTransform<Type>::fftwLoop(const std::vector<float
   std::memcpy(&(*(mFourierCoefficients.mFourierCoefficients[side].begin() + mFourierCoefficients.getIndex(interval, 0))), mCoefficients[thread], mFourierCoefficients.getNCoefficientsPerTF() * sizeof(float)); // store coefficients
 }
 
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::fftwBatched(const std::vector<float>& idcOneExpanded, const std::vector<unsigned int>& offsetIndex, const o2::tpc::Side side)
+{
+  // check if the intervals are equidistant (not the case when the number of integration intervals differs between the TFs)
+  const unsigned int nIntervals = offsetIndex.size();
+  unsigned int dist = (nIntervals > 1) ? offsetIndex[1] - offsetIndex[0] : this->mRangeIDC;
+  for (unsigned int interval = 2; interval < nIntervals; ++interval) {
+    if (offsetIndex[interval] - offsetIndex[interval - 1] != dist) {
+      dist = 0;
+      break;
+    }
+  }
+
+  // one batch of consecutive intervals per thread
+  const unsigned int nThreads = std::max(1u, std::min(static_cast<unsigned int>(sNThreads), nIntervals));
+  const unsigned int batchSize = (nIntervals + nThreads - 1) / nThreads;
+  const unsigned int nBatches = (nIntervals + batchSize - 1) / batchSize;
+  const unsigned int batchSizeLast = nIntervals - (nBatches - 1) * batchSize;
+  initFFTW3BatchPlans(dist, batchSize, batchSizeLast);
+
+  // r2c out-of-place transforms do not modify the input
+  float* idcs = const_cast<float*>(idcOneExpanded.data());
+  const unsigned int nMaxCoeff = getNMaxCoefficients();
+  const unsigned int nCoeff = mFourierCoefficients.getNCoefficientsPerTF();
+  auto& coefficients = mFourierCoefficients.mFourierCoefficients[side];
+
+#pragma omp parallel for num_threads(sNThreads)
+  for (unsigned int batch = 0; batch < nBatches; ++batch) {
+    const unsigned int firstInterval = batch * batchSize;
+    const unsigned int lastInterval = firstInterval + ((batch == nBatches - 1) ? batchSizeLast : batchSize);
+    if (dist) {
+      fftwf_execute_dft_r2c((batch == nBatches - 1) ? mFFTWPlanBatchLast : mFFTWPlanBatch, idcs + offsetIndex[firstInterval], mCoefficientsBatch + firstInterval * nMaxCoeff);
+    } else {
+      for (unsigned int interval = firstInterval; interval < lastInterval; ++interval) {
+        fftwf_execute_dft_r2c(mFFTWPlanUnaligned, idcs + offsetIndex[interval], mCoefficientsBatch + interval * nMaxCoeff);
+      }
+    }
+    for (unsigned int interval = firstInterval; interval < lastInterval; ++interval) {
+      std::memcpy(&coefficients[mFourierCoefficients.getIndex(interval, 0)], mCoefficientsBatch + interval * nMaxCoeff, nCoeff * sizeof(float)); // store coefficients
+    }
+  }
+}
+
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::initFFTW3BatchPlans(const unsigned int dist, const unsigned int batchSize, const unsigned int batchSizeLast)
+{
+  // FFTW planner is not thread safe: plans are created only here, outside of the parallel regions
+  if (!mCoefficientsBatch) {
+    mCoefficientsBatch = fftwf_alloc_complex(this->getNIntervals() * getNMaxCoefficients());
+  }
+  if (!sWisdomLoaded) {
+    importFFTWWisdom();
+    sWisdomLoaded = true;
+  }
+
+  bool newPlan = false;
+  if (dist == 0) {
+    if (!mFFTWPlanUnaligned) {
+      mFFTWPlanUnaligned = createFFTWMeasurePlan(1, this->mRangeIDC);
+      newPlan = true;
+    }
+  } else if ((dist != mBatchDist) || (batchSize != mBatchSize) || (batchSizeLast != mBatchSizeLast)) {
+    for (auto plan : {mFFTWPlanBatch, mFFTWPlanBatchLast}) {
+      if (plan) {
+        fftwf_destroy_plan(plan);
+      }
+    }
+    mFFTWPlanBatch = createFFTWMeasurePlan(batchSize, dist);
+    mFFTWPlanBatchLast = createFFTWMeasurePlan(batchSizeLast, dist);
+    mBatchDist = dist;
+    mBatchSize = batchSize;
+    mBatchSizeLast = batchSizeLast;
+    newPlan = true;
+  }
+
+  if (newPlan) {
+    exportFFTWWisdom();
+  }
+}
+
+template <class Type>
+fftwf_plan o2::tpc::IDCFourierTransform<Type>::createFFTWMeasurePlan(const unsigned int howmany, const unsigned int dist) const
+{
+  // FFTW_MEASURE overwrites the arrays during planning: use temporary buffers
+  const int n = this->mRangeIDC;
+  const int nMaxCoeff = getNMaxCoefficients();
+  float* val1DIDCs = fftwf_alloc_real((howmany - 1) * dist + this->mRangeIDC);
+  fftwf_complex* coefficients = fftwf_alloc_complex(howmany * nMaxCoeff);
+  const fftwf_plan plan = fftwf_plan_many_dft_r2c(1, &n, howmany, val1DIDCs, nullptr, 1, dist, coefficients, nullptr, 1, nMaxCoeff, FFTW_MEASURE | FFTW_UNALIGNED);
+  fftwf_free(coefficients);
+  fftwf_free(val1DIDCs);
+  return plan;
+}
+
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::importFFTWWisdom()
+{
+  if (sWisdomFile.empty()) {
+    return;
+  }
+  if (fftwf_import_wisdom_from_filename(sWisdomFile.data())) {
+    LOGP(info, "FFTW wisdom loaded from {}", sWisdomFile);
+  } else {
+    LOGP(info, "FFTW wisdom could not be loaded from {}, plans will be measured", sWisdomFile);
+  }
+}
+
+template <class Type>
+void o2::tpc::IDCFourierTransform<Type>::exportFFTWWisdom()
+{
+  if (sWisdomFile.empty()) {
+    return;
+  }
+  if (!fftwf_export_wisdom_to_filename(sWisdomFile.data())) {
+    LOGP(warning, "FFTW wisdom could not be stored to {}", sWisdomFile);
+  }
+}
+
 template <class Type>
 std::vector<std::vector<float>> o2::tpc::IDCFourierTransform<Type>::inverseFourierTransformNaive(const o2::tpc::Side side) const
 {
@@ -94,6 +94,50 @@ BOOST_AUTO_TEST_CASE(IDCFourierTransformAggregator_test)
   }
 }
 
+// testing batched FFTW plans of aggregator against the default FFTW plan
+BOOST_AUTO_TEST_CASE(IDCFourierTransformAggregatorBatched_test)
+{
+  const unsigned int integrationIntervals = 10; // number of integration intervals for first TF
+  const unsigned int tfs = 200;                 // number of aggregated TFs
+  const unsigned int rangeIDC = 200;            // number of IDCs used to calculate the fourier coefficients
+  const unsigned int nFourierCoeff = 60;        // number of fourier coefficients which will be calculated/stored
+  using FtType = IDCFourierTransform<IDCFourierTransformBaseAggregator>;
+  gRandom->SetSeed(0);
+  FtType::setFFT(true);
+
+  // equidistant and non equidistant intervals
+  for (const bool equidistant : {true, false}) {
+    std::vector<unsigned int> intervalsPerTF = equidistant ? std::vector<unsigned int>(tfs, integrationIntervals) : getIntegrationIntervalsPerTF(integrationIntervals, tfs);
+    const auto idcsFirst = get1DIDCs(intervalsPerTF);
+    const auto idcsSecond = get1DIDCs(intervalsPerTF);
+
+    for (const int nThreads : {1, 3}) {
+      FtType::setNThreads(nThreads);
+      FtType idcFourierTransform{rangeIDC, tfs, nFourierCoeff};
+      FtType idcFourierTransformBatched{rangeIDC, tfs, nFourierCoeff};
+      for (auto* ft : {&idcFourierTransform, &idcFourierTransformBatched}) {
+        ft->setIDCs(idcsFirst, intervalsPerTF);
+        ft->setIDCs(idcsSecond, intervalsPerTF);
+      }
+      FtType::setBatchedFFT(false);
+      idcFourierTransform.calcFourierCoefficients();
+      FtType::setBatchedFFT(true);
+      idcFourierTransformBatched.calcFourierCoefficients();
+      FtType::setBatchedFFT(false);
+
+      for (unsigned int iSide = 0; iSide < o2::tpc::SIDES; ++iSide) {
+        const o2::tpc::Side side = iSide == 0 ? Side::A : Side::C;
+        const auto& coeff = idcFourierTransform.getFourierCoefficients().getFourierCoefficients(side);
+        const auto& coeffBatched = idcFourierTransformBatched.getFourierCoefficients().getFourierCoefficients(side);
+        BOOST_REQUIRE_EQUAL(coeff.size(), coeffBatched.size());
+        for (size_t i = 0; i < coeff.size(); ++i) {
+          BOOST_CHECK_SMALL(coeff[i] - coeffBatched[i], 1e-5f);
+        }
+      }
+    }
+  }
+}
+
 // testing FT of EPN
 BOOST_AUTO_TEST_CASE(IDCFourierTransformEPN_test)
 {
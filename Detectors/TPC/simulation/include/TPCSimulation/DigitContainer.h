@@ -20,6 +20,7 @@
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
 #include "TPCSimulation/DigitTime.h"
+#include "TPCSimulation/DigitTimeSparse.h"
 #include "TPCBase/ParameterDetector.h"
 #include "TPCBase/ParameterElectronics.h"
 #include "TPCBase/ParameterGas.h"
@@ -77,14 +78,33 @@ class DigitContainer
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
 
   /// Get the size of the container for one event
-  size_t size() const { return mTimeBins.size(); }
+  size_t size() const { return mUseSparse ? mTimeBinsSparse.size() : mTimeBins.size(); }
+
+  /// Switch between the dense and the sparse time bin representation
+  /// The container must be empty, i.e. called before the first digit is added
+  /// \param useSparse true to store only the occupied pads of each time bin
+  void setUseSparse(bool useSparse);
+
+  /// Option to retrieve the time bin representation
+  /// \return true for the sparse representation
+  bool isSparse() const { return mUseSparse; }
+
+  /// Get the number of bytes currently allocated by the time bin containers
+  size_t getAllocatedBytes() const;
 
  private:
-  TimeBin mFirstTimeBin = 0;       ///< First time bin to consider
-  TimeBin mEffectiveTimeBin = 0;   ///< Effective time bin of that digit
-  TimeBin mTmaxTriggered = 0;      ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
-  TimeBin mOffset;                 ///< Size of the container for one event
-  std::deque<DigitTime> mTimeBins; ///< Time bin Container for the ADC value
+  /// Fill output vector for a given time bin representation, see public method for the parameters
+  template <typename TimeBins>
+  int fillOutputContainer(TimeBins& timeBins, std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush);
+
+  TimeBin mFirstTimeBin = 0;                   ///< First time bin to consider
+  TimeBin mEffectiveTimeBin = 0;               ///< Effective time bin of that digit
+  TimeBin mTmaxTriggered = 0;                  ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
+  TimeBin mOffset;                             ///< Size of the container for one event
+  std::deque<DigitTime> mTimeBins;             ///< Time bin Container for the ADC value
+  std::deque<DigitTimeSparse> mTimeBinsSparse; ///< Sparse time bin Container for the ADC value
+  std::vector<DigitTimeSparse> mSparsePool;    ///< Recycled sparse time bins, keeping their pad storage
+  bool mUseSparse = false;                     ///< Switch for the sparse time bin representation
 };
 
 inline DigitContainer::DigitContainer()
@@ -99,6 +119,22 @@ inline DigitContainer::DigitContainer()
   mTimeBins.resize(mOffset);
 }
 
+inline void DigitContainer::setUseSparse(bool useSparse)
+{
+  if (useSparse == mUseSparse) {
+    return;
+  }
+  mUseSparse = useSparse;
+  if (mUseSparse) {
+    std::deque<DigitTime>().swap(mTimeBins);
+    mTimeBinsSparse.resize(mOffset);
+  } else {
+    std::deque<DigitTimeSparse>().swap(mTimeBinsSparse);
+    std::vector<DigitTimeSparse>().swap(mSparsePool);
+    mTimeBins.resize(mOffset);
+  }
+}
+
 inline void DigitContainer::reset()
 {
   mFirstTimeBin = 0;
@@ -106,12 +142,27 @@ inline void DigitContainer::reset()
   for (auto& time : mTimeBins) {
     time.reset();
   }
+  for (auto& time : mTimeBinsSparse) {
+    time.reset();
+  }
 }
 
 inline void DigitContainer::reserve(TimeBin eventTimeBin)
 {
-  if (mTimeBins.size() < mOffset + eventTimeBin - mFirstTimeBin) {
-    mTimeBins.resize(mOffset + eventTimeBin - mFirstTimeBin);
+  const size_t nTimeBins = mOffset + eventTimeBin - mFirstTimeBin;
+  if (!mUseSparse) {
+    if (mTimeBins.size() < nTimeBins) {
+      mTimeBins.resize(nTimeBins);
+    }
+    return;
+  }
+  while (mTimeBinsSparse.size() < nTimeBins) {
+    if (mSparsePool.empty()) {
+      mTimeBinsSparse.emplace_back();
+    } else {
+      mTimeBinsSparse.emplace_back(std::move(mSparsePool.back()));
+      mSparsePool.pop_back();
+    }
   }
 }
 
@@ -119,7 +170,11 @@ inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, T
                                      float signal)
 {
   mEffectiveTimeBin = timeBin - mFirstTimeBin;
-  mTimeBins[mEffectiveTimeBin].addDigit(label, cru, globalPad, signal);
+  if (mUseSparse) {
+    mTimeBinsSparse[mEffectiveTimeBin].addDigit(label, cru, globalPad, signal);
+  } else {
+    mTimeBins[mEffectiveTimeBin].addDigit(label, cru, globalPad, signal);
+  }
 }
 
 } // namespace tpc
@@ -0,0 +1,208 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DigitTimeSparse.h
+/// \brief Definition of the sparse Time Bin container
+
+#ifndef ALICEO2_TPC_DigitTimeSparse_H_
+#define ALICEO2_TPC_DigitTimeSparse_H_
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "TPCBase/Mapper.h"
+#include "TPCSimulation/DigitGlobalPad.h"
+#include "SimulationDataFormat/LabelContainer.h"
+#include "TPCSimulation/CommonMode.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+class Digit;
+
+/// \class DigitTimeSparse
+/// Sparse counterpart of the DigitTime container.
+/// Instead of holding one DigitGlobalPad for every pad of the sector, only the pads which received a signal
+/// in this time bin are stored. The global pad numbers of the occupied pads are kept in insertion order next to
+/// their DigitGlobalPad, the lookup from the global pad number to the storage slot is done via a small open
+/// addressing hash table. The storage is kept on reset(), such that a recycled time bin does not allocate again.
+/// The output is sorted by global pad number and therefore identical to the one of DigitTime.
+
+class DigitTimeSparse
+{
+ public:
+  /// Constructor
+  DigitTimeSparse();
+
+  /// Destructor
+  ~DigitTimeSparse() = default;
+
+  /// Resets the container, the allocated storage is kept
+  void reset();
+
+  /// Get common mode for a given GEM stack
+  /// \param gemstack GEM stack of the digit
+  /// \return Common mode value in that time bin for a given GEM ROC
+  float getCommonMode(const GEMstack& gemstack) const;
+
+  /// Get common mode for a given CRU
+  /// \param CRU CRU of the digit
+  /// \return Common mode value in that time bin for a given CRU
+  float getCommonMode(const CRU& cru) const { return getCommonMode(cru.gemStack()); }
+
+  /// Add digit to the row container
+  /// \param label MC label
+  /// \param cru CRU of the digit
+  /// \param globalPad Global pad number of the digit
+  /// \param signal Charge of the digit in ADC counts
+  void addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal);
+
+  /// Fill output vector
+  /// \param output Output container
+  /// \param mcTruth MC Truth container
+  /// \param commonModeOutput Output container for common mode
+  /// \param cru CRU ID
+  /// \param timeBin Time bin
+  /// \param commonMode Common mode value of that specific ROC
+  template <DigitzationMode MODE>
+  void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
+                           std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin, float commonMode = 0.f);
+
+  /// Get the number of occupied pads
+  size_t getNOccupiedPads() const { return mOccupiedPads.size(); }
+
+  /// Get the number of bytes allocated by the pad storage and the lookup table
+  size_t getAllocatedBytes() const;
+
+ private:
+  static constexpr size_t InitialSlots = 256; ///< initial size of the lookup table, must be a power of 2
+
+  /// Find the storage slot of a global pad, creates a new one if the pad was not yet occupied
+  /// \param globalPad Global pad number
+  /// \return reference to the pad storage
+  DigitGlobalPad& getPad(GlobalPadNumber globalPad);
+
+  /// Double the size of the lookup table and rehash the occupied pads
+  void growLookup();
+
+  std::array<float, GEMSTACKSPERSECTOR> mCommonMode; ///< Common mode container - 4 GEM ROCs per sector
+  std::vector<GlobalPadNumber> mOccupiedPads;        ///< Global pad numbers of the occupied pads, in order of insertion
+  std::vector<DigitGlobalPad> mPads;                 ///< Pad storage for the ADC value, same indexing as mOccupiedPads
+  std::vector<int> mLookup;                          ///< Open addressing hash table global pad -> storage slot, -1 is empty
+  std::vector<int> mSortedSlots;                     ///< Workspace to write out the pads in global pad order
+
+  o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
+};
+
+inline DigitTimeSparse::DigitTimeSparse() : mCommonMode(), mLookup(InitialSlots, -1)
+{
+  mCommonMode.fill(0.f);
+}
+
+inline DigitGlobalPad& DigitTimeSparse::getPad(GlobalPadNumber globalPad)
+{
+  size_t mask = mLookup.size() - 1;
+  size_t slot = (globalPad * 2654435761u) & mask;
+  while (mLookup[slot] != -1) {
+    const int id = mLookup[slot];
+    if (mOccupiedPads[id] == globalPad) {
+      return mPads[id];
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  // this means we have a new digit, keep the load factor of the table below 1/2
+  const int id = static_cast<int>(mOccupiedPads.size());
+  mOccupiedPads.emplace_back(globalPad);
+  auto& paddigit = mPads.emplace_back();
+  paddigit.setID(id);
+  mLookup[slot] = id;
+  if (2 * mOccupiedPads.size() > mLookup.size()) {
+    growLookup();
+  }
+  return paddigit;
+}
+
+inline void DigitTimeSparse::growLookup()
+{
+  mLookup.assign(2 * mLookup.size(), -1);
+  const size_t mask = mLookup.size() - 1;
+  for (size_t id = 0; id < mOccupiedPads.size(); ++id) {
+    size_t slot = (mOccupiedPads[id] * 2654435761u) & mask;
+    while (mLookup[slot] != -1) {
+      slot = (slot + 1) & mask;
+    }
+    mLookup[slot] = static_cast<int>(id);
+  }
+}
+
+inline void DigitTimeSparse::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
+{
+  getPad(globalPad).addDigit(label, signal, mLabels);
+  mCommonMode[cru.gemStack()] += signal;
+}
+
+inline void DigitTimeSparse::reset()
+{
+  std::fill(mLookup.begin(), mLookup.end(), -1);
+  mOccupiedPads.clear();
+  mPads.clear();
+  mLabels.clear();
+  mCommonMode.fill(0.f);
+}
+
+inline float DigitTimeSparse::getCommonMode(const GEMstack& gemstack) const
+{
+  /// simple case when there is no external capacitance on the ROC
+  static const Mapper& mapper = Mapper::instance();
+  const auto nPads = mapper.getNumberOfPads(gemstack);
+  return mCommonMode[gemstack] / static_cast<float>(nPads);
+}
+
+inline size_t DigitTimeSparse::getAllocatedBytes() const
+{
+  return sizeof(DigitTimeSparse) + mOccupiedPads.capacity() * sizeof(GlobalPadNumber) + mPads.capacity() * sizeof(DigitGlobalPad) +
+         mLookup.capacity() * sizeof(int) + mSortedSlots.capacity() * sizeof(int);
+}
+
+template <DigitzationMode MODE>
+inline void DigitTimeSparse::fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
+                                                 std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin,
+                                                 float commonMode)
+{
+  static Mapper& mapper = Mapper::instance();
+  for (size_t i = 0; i < mCommonMode.size(); ++i) {
+    const float cm = getCommonMode(GEMstack(i));
+    if (cm > 0.) {
+      commonModeOutput.push_back({cm, timeBin, static_cast<unsigned char>(i)});
+    }
+  }
+
+  // write out in ascending global pad order, as done by the dense container
+  mSortedSlots.resize(mOccupiedPads.size());
+  std::iota(mSortedSlots.begin(), mSortedSlots.end(), 0);
+  std::sort(mSortedSlots.begin(), mSortedSlots.end(), [this](int a, int b) { return mOccupiedPads[a] < mOccupiedPads[b]; });
+  for (const auto id : mSortedSlots) {
+    auto& pad = mPads[id];
+    if (pad.getChargePad() > 0.) {
+      const GlobalPadNumber globalPad = mOccupiedPads[id];
+      const CRU cru = mapper.getCRU(sector, globalPad);
+      pad.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, globalPad, mLabels, getCommonMode(cru));
+    }
+  }
+}
+} // namespace tpc
+} // namespace o2
+
+#endif // ALICEO2_TPC_DigitTimeSparse_H_
@@ -17,12 +17,17 @@
 #define ALICEO2_TPC_Digitizer_H_
 
 #include "TPCSimulation/DigitContainer.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
 #include "TPCSimulation/Point.h"
+#include "TPCSimulation/SAMPAProcessing.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
 
 #include "TPCBase/Mapper.h"
 
+#include <array>
 #include <cmath>
+#include <memory>
 
 using std::vector;
 
@@ -48,6 +53,10 @@ class DigitContainer;
 /// The such created Digits and then sorted in an intermediate Container (DigitContainer) and after processing of the
 /// full event/drift time summed up
 /// and sorted as Digits into a vector which is then passed further on
+/// Each Digitizer draws its own random streams from the rings of ElectronTransport, GEMAmplification and
+/// SAMPAProcessing, with one set of streams per sector starting at a sector dependent position in the rings.
+/// Several Digitizers (e.g. one per sector) can be run concurrently in different threads once the parameters
+/// of these classes are updated, i.e. init() must not be called concurrently
 
 class Digitizer
 {
@@ -55,7 +64,7 @@ class Digitizer
   using SC = SpaceCharge<double>;
 
   /// Default constructor
-  Digitizer() = default;
+  Digitizer();
 
   /// Destructor
   ~Digitizer() = default;
@@ -63,7 +72,7 @@ class Digitizer
   Digitizer(const Digitizer&) = delete;
   Digitizer& operator=(const Digitizer&) = delete;
 
-  /// Initializer
+  /// Initializer, updates the parameters of the shared ElectronTransport, GEMAmplification and SAMPAProcessing
   void init();
 
   /// Process a single hit group
@@ -90,7 +99,7 @@ class Digitizer
     mDigitContainer.reset();
   }
 
-  /// Set the start time of the first event
+  /// Set the start time of the first event, the SAMPA parameters must be updated beforehand by init()
   /// \param time Time of the first event
   void setStartTime(double time);
 
@@ -109,6 +118,10 @@ class Digitizer
   /// \return true for continuous readout
   bool isContinuousReadout() { return mIsContinuous; }
 
+  /// Switch for the sparse time bin representation of the digit container
+  /// \param useSparse true to store only the occupied pads of each time bin
+  void setUseSparseDigitContainer(bool useSparse) { mDigitContainer.setUseSparse(useSparse); }
+
   /// Enable the use of space-charge distortions and provide space-charge density histogram as input
   /// \param distortionType select the type of space-charge distortions (constant or realistic)
   /// \param hisInitialSCDensity optional space-charge density histogram to use at the beginning of the simulation
@@ -125,15 +138,31 @@ class Digitizer
   /// \param TFile file containing distortions and corrections
   void setUseSCDistortions(TFile& finp);
 
+  /// Use the space-charge distortions of another Digitizer, the SpaceCharge object is shared and not copied
+  /// \param other Digitizer owning the space-charge distortions
+  void setUseSCDistortions(const Digitizer& other)
+  {
+    mUseSCDistortions = other.mUseSCDistortions;
+    mSpaceCharge = other.mSpaceCharge;
+  }
+
  private:
+  /// Positions of this Digitizer in the random rings for one sector
+  struct RandomStreams {
+    ElectronTransport::RandomStream electronTransport; ///< Random stream for the electron transport
+    GEMAmplification::RandomStream gemAmplification;   ///< Random stream for the GEM amplification
+    SAMPAProcessing::RandomStream sampaProcessing;     ///< Random stream for the noise
+  };
+
   DigitContainer mDigitContainer;    ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;  ///< Handler of space-charge distortions
+  std::shared_ptr<SC> mSpaceCharge;  //!< Handler of space-charge distortions, can be shared among Digitizers
+  std::array<RandomStreams, Sector::MAXSECTOR> mRandomStreams; //!< Positions in the random rings per sector
   Sector mSector = -1;               ///< ID of the currently processed sector
   double mEventTime = 0.f;           ///< Time of the currently processed event
   double mOutputDigitTimeOffset = 0; ///< Time of the first IR sampled in the digitizer
   bool mIsContinuous;                ///< Switch for continuous readout
   bool mUseSCDistortions = false; ///< Flag to switch on the use of space-charge distortions
-  ClassDefNV(Digitizer, 1);
+  ClassDefNV(Digitizer, 2);
 };
 } // namespace tpc
 } // namespace o2
@@ -44,6 +44,16 @@ class ElectronTransport
   /// Destructor
   ~ElectronTransport() = default;
 
+  /// Positions in the random rings of the class
+  struct RandomStream {
+    size_t gaus = 0; ///< Position in the Gaussian ring
+    size_t flat = 0; ///< Position in the flat ring
+  };
+
+  /// Set the random stream used by the calling thread
+  /// \param stream Random stream, nullptr to use the default stream of the class
+  static void setThreadRandomStream(RandomStream* stream) { threadRandomStream() = stream; }
+
   /// Update the OCDB parameters cached in the class. To be called once per event
   void updateParameters();
 
@@ -74,11 +84,23 @@ class ElectronTransport
  private:
   ElectronTransport();
 
+  /// Random stream set for the calling thread
+  static RandomStream*& threadRandomStream();
+
+  /// Random stream to be used by the calling thread
+  RandomStream& getRandomStream()
+  {
+    auto stream = threadRandomStream();
+    return stream ? *stream : mRandomStream;
+  }
+
   /// Circular random buffer containing random values of the Gauss distribution to take into account diffusion of the
   /// electrons
   math_utils::RandomRing<> mRandomGaus;
   /// Circular random buffer containing flat random values to take into account electron attachment during drift
   math_utils::RandomRing<> mRandomFlat;
+  /// Default random stream, used if no stream is set for the calling thread
+  RandomStream mRandomStream;
 
   const ParameterDetector* mDetParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam;      ///< Caching of the parameter class to avoid multiple CDB calls
@@ -86,7 +108,7 @@ class ElectronTransport
 
 inline bool ElectronTransport::isElectronAttachment(float driftTime)
 {
-  if (mRandomFlat.getNextValue() < mGasParam->AttCoeff * mGasParam->OxygenCont * driftTime) {
+  if (mRandomFlat.getNextValue(getRandomStream().flat) < mGasParam->AttCoeff * mGasParam->OxygenCont * driftTime) {
     return true; /// electron is attached and lost
   } else {
     return false; /// not attached
@@ -46,6 +46,18 @@ class GEMAmplification
   /// Destructor
   ~GEMAmplification() = default;
 
+  /// Positions in the random rings of the class
+  struct RandomStream {
+    size_t gaus = 0;              ///< Position in the Gaussian ring
+    size_t flat = 0;              ///< Position in the flat ring
+    std::array<size_t, 4> gain{}; ///< Positions in the Polya rings of the individual GEMs
+    size_t gainFullStack = 0;     ///< Position in the Polya ring of the full stack
+  };
+
+  /// Set the random stream used by the calling thread
+  /// \param stream Random stream, nullptr to use the default stream of the class
+  static void setThreadRandomStream(RandomStream* stream) { threadRandomStream() = stream; }
+
   /// Update the OCDB parameters cached in the class. To be called once per event
   void updateParameters();
 
@@ -92,6 +104,16 @@ class GEMAmplification
  private:
   GEMAmplification();
 
+  /// Random stream set for the calling thread
+  static RandomStream*& threadRandomStream();
+
+  /// Random stream to be used by the calling thread
+  RandomStream& getRandomStream()
+  {
+    auto stream = threadRandomStream();
+    return stream ? *stream : mRandomStream;
+  }
+
   /// Circular random buffer containing random Gaus values for gain fluctuation if the number of electrons is larger
   /// (central limit theorem)
   math_utils::RandomRing<> mRandomGaus;
@@ -101,6 +123,8 @@ class GEMAmplification
   std::array<math_utils::RandomRing<>, 4> mGain;
   /// Container with random Polya distributions for the full stack amplification
   math_utils::RandomRing<> mGainFullStack;
+  /// Default random stream, used if no stream is set for the calling thread
+  RandomStream mRandomStream;
 
   const ParameterGEM* mGEMParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam; ///< Caching of the parameter class to avoid multiple CDB calls
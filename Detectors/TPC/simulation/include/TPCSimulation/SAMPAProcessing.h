@@ -45,6 +45,15 @@ class SAMPAProcessing
     static SAMPAProcessing sampaProcessing;
     return sampaProcessing;
   }
+
+  /// Positions in the random rings of the class
+  struct RandomStream {
+    size_t noise = 0; ///< Position in the noise ring
+  };
+
+  /// Set the random stream used by the calling thread
+  /// \param stream Random stream, nullptr to use the default stream of the class
+  static void setThreadRandomStream(RandomStream* stream) { threadRandomStream() = stream; }
   /// Destructor
   ~SAMPAProcessing() = default;
 
@@ -130,6 +139,16 @@ class SAMPAProcessing
  private:
   SAMPAProcessing();
 
+  /// Random stream set for the calling thread
+  static RandomStream*& threadRandomStream();
+
+  /// Random stream to be used by the calling thread
+  RandomStream& getRandomStream()
+  {
+    auto stream = threadRandomStream();
+    return stream ? *stream : mRandomStream;
+  }
+
   const ParameterGas* mGasParam;             ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterDetector* mDetParam;        ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterElectronics* mEleParam;     ///< Caching of the parameter class to avoid multiple CDB calls
@@ -137,6 +156,7 @@ class SAMPAProcessing
   const CalPad* mPedestalMap;                ///< Caching of the parameter class to avoid multiple CDB calls
   const CalPad* mZeroSuppression;            ///< Caching of the parameter class to avoid multiple CDB calls
   math_utils::RandomRing<> mRandomNoiseRing; ///< Ring with random number for noise
+  RandomStream mRandomStream;                ///< Default random stream, used if no stream is set for the calling thread
 };
 
 template <typename T>
@@ -252,7 +272,7 @@ inline float SAMPAProcessing::getTimeBinTime(float time) const
 
 inline float SAMPAProcessing::getNoise(const int sector, const int globalPadInSector)
 {
-  return mRandomNoiseRing.getNextValue() * mNoiseMap->getValue(sector, globalPadInSector);
+  return mRandomNoiseRing.getNextValue(getRandomStream().noise) * mNoiseMap->getValue(sector, globalPadInSector);
 }
 
 inline float SAMPAProcessing::getZeroSuppression(const int sector, const int globalPadInSector) const
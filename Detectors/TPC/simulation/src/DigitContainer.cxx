@@ -23,12 +23,35 @@ using namespace o2::tpc;
 
 void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
                                          dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush)
+{
+  if (!mUseSparse) {
+    int nProcessedTimeBins = fillOutputContainer(mTimeBins, output, mcTruth, commonModeOutput, sector, eventTimeBin, isContinuous, finalFlush);
+    mFirstTimeBin += nProcessedTimeBins;
+    while (nProcessedTimeBins--) {
+      mTimeBins.pop_front();
+    }
+    return;
+  }
+
+  int nProcessedTimeBins = fillOutputContainer(mTimeBinsSparse, output, mcTruth, commonModeOutput, sector, eventTimeBin, isContinuous, finalFlush);
+  mFirstTimeBin += nProcessedTimeBins;
+  while (nProcessedTimeBins--) {
+    /// keep the pad storage of the processed time bins for the upcoming ones
+    auto& time = mTimeBinsSparse.front();
+    time.reset();
+    mSparsePool.emplace_back(std::move(time));
+    mTimeBinsSparse.pop_front();
+  }
+}
+
+template <typename TimeBins>
+int DigitContainer::fillOutputContainer(TimeBins& timeBins, std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush)
 {
   auto& eleParam = ParameterElectronics::Instance();
   const auto digitizationMode = eleParam.DigiMode;
   int nProcessedTimeBins = 0;
   TimeBin timeBin = (isContinuous) ? mFirstTimeBin : 0;
-  for (auto& time : mTimeBins) {
+  for (auto& time : timeBins) {
     /// the time bins between the last event and the timing of this event are uncorrelated and can be written out
     /// OR the readout is triggered (i.e. not continuous) and we can dump everything in any case, as long it is within one drift time interval
     if ((nProcessedTimeBins + mFirstTimeBin < eventTimeBin) || !isContinuous || finalFlush) {
@@ -64,10 +87,17 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     }
     timeBin++;
   }
-  if (nProcessedTimeBins > 0) {
-    mFirstTimeBin += nProcessedTimeBins;
-    while (nProcessedTimeBins--) {
-      mTimeBins.pop_front();
-    }
+  return nProcessedTimeBins;
+}
+
+size_t DigitContainer::getAllocatedBytes() const
+{
+  size_t bytes = mTimeBins.size() * sizeof(DigitTime);
+  for (const auto& time : mTimeBinsSparse) {
+    bytes += time.getAllocatedBytes();
+  }
+  for (const auto& time : mSparsePool) {
+    bytes += time.getAllocatedBytes();
   }
+  return bytes;
 }
@@ -34,6 +34,47 @@ ClassImp(o2::tpc::Digitizer);
 
 using namespace o2::tpc;
 
+namespace
+{
+/// Selects the random streams of a Digitizer for the calling thread as long as it is in scope
+class RandomStreamScope
+{
+ public:
+  RandomStreamScope(ElectronTransport::RandomStream& electronTransport, GEMAmplification::RandomStream& gemAmplification,
+                    SAMPAProcessing::RandomStream& sampaProcessing)
+  {
+    ElectronTransport::setThreadRandomStream(&electronTransport);
+    GEMAmplification::setThreadRandomStream(&gemAmplification);
+    SAMPAProcessing::setThreadRandomStream(&sampaProcessing);
+  }
+
+  ~RandomStreamScope()
+  {
+    ElectronTransport::setThreadRandomStream(nullptr);
+    GEMAmplification::setThreadRandomStream(nullptr);
+    SAMPAProcessing::setThreadRandomStream(nullptr);
+  }
+};
+} // namespace
+
+Digitizer::Digitizer()
+{
+  // each sector starts at a different position in the shared random rings, such that the sectors do not draw
+  // the same random sequences, independent of which Digitizer (and thread) they are processed with
+  constexpr size_t ringSpacing = o2::math_utils::RandomRing<>::getSize() / Sector::MAXSECTOR;
+  for (int sector = 0; sector < Sector::MAXSECTOR; ++sector) {
+    const size_t position = sector * ringSpacing;
+    auto& streams = mRandomStreams[sector];
+    streams.electronTransport.gaus = position;
+    streams.electronTransport.flat = position;
+    streams.gemAmplification.gaus = position;
+    streams.gemAmplification.flat = position;
+    streams.gemAmplification.gain.fill(position);
+    streams.gemAmplification.gainFullStack = position;
+    streams.sampaProcessing.noise = position;
+  }
+}
+
 void Digitizer::init()
 {
   // Calculate distortion lookup tables if initial space-charge density is provided
@@ -62,9 +103,12 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
 
+  auto& streams = mRandomStreams[mSector];
+  const RandomStreamScope randomStreams(streams.electronTransport, streams.gemAmplification, streams.sampaProcessing);
+
   /// Reserve space in the digit container for the current event
   mDigitContainer.reserve(sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset));
 
@@ -162,6 +206,8 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
                       bool finalFlush)
 {
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
+  auto& streams = mRandomStreams[mSector];
+  const RandomStreamScope randomStreams(streams.electronTransport, streams.gemAmplification, streams.sampaProcessing);
   mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset), mIsContinuous, finalFlush);
 }
 
@@ -198,7 +244,7 @@ void Digitizer::setUseSCDistortions(TFile& finp)
 
 void Digitizer::setStartTime(double time)
 {
+  // the parameters of SAMPAProcessing are updated in init(), such that the start time can be set concurrently
   static SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
-  sampaProcessing.updateParameters();
   mDigitContainer.setStartTime(sampaProcessing.getTimeBinFromTime(time - mOutputDigitTimeOffset));
 }
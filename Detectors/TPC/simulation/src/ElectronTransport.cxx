@@ -26,6 +26,12 @@ ElectronTransport::ElectronTransport() : mRandomGaus(), mRandomFlat(RandomRing<>
   updateParameters();
 }
 
+ElectronTransport::RandomStream*& ElectronTransport::threadRandomStream()
+{
+  static thread_local RandomStream* stream = nullptr;
+  return stream;
+}
+
 void ElectronTransport::updateParameters()
 {
   mGasParam = &(ParameterGas::Instance());
@@ -45,9 +51,10 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
 
   /// The position is smeared by a Gaussian with mean around the actual position and a width according to the diffusion
   /// coefficient times sqrt(drift length)
-  GlobalPosition3D posEleDiffusion((mRandomGaus.getNextValue() * sigT) + posEle.X(),
-                                   (mRandomGaus.getNextValue() * sigT) + posEle.Y(),
-                                   (mRandomGaus.getNextValue() * sigL) + posEle.Z());
+  auto& stream = getRandomStream();
+  GlobalPosition3D posEleDiffusion((mRandomGaus.getNextValue(stream.gaus) * sigT) + posEle.X(),
+                                   (mRandomGaus.getNextValue(stream.gaus) * sigT) + posEle.Y(),
+                                   (mRandomGaus.getNextValue(stream.gaus) * sigL) + posEle.Z());
 
   /// If there is a sign change in the z position, the hit has changed sides
   /// This is not possible, but rather just an elongation of the drift time.
@@ -102,6 +102,12 @@ GEMAmplification::GEMAmplification()
   LOG(info) << "TPC: GEM setup (polya) took " << watch.CpuTime();
 }
 
+GEMAmplification::RandomStream*& GEMAmplification::threadRandomStream()
+{
+  static thread_local RandomStream* stream = nullptr;
+  return stream;
+}
+
 void GEMAmplification::updateParameters()
 {
   auto& cdb = CDBInterface::instance();
@@ -127,12 +133,13 @@ int GEMAmplification::getEffectiveStackAmplification(int nElectrons)
   /// We start with an arbitrary number of electrons given to the first amplification stage
   /// The amplification in the GEM stack is handled for each electron individually and the amplification
   /// in the stack is handled in an effective manner
+  auto& stream = getRandomStream();
   int nElectronsGEM = 0;
   for (int i = 0; i < nElectrons; ++i) {
-    if (mRandomFlat.getNextValue() > mGEMParam->EfficiencyStack) {
+    if (mRandomFlat.getNextValue(stream.flat) > mGEMParam->EfficiencyStack) {
       continue;
     }
-    nElectronsGEM += mGainFullStack.getNextValue();
+    nElectronsGEM += mGainFullStack.getNextValue(stream.gainFullStack);
   }
   return nElectronsGEM;
 }
@@ -163,16 +170,17 @@ int GEMAmplification::getGEMMultiplication(int nElectrons, int GEM)
     /// For this condition the central limit theorem holds and we can approximate the amplification fluctuations by
     /// a Gaussian for all electrons
     /// The mean is given by nElectrons * G_abs and the width by sqrt(nElectrons) * Sigma/Mu (Polya) * G_abs
-    return ((mRandomGaus.getNextValue() * std::sqrt(static_cast<float>(nElectrons)) *
+    return ((mRandomGaus.getNextValue(getRandomStream().gaus) * std::sqrt(static_cast<float>(nElectrons)) *
              mGasParam->SigmaOverMu) +
             nElectrons) *
            mGEMParam->AbsoluteGain[GEM];
   } else {
     /// Otherwise we compute the gain fluctuations as the convolution of many single electron amplification
     /// fluctuations
+    auto& position = getRandomStream().gain[GEM];
     int electronsOut = 0;
     for (int i = 0; i < nElectrons; ++i) {
-      electronsOut += mGain[GEM].getNextValue();
+      electronsOut += mGain[GEM].getNextValue(position);
     }
     return electronsOut;
   }
@@ -191,13 +199,14 @@ int GEMAmplification::getElectronLosses(int nElectrons, float probability)
   } else if (electronsFloat * probability >= 5.f && electronsFloat * (1.f - probability) >= 5.f) {
     /// Condition whether the binomial distribution can be approximated by a Gaussian with mean n*p+0.5 and
     /// width sqrt(n*p*(1-p))
-    return (mRandomGaus.getNextValue() * std::sqrt(electronsFloat * probability * (1 - probability))) +
+    return (mRandomGaus.getNextValue(getRandomStream().gaus) * std::sqrt(electronsFloat * probability * (1 - probability))) +
            electronsFloat * probability + 0.5;
   } else {
     /// Explicit handling of the probability for each individual electron
+    auto& position = getRandomStream().flat;
     int nElectronsOut = 0;
     for (int i = 0; i < nElectrons; ++i) {
-      if (mRandomFlat.getNextValue() < probability) {
+      if (mRandomFlat.getNextValue(position) < probability) {
         ++nElectronsOut;
       }
     }
@@ -29,6 +29,12 @@ SAMPAProcessing::SAMPAProcessing() : mRandomNoiseRing()
   updateParameters();
 }
 
+SAMPAProcessing::RandomStream*& SAMPAProcessing::threadRandomStream()
+{
+  static thread_local RandomStream* stream = nullptr;
+  return stream;
+}
+
 void SAMPAProcessing::updateParameters()
 {
   mGasParam = &(ParameterGas::Instance());
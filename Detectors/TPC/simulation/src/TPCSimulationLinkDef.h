@@ -23,6 +23,7 @@
 #pragma link C++ class o2::tpc::DigitGlobalPad + ;
 #pragma link C++ class o2::tpc::Digitizer + ;
 #pragma link C++ class o2::tpc::DigitTime + ;
+#pragma link C++ class o2::tpc::DigitTimeSparse + ;
 #pragma link C++ class o2::tpc::ElectronTransport + ;
 #pragma link C++ class o2::tpc::GEMAmplification + ;
 #pragma link C++ class o2::tpc::Point + ;
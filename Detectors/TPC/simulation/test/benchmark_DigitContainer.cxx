@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_DigitContainer.cxx
+/// \brief Benchmark of the dense and the sparse time bin representation of the TPC DigitContainer
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "DataFormatsTPC/Digit.h"
+#include "TPCBase/CDBInterface.h"
+#include "TPCSimulation/DigitContainer.h"
+#include "CommonUtils/ConfigurableParam.h"
+
+using namespace o2::tpc;
+
+namespace
+{
+constexpr int NEvents = 20;            // number of events, each starting 100 time bins after the previous one
+constexpr int NTimeBinsPerEvent = 100; // spacing of the events in time bins
+constexpr int NTimeBinsDrift = 500;    // time bins over which the signals of one event are spread
+
+struct Signal {
+  GlobalPadNumber pad;
+  CRU cru;
+  TimeBin time;
+  o2::MCCompLabel label;
+  float charge;
+};
+
+/// generate signals for one sector at a given pad occupancy, given in per mille
+std::vector<std::vector<Signal>> generateSignals(int occupancyPerMille)
+{
+  const Mapper& mapper = Mapper::instance();
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> padDist(0, Mapper::getPadsInSector() - 1);
+  std::uniform_int_distribution<int> timeDist(0, NTimeBinsDrift - 1);
+  std::uniform_real_distribution<float> chargeDist(1.f, 100.f);
+  const size_t nSignalsPerEvent = size_t(Mapper::getPadsInSector()) * NTimeBinsPerEvent * occupancyPerMille / 1000;
+
+  std::vector<std::vector<Signal>> events(NEvents);
+  for (int iEvent = 0; iEvent < NEvents; ++iEvent) {
+    auto& signals = events[iEvent];
+    signals.reserve(nSignalsPerEvent);
+    for (size_t i = 0; i < nSignalsPerEvent; ++i) {
+      const GlobalPadNumber pad = padDist(gen);
+      signals.push_back({pad, mapper.getCRU(Sector(0), pad), TimeBin(iEvent * NTimeBinsPerEvent + timeDist(gen)), o2::MCCompLabel(int(i % 1000), iEvent, 0, false), chargeDist(gen)});
+    }
+  }
+  return events;
+}
+} // namespace
+
+static void BM_DigitContainer(benchmark::State& state)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString(fmt::format("TPCEleParam.DigiMode={}", (int)DigitzationMode::PropagateADC));
+
+  const bool useSparse = state.range(0);
+  const auto events = generateSignals(state.range(1));
+  size_t maxBytes = 0;
+  size_t nDigits = 0;
+
+  for (auto _ : state) {
+    DigitContainer container;
+    container.setUseSparse(useSparse);
+    container.reset();
+    std::vector<Digit> digits;
+    std::vector<CommonMode> commonMode;
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+
+    for (int iEvent = 0; iEvent < NEvents; ++iEvent) {
+      const TimeBin eventTime = iEvent * NTimeBinsPerEvent;
+      container.reserve(eventTime);
+      for (const auto& signal : events[iEvent]) {
+        container.addDigit(signal.label, signal.cru, signal.time, signal.pad, signal.charge);
+      }
+      maxBytes = std::max(maxBytes, container.getAllocatedBytes());
+      container.fillOutputContainer(digits, labels, commonMode, Sector(0), eventTime + NTimeBinsPerEvent);
+    }
+    container.fillOutputContainer(digits, labels, commonMode, Sector(0), 0, true, true);
+    nDigits = digits.size();
+    benchmark::DoNotOptimize(digits);
+  }
+
+  state.counters["bytes"] = maxBytes;
+  state.counters["digits"] = nDigits;
+}
+
+// arguments: sparse representation, occupancy in per mille
+static void CustomArguments(benchmark::internal::Benchmark* bench)
+{
+  for (int occupancy : {5, 20, 50, 200}) {
+    for (int sparse = 0; sparse < 2; ++sparse) {
+      bench->Args({sparse, occupancy});
+    }
+  }
+}
+
+BENCHMARK(BM_DigitContainer)->Apply(CustomArguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -18,6 +18,7 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 #include <memory>
+#include <random>
 #include <vector>
 #include <fmt/format.h>
 #include "DataFormatsTPC/Digit.h"
@@ -167,5 +168,65 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the sparse DigitContainer
+/// The same random signals are filled into a dense and a sparse DigitContainer and we check that the digits,
+/// MC labels and common mode values are identical
+BOOST_AUTO_TEST_CASE(DigitContainer_sparse)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString(fmt::format("TPCEleParam.DigiMode={}", (int)o2::tpc::DigitzationMode::PropagateADC));
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer dense;
+  DigitContainer sparse;
+  sparse.setUseSparse(true);
+  BOOST_CHECK(sparse.isSparse());
+  dense.reset();
+  sparse.reset();
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> padDist(0, Mapper::getPadsInSector() - 1);
+  std::uniform_int_distribution<int> timeDist(0, 400);
+  std::uniform_int_distribution<int> labelDist(0, 20);
+  std::uniform_real_distribution<float> signalDist(1.f, 100.f);
+
+  for (int i = 0; i < 50000; ++i) {
+    const GlobalPadNumber globalPad = padDist(gen);
+    const CRU cru = mapper.getCRU(Sector(0), globalPad);
+    const TimeBin time = timeDist(gen);
+    const MCCompLabel label(labelDist(gen), labelDist(gen), 0, false);
+    const float signal = signalDist(gen);
+    dense.addDigit(label, cru, time, globalPad, signal);
+    sparse.addDigit(label, cru, time, globalPad, signal);
+  }
+  BOOST_CHECK(sparse.getAllocatedBytes() < dense.getAllocatedBytes());
+
+  std::vector<Digit> digitsDense, digitsSparse;
+  std::vector<CommonMode> commonModeDense, commonModeSparse;
+  dataformats::MCTruthContainer<MCCompLabel> mcDense, mcSparse;
+  dense.fillOutputContainer(digitsDense, mcDense, commonModeDense, 0, 0, true, true);
+  sparse.fillOutputContainer(digitsSparse, mcSparse, commonModeSparse, 0, 0, true, true);
+
+  BOOST_REQUIRE(digitsDense.size() == digitsSparse.size());
+  for (size_t i = 0; i < digitsDense.size(); ++i) {
+    BOOST_CHECK(digitsDense[i].getCRU() == digitsSparse[i].getCRU());
+    BOOST_CHECK(digitsDense[i].getRow() == digitsSparse[i].getRow());
+    BOOST_CHECK(digitsDense[i].getPad() == digitsSparse[i].getPad());
+    BOOST_CHECK(digitsDense[i].getTimeStamp() == digitsSparse[i].getTimeStamp());
+    BOOST_CHECK(digitsDense[i].getChargeFloat() == digitsSparse[i].getChargeFloat());
+    const auto labelsDense = mcDense.getLabels(i);
+    const auto labelsSparse = mcSparse.getLabels(i);
+    BOOST_REQUIRE(labelsDense.size() == labelsSparse.size());
+    for (size_t j = 0; j < labelsDense.size(); ++j) {
+      BOOST_CHECK(labelsDense[j] == labelsSparse[j]);
+    }
+  }
+
+  BOOST_REQUIRE(commonModeDense.size() == commonModeSparse.size());
+  for (size_t i = 0; i < commonModeDense.size(); ++i) {
+    BOOST_CHECK(commonModeDense[i].getCommonMode() == commonModeSparse[i].getCommonMode());
+  }
+}
 } // namespace tpc
 } // namespace o2
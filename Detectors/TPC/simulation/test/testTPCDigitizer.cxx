@@ -0,0 +1,170 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCDigitizer.cxx
+/// \brief This task tests the concurrent digitization of several sectors with the Digitizer
+
+#define BOOST_TEST_MODULE Test TPC Digitizer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "DataFormatsTPC/Digit.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/Point.h"
+#include "TPCBase/CDBInterface.h"
+#include "TPCBase/Sector.h"
+
+namespace o2
+{
+namespace tpc
+{
+
+constexpr int NEVENTS = 2;     ///< events per sector and timeframe
+constexpr int NTIMEFRAMES = 2; ///< number of processed timeframes
+constexpr int NTRACKS = 20;    ///< tracks per event
+constexpr size_t NSECTORS = 4; ///< number of processed sectors
+
+/// hits of the events of one sector
+/// The same sector-local hits are rotated into each sector, such that all sectors see the same pads and
+/// differences between the sectors only come from the random numbers
+std::vector<std::vector<HitGroup>> createHits(const Sector sector)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> radius(100.f, 230.f);
+  std::uniform_real_distribution<float> localY(-0.8f, 0.8f);
+  std::uniform_real_distribution<float> length(20.f, 230.f);
+  const double phi = sector.phi();
+  const float zSign = sector.side() == Side::A ? 1.f : -1.f;
+
+  std::vector<std::vector<HitGroup>> events(NEVENTS);
+  for (auto& event : events) {
+    for (int itrack = 0; itrack < NTRACKS; ++itrack) {
+      auto& hitGroup = event.emplace_back(itrack);
+      const float yFraction = localY(generator);
+      const float z = length(generator);
+      for (int ihit = 0; ihit < 10; ++ihit) {
+        const float lx = radius(generator);
+        const float ly = yFraction * lx * std::tan(10.f * M_PI / 180.f);
+        const float x = lx * std::cos(phi) - ly * std::sin(phi);
+        const float y = lx * std::sin(phi) + ly * std::cos(phi);
+        hitGroup.addHit(x, y, zSign * z, 0.f, 50);
+      }
+    }
+  }
+  return events;
+}
+
+/// digitize the events of one sector like the TPC digitizer workflow in triggered mode
+std::vector<Digit> digitizeSector(Digitizer& digitizer, const Sector sector, const std::vector<std::vector<HitGroup>>& events)
+{
+  std::vector<Digit> digits;
+  digitizer.setSector(sector);
+  for (int ievent = 0; ievent < NEVENTS; ++ievent) {
+    const double eventTime = ievent * 1000.;
+    digitizer.setEventTime(eventTime);
+    digitizer.setStartTime(eventTime);
+    digitizer.process(events[ievent], ievent, 0);
+    std::vector<Digit> eventDigits;
+    dataformats::MCTruthContainer<MCCompLabel> labels;
+    std::vector<CommonMode> commonMode;
+    digitizer.flush(eventDigits, labels, commonMode, false);
+    digits.insert(digits.end(), eventDigits.begin(), eventDigits.end());
+  }
+  return digits;
+}
+
+void checkEqual(const std::vector<Digit>& serial, const std::vector<Digit>& parallel)
+{
+  BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+  for (size_t idigit = 0; idigit < serial.size(); ++idigit) {
+    BOOST_CHECK_EQUAL(serial[idigit].getCRU(), parallel[idigit].getCRU());
+    BOOST_CHECK_EQUAL(serial[idigit].getRow(), parallel[idigit].getRow());
+    BOOST_CHECK_EQUAL(serial[idigit].getPad(), parallel[idigit].getPad());
+    BOOST_CHECK_EQUAL(serial[idigit].getTimeStamp(), parallel[idigit].getTimeStamp());
+    BOOST_CHECK_EQUAL(serial[idigit].getChargeFloat(), parallel[idigit].getChargeFloat());
+  }
+}
+
+/// \brief Test of the concurrent digitization of several sectors
+/// The sectors are digitized one after the other with one Digitizer (as a single lane of the digitizer workflow)
+/// and concurrently with one Digitizer per sector and thread (as the multi-threaded digitizer workflow).
+/// The digits of each sector must be identical, and sectors with the same hits must not get the same digits
+BOOST_AUTO_TEST_CASE(Digitizer_SerialParallel_test)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+
+  const std::array<Sector, NSECTORS> sectors{0, 5, 11, 17};
+  std::array<std::vector<std::vector<HitGroup>>, NSECTORS> hits;
+  for (size_t isector = 0; isector < NSECTORS; ++isector) {
+    hits[isector] = createHits(sectors[isector]);
+  }
+
+  // serial processing with a single digitizer
+  std::array<std::array<std::vector<Digit>, NSECTORS>, NTIMEFRAMES> serialDigits;
+  Digitizer serialDigitizer;
+  serialDigitizer.setContinuousReadout(false);
+  serialDigitizer.init();
+  for (int itf = 0; itf < NTIMEFRAMES; ++itf) {
+    for (size_t isector = 0; isector < NSECTORS; ++isector) {
+      serialDigits[itf][isector] = digitizeSector(serialDigitizer, sectors[isector], hits[isector]);
+    }
+  }
+
+  // concurrent processing with one digitizer per sector, the parameters are updated once beforehand
+  std::array<std::array<std::vector<Digit>, NSECTORS>, NTIMEFRAMES> parallelDigits;
+  std::array<std::unique_ptr<Digitizer>, NSECTORS> sectorDigitizers;
+  for (auto& digitizer : sectorDigitizers) {
+    digitizer = std::make_unique<Digitizer>();
+    digitizer->setContinuousReadout(false);
+  }
+  sectorDigitizers[0]->init();
+  for (int itf = 0; itf < NTIMEFRAMES; ++itf) {
+    std::vector<std::thread> threads;
+    for (size_t isector = 0; isector < NSECTORS; ++isector) {
+      threads.emplace_back([&, itf, isector]() {
+        parallelDigits[itf][isector] = digitizeSector(*sectorDigitizers[isector], sectors[isector], hits[isector]);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (int itf = 0; itf < NTIMEFRAMES; ++itf) {
+    for (size_t isector = 0; isector < NSECTORS; ++isector) {
+      BOOST_CHECK(serialDigits[itf][isector].size() > 0);
+      checkEqual(serialDigits[itf][isector], parallelDigits[itf][isector]);
+    }
+  }
+
+  // the sectors draw different random numbers
+  for (size_t isector = 1; isector < NSECTORS; ++isector) {
+    const auto& first = serialDigits[0][0];
+    const auto& other = serialDigits[0][isector];
+    bool identical = first.size() == other.size();
+    for (size_t idigit = 0; identical && idigit < first.size(); ++idigit) {
+      identical = first[idigit].getChargeFloat() == other[idigit].getChargeFloat();
+    }
+    BOOST_CHECK(!identical);
+  }
+}
+
+} // namespace tpc
+} // namespace o2
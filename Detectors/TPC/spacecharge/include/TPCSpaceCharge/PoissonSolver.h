@@ -86,10 +86,12 @@ class PoissonSolver
 
   static DataT getConvergenceError() { return sConvergenceError; }
 
-  /// get the number of threads used for some of the calculations
+  /// get the number of threads used for the multi grid calculations
   static int getNThreads() { return sNThreads; }
 
-  /// set the number of threads used for some of the calculations
+  /// set the number of threads used for the multi grid calculations.
+  /// The red-black relaxation, the residue and the grid transfer operators are parallelised over phi slices,
+  /// the result does not depend on the number of threads
   static void setNThreads(int nThreads) { sNThreads = nThreads; }
 
  private:
@@ -97,7 +99,7 @@ class PoissonSolver
   const RegularGrid& mGrid3D{};                                      ///< grid properties
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{4};                                    ///< number of threads which are used during the multi grid calculations
 
   /// Relative error calculation: comparison with exact solution
   ///
@@ -235,6 +237,24 @@ class PoissonSolver
   void relax3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2, const DataT tempRatioZ,
                const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const;
 
+  /// one red-black Gauss-Seidel pass over the points of one colour in a single phi slice
+  /// \param m phi slice
+  /// \param jsw first z index of the colour in the first r row
+  /// for the other parameters see relax3D
+  void relaxGaussSeidelSlice3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int m, const int jsw, const int symmetry,
+                               const DataT h2, const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3,
+                               const std::vector<DataT>& coefficient4) const;
+
+  /// get the neighbouring phi slices of slice m taking into account the symmetry in phi
+  /// \param m phi slice
+  /// \param nPhi number of phi slices
+  /// \param symmetry symmetry in phi
+  /// \param mp1 next phi slice
+  /// \param mm1 previous phi slice
+  /// \param signPlus sign of the potential in the next phi slice
+  /// \param signMinus sign of the potential in the previous phi slice
+  static void getPhiNeighbours(const int m, const int nPhi, const int symmetry, int& mp1, int& mm1, int& signPlus, int& signMinus);
+
   /// Relax2D
   ///
   ///    Relaxation operation for multiGrid
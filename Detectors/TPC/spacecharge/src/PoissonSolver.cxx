@@ -24,6 +24,7 @@
 #include <numeric>
 #include <fmt/core.h>
 #include "TPCSpaceCharge/Vector3D.h"
+#include <Vc/vector>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -423,6 +424,7 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
 
     // memory for the finest grid is from parameters
     if (count == 1) {
+#pragma omp parallel for num_threads(sNThreads)
       for (int iphi = 0; iphi < mParamGrid.NPhiVertices; ++iphi) {
         for (int ir = 0; ir < mParamGrid.NRVertices; ++ir) {
           for (int iz = 0; iz < mParamGrid.NZVertices; ++iz) {
@@ -553,6 +555,7 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
   }
 
   // fill output
+#pragma omp parallel for num_threads(sNThreads)
   for (int iphi = 0; iphi < mParamGrid.NPhiVertices; ++iphi) {
     for (int ir = 0; ir < mParamGrid.NRVertices; ++ir) {
       for (int iz = 0; iz < mParamGrid.NZVertices; ++iz) {
@@ -933,43 +936,36 @@ template <typename DataT>
 void PoissonSolver<DataT>::residue3D(Vector& residue, const Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int tnPhi, const int symmetry,
                                      const DataT ih2, const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& inverseCoefficient4) const
 {
-#pragma omp parallel for num_threads(sNThreads) // parallising this loop is possible - but using more than 2 cores makes it slower -
+  using VDataT = Vc::Vector<DataT>;
+#pragma omp parallel for num_threads(sNThreads)
   for (int m = 0; m < tnPhi; ++m) {
-    int mp1 = m + 1;
+    int mp1 = 0;
+    int mm1 = 0;
     int signPlus = 1;
-    int mm1 = m - 1;
     int signMinus = 1;
-
-    // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-    if (symmetry == 1) {
-      if (mp1 > tnPhi - 1) {
-        mp1 = tnPhi - 2;
-      }
-      if (mm1 < 0) {
-        mm1 = 1;
-      }
-    }
-    // Anti-symmetry in phi
-    else if (symmetry == -1) {
-      if (mp1 > tnPhi - 1) {
-        mp1 = tnPhi - 2;
-        signPlus = -1;
-      }
-      if (mm1 < 0) {
-        mm1 = 1;
-        signMinus = -1;
-      }
-    } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-      if (mp1 > tnPhi - 1) {
-        mp1 = m + 1 - tnPhi;
-      }
-      if (mm1 < 0) {
-        mm1 = m - 1 + tnPhi;
-      }
-    }
+    getPhiNeighbours(m, tnPhi, symmetry, mp1, mm1, signPlus, signMinus);
+    const DataT signPlusT = signPlus;
+    const DataT signMinusT = signMinus;
 
     for (int j = 1; j < tnZColumn - 1; ++j) {
-      for (int i = 1; i < tnRRow - 1; ++i) {
+      // the points of one r row are contiguous: vectorised stencil followed by the scalar remainder
+      const DataT* vRow = &matricesCurrentV(0, j, m);
+      const DataT* vRowZm1 = &matricesCurrentV(0, j - 1, m);
+      const DataT* vRowZp1 = &matricesCurrentV(0, j + 1, m);
+      const DataT* vRowPhiP1 = &matricesCurrentV(0, j, mp1);
+      const DataT* vRowPhiM1 = &matricesCurrentV(0, j, mm1);
+      const DataT* chargeRow = &matricesCurrentCharge(0, j, m);
+      DataT* residueRow = &residue(0, j, m);
+      int i = 1;
+      for (; i + static_cast<int>(VDataT::Size) < tnRRow; i += VDataT::Size) {
+        const VDataT res = ih2 * (VDataT(coefficient2.data() + i, Vc::Unaligned) * VDataT(vRow + i - 1, Vc::Unaligned) + tempRatioZ * (VDataT(vRowZm1 + i, Vc::Unaligned) + VDataT(vRowZp1 + i, Vc::Unaligned)) +
+                                  VDataT(coefficient1.data() + i, Vc::Unaligned) * VDataT(vRow + i + 1, Vc::Unaligned) +
+                                  VDataT(coefficient3.data() + i, Vc::Unaligned) * (signPlusT * VDataT(vRowPhiP1 + i, Vc::Unaligned) + signMinusT * VDataT(vRowPhiM1 + i, Vc::Unaligned)) -
+                                  VDataT(inverseCoefficient4.data() + i, Vc::Unaligned) * VDataT(vRow + i, Vc::Unaligned)) +
+                          VDataT(chargeRow + i, Vc::Unaligned);
+        res.store(residueRow + i, Vc::Unaligned);
+      }
+      for (; i < tnRRow - 1; ++i) {
         residue(i, j, m) = ih2 * (coefficient2[i] * matricesCurrentV(i - 1, j, m) + tempRatioZ * (matricesCurrentV(i, j - 1, m) + matricesCurrentV(i, j + 1, m)) + coefficient1[i] * matricesCurrentV(i + 1, j, m) +
                                   coefficient3[i] * (signPlus * matricesCurrentV(i, j, mp1) + signMinus * matricesCurrentV(i, j, mm1)) - inverseCoefficient4[i] * matricesCurrentV(i, j, m)) +
                            matricesCurrentCharge(i, j, m);
@@ -983,6 +979,7 @@ void PoissonSolver<DataT>::interp3D(Vector& matricesCurrentV, const Vector& matr
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration writes the two fine slices m and m+1
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1091,6 +1088,7 @@ void PoissonSolver<DataT>::addInterp3D(Vector& matricesCurrentV, const Vector& m
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration writes the two fine slices m and m+1
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1199,50 +1197,19 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
+      // within one pass the points of a slice depend only on the points of the other colour, so the slices can be relaxed in parallel.
+      // The exception is the last slice, which is a neighbour of the first one with the same colour for continuous phi and odd number of slices:
+      // it is relaxed after all the others, as in the sequential sweep
+#pragma omp parallel for num_threads(sNThreads)
+      for (int m = 0; m < iPhi - 1; ++m) {
         const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
-        }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
-        }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end mParamGrid.NRVertices
-      }     // end phi
-    }       // end sweep
+        relaxGaussSeidelSlice3D(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, m, jsw, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+      }
+      const int jsw = ((msw + iPhi - 1) % 2) ? 1 : 2;
+      relaxGaussSeidelSlice3D(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, iPhi - 1, jsw, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+    } // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1291,6 +1258,62 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
   }
 }
 
+template <typename DataT>
+void PoissonSolver<DataT>::relaxGaussSeidelSlice3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int m, const int jsw, const int symmetry,
+                                                   const DataT h2, const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3,
+                                                   const std::vector<DataT>& coefficient4) const
+{
+  int mp1 = 0;
+  int mm1 = 0;
+  int signPlus = 1;
+  int signMinus = 1;
+  getPhiNeighbours(m, iPhi, symmetry, mp1, mm1, signPlus, signMinus);
+
+  int isw = jsw;
+  for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+    for (int i = isw; i < tnRRow - 1; i += 2) {
+      (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
+    } // end cols
+  }   // end mParamGrid.NRVertices
+}
+
+template <typename DataT>
+void PoissonSolver<DataT>::getPhiNeighbours(const int m, const int nPhi, const int symmetry, int& mp1, int& mm1, int& signPlus, int& signMinus)
+{
+  mp1 = m + 1;
+  signPlus = 1;
+  mm1 = m - 1;
+  signMinus = 1;
+
+  // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+  if (symmetry == 1) {
+    if (mp1 > nPhi - 1) {
+      mp1 = nPhi - 2;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+    }
+  }
+  // Anti-symmetry in phi
+  else if (symmetry == -1) {
+    if (mp1 > nPhi - 1) {
+      mp1 = nPhi - 2;
+      signPlus = -1;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+      signMinus = -1;
+    }
+  } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+    if (mp1 > nPhi - 1) {
+      mp1 = m + 1 - nPhi;
+    }
+    if (mm1 < 0) {
+      mm1 = m - 1 + nPhi;
+    }
+  }
+}
+
 template <typename DataT>
 void PoissonSolver<DataT>::relax2D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const DataT h2, const DataT tempFourth, const DataT tempRatio,
                                    std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2)
@@ -1366,8 +1389,9 @@ template <typename DataT>
 void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(sNThreads)
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
@@ -1414,6 +1438,7 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
     } // end phis
 
   } else {
+#pragma omp parallel for num_threads(sNThreads)
     for (int m = 0; m < newPhiSlice; ++m) {
       restrict2D(matricesCurrentCharge, residue, tnRRow, tnZColumn, m);
     }
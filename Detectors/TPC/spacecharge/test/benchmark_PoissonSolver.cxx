@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_PoissonSolver.cxx
+/// \brief Benchmark of the 3D multi grid poisson solver at the production grid granularity
+
+#include <benchmark/benchmark.h>
+
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "CommonUtils/ConfigurableParam.h"
+
+using namespace o2::tpc;
+
+namespace
+{
+using DataT = double;
+constexpr unsigned short NR = 129;   // grid in r
+constexpr unsigned short NZ = 129;   // grid in z
+constexpr unsigned short NPHI = 180; // grid in phi
+
+/// set the charge density and the boundary of the potential from the analytical formulas used in the unit test
+void setInput(const RegularGrid3D<DataT>& grid, DataContainer3D<DataT>& potential, DataContainer3D<DataT>& charge)
+{
+  const AnalyticalFields<DataT> formulas;
+  for (size_t iPhi = 0; iPhi < charge.getNPhi(); ++iPhi) {
+    const DataT phi = grid.getPhiVertex(iPhi);
+    for (size_t iR = 0; iR < charge.getNR(); ++iR) {
+      const DataT radius = grid.getRVertex(iR);
+      for (size_t iZ = 0; iZ < charge.getNZ(); ++iZ) {
+        const DataT z = grid.getZVertex(iZ);
+        charge(iZ, iR, iPhi) = formulas.evalDensity(z, radius, phi);
+        const bool isBoundary = (iR == 0) || (iR == charge.getNR() - 1) || (iZ == 0) || (iZ == charge.getNZ() - 1);
+        potential(iZ, iR, iPhi) = isBoundary ? formulas.evalPotential(z, radius, phi) : 0;
+      }
+    }
+  }
+}
+} // namespace
+
+static void BM_PoissonMultiGrid3D(benchmark::State& state)
+{
+  o2::conf::ConfigurableParam::setValue<unsigned short>("TPCSpaceChargeParam", "NZVertices", NZ);
+  o2::conf::ConfigurableParam::setValue<unsigned short>("TPCSpaceChargeParam", "NRVertices", NR);
+  o2::conf::ConfigurableParam::setValue<unsigned short>("TPCSpaceChargeParam", "NPhiVertices", NPHI);
+  MGParameters::isFull3D = true;
+
+  using GridProp = GridProperties<DataT>;
+  const RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(NZ), GridProp::getGridSpacingR(NR), GridProp::getGridSpacingPhi(NPHI)};
+  DataContainer3D<DataT> potentialInput(NZ, NR, NPHI);
+  DataContainer3D<DataT> charge(NZ, NR, NPHI);
+  setInput(grid3D, potentialInput, charge);
+
+  PoissonSolver<DataT>::setNThreads(state.range(0));
+  PoissonSolver<DataT> poissonSolver(grid3D);
+  for (auto _ : state) {
+    state.PauseTiming();
+    DataContainer3D<DataT> potential = potentialInput;
+    state.ResumeTiming();
+    poissonSolver.poissonSolver3D(potential, charge, 0);
+    benchmark::DoNotOptimize(potential);
+  }
+}
+
+BENCHMARK(BM_PoissonMultiGrid3D)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kSecond)->Iterations(1)->UseRealTime();
+
+BENCHMARK_MAIN();
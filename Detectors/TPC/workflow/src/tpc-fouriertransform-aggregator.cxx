@@ -44,6 +44,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     {"debug", VariantType::Bool, false, {"create debug files"}},
     {"sendOutput", VariantType::Bool, false, {"send IDC0, IDC1, IDCDelta, fourier coefficients (for debugging)"}},
     {"use-naive-fft", VariantType::Bool, false, {"using naive fourier transform (true) or FFTW (false)"}},
+    {"fftw-batched", VariantType::Bool, false, {"using batched FFTW_MEASURE plans directly on the 1D-IDC buffer"}},
+    {"fftw-wisdom", VariantType::String, "", {"file in which the FFTW wisdom of the batched plans is stored between runs"}},
     {"configKeyValues", VariantType::String, "", {"Semicolon separated key=value strings"}},
     {"crus", VariantType::String, cruDefault.c_str(), {"List of CRUs, comma separated ranges, e.g. 0-3,7,9-15"}}};
 
@@ -71,6 +73,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   const auto nthreadsFourier = static_cast<unsigned long>(config.options().get<int>("nthreads"));
   TPCFourierTransformAggregatorSpec::IDCFType::setNThreads(nthreadsFourier);
   TPCFourierTransformAggregatorSpec::IDCFType::setFFT(!fft);
+  TPCFourierTransformAggregatorSpec::IDCFType::setBatchedFFT(config.options().get<bool>("fftw-batched"));
+  TPCFourierTransformAggregatorSpec::IDCFType::setFFTWWisdomFile(config.options().get<std::string>("fftw-wisdom"));
 
   const auto first = tpcCRUs.begin();
   const auto last = std::min(tpcCRUs.end(), first + nCRUs);
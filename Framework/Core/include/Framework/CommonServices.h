@@ -13,16 +13,13 @@
 
 #include "Framework/ServiceSpec.h"
 #include "Framework/TypeIdHelpers.h"
+#include "Framework/ThreadPool.h"
 
 class TDatabasePDG;
 
 namespace o2::framework
 {
 
-struct ThreadPool {
-  int poolSize;
-};
-
 /// A few ServiceSpecs for services we know about and that / are needed by
 /// everyone.
 struct CommonServices {
@@ -65,9 +62,12 @@ struct CommonServices {
   static ServiceSpec dataRelayer();
   static ServiceSpec dataSender();
   static ServiceSpec tracingSpec();
-  static ServiceSpec threadPool(int numWorkers);
+  /// Work stealing ThreadPool with @a numWorkers workers, at most one per
+  /// CPU the device is allowed to run on (all of them if numWorkers < 0)
+  static ServiceSpec threadPool(int numWorkers, bool pinWorkers = false);
   static ServiceSpec dataProcessingStats();
   static ServiceSpec objectCache();
+  static ServiceSpec transientArenaSpec();
   static ServiceSpec timingInfoSpec();
   static ServiceSpec ccdbSupportSpec();
 
@@ -94,6 +94,12 @@ class DataAllocator
 
   void adoptChunk(const Output&, char*, size_t, fairmq_free_fn*, void*);
 
+  /// Create the payloads of all the @a specs at once, with the given @a sizes.
+  /// When an output buffer pool is configured, the payloads going through the
+  /// same transport share one contiguous buffer, taken from the pool in a
+  /// single allocation. The returned spans are in the order of @a specs.
+  std::vector<gsl::span<char>> makeContiguous(std::vector<Output> const& specs, std::vector<size_t> const& sizes);
+
   /// Generic helper to create an object which is owned by the framework and
   /// returned as a reference to the own object.
   /// Note: decltype(auto) will deduce the return type from the expression and it
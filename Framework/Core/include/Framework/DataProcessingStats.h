@@ -48,6 +48,10 @@ struct DataProcessingStats {
   std::atomic<uint64_t> performedComputations = 0;             // The number of computations which have completed so far
   std::atomic<uint64_t> lastReportedPerformedComputations = 0; // The number of computations which have completed until lastSlowMetricSentTimestamp
 
+  std::atomic<uint64_t> lastReportedThreadPoolTasks = 0;  // The number of tasks run by the thread pool until lastSlowMetricSentTimestamp
+  std::atomic<uint64_t> lastReportedThreadPoolSteals = 0; // ... out of which stolen from another worker
+  std::atomic<uint64_t> lastReportedThreadPoolBusy = 0;   // The time spent by the thread pool workers running tasks until lastSlowMetricSentTimestamp, in ns
+
   std::atomic<uint64_t> totalBytesOut; // How many outgoing bytes from the device
   std::atomic<uint64_t> totalBytesIn;  // How many incoming bytes from the device
 
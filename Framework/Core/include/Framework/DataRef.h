@@ -15,10 +15,15 @@
 
 namespace o2
 {
+namespace header
+{
+struct DataHeader;
+}
 namespace framework
 {
 
 struct InputSpec;
+struct DataProcessingHeader;
 
 struct DataRef {
   // FIXME: had to remove the second 'const' in const T* const
@@ -27,6 +32,10 @@ struct DataRef {
   const char* header = nullptr;
   const char* payload = nullptr;
   size_t payloadSize = 0;
+  // headers decoded when the message was received, see DecodedHeaders.
+  // When not set, DataRefUtils::getHeader walks the header stack.
+  const o2::header::DataHeader* dataHeader = nullptr;
+  const DataProcessingHeader* processingHeader = nullptr;
 };
 
 } // namespace framework
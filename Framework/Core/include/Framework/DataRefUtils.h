@@ -40,7 +40,7 @@ struct DataRefUtils {
     // alternative below, which works for TObject (which are serialised).
     if constexpr (is_messageable<T>::value == true) {
       using DataHeader = o2::header::DataHeader;
-      auto header = o2::header::get<const DataHeader*>(ref.header);
+      auto header = DataRefUtils::getHeader<const DataHeader*>(ref);
       if (header->payloadSerializationMethod != o2::header::gSerializationMethodNone) {
         throw runtime_error("Attempt to extract a POD from a wrong message kind");
       }
@@ -61,7 +61,7 @@ struct DataRefUtils {
         // explicitely using type wrapper @a ROOTSerialized.
         using RSS = std::decay_t<decltype(*p)>;
         using DataHeader = o2::header::DataHeader;
-        auto header = o2::header::get<const DataHeader*>(ref.header);
+        auto header = DataRefUtils::getHeader<const DataHeader*>(ref);
         if (header->payloadSerializationMethod != o2::header::gSerializationMethodROOT) {
           throw runtime_error("Attempt to extract a TMessage from non-ROOT serialised message");
         }
@@ -132,7 +132,7 @@ struct DataRefUtils {
       call_if_defined<struct RootSerializationSupport>([&](auto* p) {
         using RSS = std::decay_t<decltype(*p)>;
 
-        auto header = o2::header::get<const DataHeader*>(ref.header);
+        auto header = DataRefUtils::getHeader<const DataHeader*>(ref);
         if (header->payloadSerializationMethod != o2::header::gSerializationMethodROOT) {
           throw runtime_error("Attempt to extract a TMessage from non-ROOT serialised message");
         }
@@ -165,7 +165,7 @@ struct DataRefUtils {
   static o2::header::DataHeader::PayloadSizeType getPayloadSize(const DataRef& ref)
   {
     using DataHeader = o2::header::DataHeader;
-    auto* header = o2::header::get<const DataHeader*>(ref.header);
+    auto* header = DataRefUtils::getHeader<const DataHeader*>(ref);
     if (!header) {
       return 0;
     }
@@ -185,6 +185,16 @@ struct DataRefUtils {
     using HeaderT = typename std::remove_pointer<T>::type;
     static_assert(std::is_pointer<T>::value && std::is_base_of<o2::header::BaseHeader, HeaderT>::value,
                   "pointer to BaseHeader-derived type required");
+    // fast path for the headers decoded once at receive time
+    if constexpr (std::is_same_v<std::remove_cv_t<HeaderT>, o2::header::DataHeader>) {
+      if (ref.dataHeader) {
+        return ref.dataHeader;
+      }
+    } else if constexpr (std::is_same_v<std::remove_cv_t<HeaderT>, DataProcessingHeader>) {
+      if (ref.processingHeader) {
+        return ref.processingHeader;
+      }
+    }
     return o2::header::get<T>(ref.header);
   }
 
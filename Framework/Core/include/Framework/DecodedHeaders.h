@@ -0,0 +1,59 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DECODEDHEADERS_H_
+#define O2_FRAMEWORK_DECODEDHEADERS_H_
+
+#include "Headers/DataHeader.h"
+#include "Framework/DataProcessingHeader.h"
+
+namespace o2::framework
+{
+
+/// The headers of a message part which DPL needs for every input, located
+/// once when the part is received (see MessageSet::add) so that the header
+/// stack does not have to be walked again by the DataRelayer, the
+/// InputRecord and the user code. The DataRefs handed out by the InputSpan
+/// carry these pointers, see DataRefUtils::getHeader.
+struct DecodedHeaders {
+  o2::header::DataHeader const* dataHeader = nullptr;
+  DataProcessingHeader const* processingHeader = nullptr;
+
+  /// Decode the header stack in @a buffer. Stacks created by DPL have the
+  /// DataHeader first, immediately followed by the DataProcessingHeader, so
+  /// both are looked up at their fixed offsets; any other layout is handled
+  /// by walking the stack.
+  static DecodedHeaders decode(void const* buffer)
+  {
+    using o2::header::BaseHeader;
+    using o2::header::DataHeader;
+    DecodedHeaders result;
+    auto const* first = BaseHeader::get(reinterpret_cast<std::byte const*>(buffer));
+    if (first == nullptr) {
+      return result;
+    }
+    if (first->description == DataHeader::sHeaderType && first->sanityCheck(DataHeader::sVersion)) {
+      result.dataHeader = reinterpret_cast<DataHeader const*>(first);
+      auto const* second = first->next();
+      if (second && second->description == DataProcessingHeader::sHeaderType && second->sanityCheck(DataProcessingHeader::sVersion)) {
+        result.processingHeader = reinterpret_cast<DataProcessingHeader const*>(second);
+        return result;
+      }
+    } else {
+      result.dataHeader = o2::header::get<DataHeader*>(buffer);
+    }
+    result.processingHeader = o2::header::get<DataProcessingHeader*>(buffer);
+    return result;
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DECODEDHEADERS_H_
@@ -42,6 +42,19 @@ struct DeviceMetricsHelper {
   static bool processMetric(ParsedMetricMatch& results,
                             DeviceMetricsInfo& info,
                             NewMetricCallback newMetricCallback = nullptr);
+
+  /// Looks up the metric with the name in @a results, creating it
+  /// if not found.
+  /// @return the index of the metric in @a info, -1 in case of an invalid type.
+  static size_t findOrBookMetric(ParsedMetricMatch& results,
+                                 DeviceMetricsInfo& info,
+                                 NewMetricCallback newMetricCallback = nullptr);
+
+  /// Stores the value in @a results for the metric at @a metricIndex,
+  /// without any lookup by name.
+  static bool storeMetric(size_t metricIndex,
+                          ParsedMetricMatch& results,
+                          DeviceMetricsInfo& info);
   /// @return the index in metrics for the information of given metric
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
@@ -0,0 +1,150 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRING_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRING_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Binary transport for numeric metrics from a device to the driver running
+/// on the same host. The ring lives in a shared memory segment created by the
+/// driver before forking the device, and its name is passed to the child via
+/// the DPL_METRICS_RING environment variable.
+///
+/// Metric names are interned: the first time a name is sent, its label is
+/// appended to the label table and from then on only the index is pushed
+/// together with the value and the timestamp. Pushing is lock-free and can be
+/// done from several threads (bounded queue with a sequence number per slot),
+/// while the driver is the only consumer. When the ring is full, or for
+/// metrics which cannot be represented (strings, multiple values), the device
+/// falls back to the textual `[METRIC]` lines.
+struct DeviceMetricsRing {
+  static constexpr uint32_t MAGIC = 0x4d4c5044; // "DPLM"
+  static constexpr size_t CAPACITY = 8192;      // Number of slots, must be a power of 2
+  static constexpr size_t MAX_LABELS = 1024;    // Maximum number of interned metric names
+  static constexpr char const* ENV_VAR = "DPL_METRICS_RING";
+
+  struct Entry {
+    std::atomic<uint64_t> sequence;
+    uint32_t id;
+    MetricType type;
+    size_t timestamp;
+    union {
+      int intValue;
+      float floatValue;
+      uint64_t uint64Value;
+    };
+  };
+
+  uint32_t magic;
+  std::atomic<uint32_t> nLabels;
+  alignas(64) std::atomic<uint64_t> head; // Next slot to be reserved by a producer
+  alignas(64) std::atomic<uint64_t> tail; // Next slot to be read by the consumer
+  MetricLabel labels[MAX_LABELS];
+  Entry entries[CAPACITY];
+
+  /// Initialise an empty ring in the memory pointed by @a buffer,
+  /// which needs to be at least sizeof(DeviceMetricsRing) bytes.
+  static DeviceMetricsRing* init(void* buffer);
+  /// Create a shared memory segment called @a name holding an empty ring.
+  /// @return nullptr in case of failure.
+  static DeviceMetricsRing* createShared(std::string const& name);
+  /// Attach to the ring in the shared memory segment @a name.
+  /// @return nullptr in case the segment does not exist or is not a ring.
+  static DeviceMetricsRing* openShared(std::string const& name);
+  /// Unmap a ring obtained with createShared or openShared.
+  static void unmapShared(DeviceMetricsRing* ring);
+  /// Remove the shared memory segment @a name.
+  static void unlinkShared(std::string const& name);
+};
+
+/// Device side of the ring: interns the names and pushes the values.
+class DeviceMetricsRingWriter
+{
+ public:
+  DeviceMetricsRingWriter(DeviceMetricsRing* ring) : mRing{ring} {}
+
+  /// Push a numeric metric. @return false if the metric could not be
+  /// pushed (ring full or too many names), in which case the caller
+  /// is supposed to use the textual path.
+  template <typename T>
+  bool push(std::string_view name, T value, size_t timestamp);
+
+ private:
+  bool intern(std::string_view name, uint32_t& id);
+  DeviceMetricsRing::Entry* reserve();
+
+  DeviceMetricsRing* mRing;
+  std::mutex mNamesMutex;
+  std::unordered_map<std::string, uint32_t> mIds;
+};
+
+/// Driver side of the ring: drains the pending entries directly into the
+/// DeviceMetricsInfo of the device, without any string parsing.
+class DeviceMetricsRingReader
+{
+ public:
+  DeviceMetricsRingReader(DeviceMetricsRing* ring) : mRing{ring} {}
+
+  /// Process all the pending metrics.
+  /// @return the number of metrics processed.
+  size_t consume(DeviceMetricsInfo& info, DeviceMetricsHelper::NewMetricCallback newMetricCallback = nullptr);
+
+  DeviceMetricsRing* ring() { return mRing; }
+
+ private:
+  DeviceMetricsRing* mRing;
+  /// Index in the DeviceMetricsInfo for each interned id
+  std::vector<size_t> mMetricIndices;
+};
+
+template <typename T>
+bool DeviceMetricsRingWriter::push(std::string_view name, T value, size_t timestamp)
+{
+  static_assert(std::is_same_v<T, int> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float>, "Unsupported metric type");
+  uint32_t id;
+  if (!intern(name, id)) {
+    return false;
+  }
+  auto* entry = reserve();
+  if (entry == nullptr) {
+    return false;
+  }
+  entry->id = id;
+  entry->timestamp = timestamp;
+  entry->type = DeviceMetricsHelper::getMetricType<T>();
+  if constexpr (std::is_same_v<T, int>) {
+    entry->intValue = value;
+  } else if constexpr (std::is_same_v<T, float>) {
+    entry->floatValue = value;
+  } else {
+    entry->uint64Value = value;
+  }
+  // Publish the slot to the consumer
+  auto pos = entry->sequence.load(std::memory_order_relaxed);
+  entry->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRING_H_
@@ -21,14 +21,17 @@
 
 namespace o2::framework
 {
+class OutputBufferPool;
+
 /// Helper class to hide FairMQDevice headers in the DataAllocator header.
 /// This is done because FairMQDevice brings in a bunch of boost.mpl /
 /// boost.fusion stuff, slowing down compilation times enourmously.
 class FairMQDeviceProxy
 {
  public:
-  FairMQDeviceProxy() = default;
+  FairMQDeviceProxy();
   FairMQDeviceProxy(FairMQDeviceProxy const&) = delete;
+  ~FairMQDeviceProxy();
   void bindRoutes(std::vector<OutputRoute> const& routes, FairMQDevice& device);
 
   /// Retrieve the transport associated to a given route.
@@ -39,12 +42,18 @@ class FairMQDeviceProxy
   fair::mq::Channel* getChannel(ChannelIndex channelIndex) const;
 
   std::unique_ptr<FairMQMessage> createMessage(RouteIndex routeIndex) const;
+  /// Message of a fixed @a size, taken from the output buffer pool if any.
   std::unique_ptr<FairMQMessage> createMessage(RouteIndex routeIndex, const size_t size) const;
   size_t getNumChannels() const { return mChannels.size(); }
 
+  /// Pool to be used for the fixed size output messages.
+  void setOutputBufferPool(std::unique_ptr<OutputBufferPool> pool);
+  OutputBufferPool* getOutputBufferPool() const { return mOutputBufferPool.get(); }
+
  private:
   std::vector<RouteState> mRoutes;
   std::vector<fair::mq::Channel*> mChannels;
+  std::unique_ptr<OutputBufferPool> mOutputBufferPool;
 };
 
 } // namespace o2::framework
@@ -27,6 +27,7 @@
 #include <TDataType.h>
 
 #include <deque>
+#include <vector>
 
 class TList;
 
@@ -48,11 +49,19 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill n entries stored contiguously as {x, weight} resp. {x, y, weight} at once
+  static void fillN(TH1* hist, const double* entries, int n);
+  static void fillN(TH2* hist, const double* entries, int n);
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T> hist, double fillFraction = 1.);
 
  private:
+  // helper function to copy the selected rows of a table column to every stride-th element of out
+  template <typename C, typename T>
+  static void readColumn(const T& table, gsl::span<int64_t const> rows, double* out, int stride);
+
   // helper function to determine base element size of histograms (in bytes)
   template <typename T>
   static int getBaseElementSize(T* ptr);
@@ -128,6 +137,12 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // buffer up to nEntries fills of each TH1 and TH2 and pass them to ROOT at once, 0 disables the buffering
+  void setFillBufferSize(uint32_t nEntries);
+
+  // pass the buffered fills to the histograms
+  void flush();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -155,6 +170,13 @@ class HistogramRegistry
   template <typename T>
   uint32_t getHistIndex(const T& histName);
 
+  // helper function to append an entry to the fill buffer of the histogram at position idx
+  template <int STRIDE, typename... Ts>
+  void fillBuffered(uint32_t idx, Ts... positionAndWeight);
+
+  // pass the buffered fills of the histogram at position idx to the histogram
+  void flush(uint32_t idx);
+
   constexpr uint32_t imask(uint32_t i) const
   {
     return i & REGISTRY_BITMASK;
@@ -182,6 +204,10 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  // fill buffers of the TH1 and TH2, each entry being stored as {x, (y,) weight}
+  uint32_t mFillBufferSize{0};
+  std::array<std::vector<double>, MAX_REGISTRY_SIZE> mFillBuffers{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -229,14 +255,60 @@ void HistFiller::fillHistAny(std::shared_ptr<T> hist, const Ts&... positionAndWe
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  if constexpr (std::is_base_of_v<StepTHn, T>) {
+  if constexpr (std::is_base_of_v<StepTHn, R>) {
     LOGF(fatal, "Table filling is not (yet?) supported for StepTHn.");
     return;
   }
+  constexpr int nCols = sizeof...(Cs);
+  constexpr bool persistentColumns = ((Cs::persistent::value && std::is_arithmetic_v<typename Cs::type>) && ...);
+  constexpr bool columnarTH1 = std::is_same_v<TH1, R> && (nCols == 1 || nCols == 2);
+  constexpr bool columnarTH2 = std::is_same_v<TH2, R> && (nCols == 2 || nCols == 3);
+
   auto s = o2::framework::expressions::createSelection(table.asArrowTable(), filter);
-  auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
-  for (auto& t : filtered) {
-    fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+  if constexpr (persistentColumns && (columnarTH1 || columnarTH2)) {
+    // read the selected rows column by column and fill them at once
+    constexpr int stride = columnarTH1 ? 2 : 3;
+    auto rows = o2::soa::Filtered<T>::getSpan(s);
+    std::vector<double> entries(stride * rows.size(), 1.);
+    int col = 0;
+    (readColumn<Cs>(table, rows, entries.data() + col++, stride), ...);
+    fillN(hist.get(), entries.data(), rows.size());
+  } else {
+    auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
+    for (auto& t : filtered) {
+      fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+    }
+  }
+}
+
+template <typename C, typename T>
+void HistFiller::readColumn(const T& table, gsl::span<int64_t const> rows, double* out, int stride)
+{
+  using array_t = o2::soa::arrow_array_for_t<typename C::type>;
+  auto column = table.asArrowTable()->GetColumnByName(C::columnLabel());
+  if (!column) {
+    throw runtime_error_f(R"(Column "%s" not found in table!)", C::columnLabel());
+  }
+  if (rows.empty()) {
+    return;
+  }
+  if (column->num_chunks() == 0) {
+    throw runtime_error_f(R"(Column "%s" has no data!)", C::columnLabel());
+  }
+  int chunk = 0;
+  int64_t chunkStart = 0;
+  auto array = std::static_pointer_cast<array_t>(column->chunk(chunk));
+  for (auto row : rows) {
+    // selected rows are sorted, so we only ever move to the next chunks
+    while (row >= chunkStart + array->length()) {
+      if (++chunk == column->num_chunks()) {
+        throw runtime_error_f(R"(Row %lld out of range for column "%s"!)", (long long)row, C::columnLabel());
+      }
+      chunkStart += array->length();
+      array = std::static_pointer_cast<array_t>(column->chunk(chunk));
+    }
+    *out = static_cast<double>(array->Value(row - chunkStart));
+    out += stride;
   }
 }
 
@@ -359,7 +431,12 @@ std::shared_ptr<T> HistogramRegistry::add(char const* const name, char const* co
 template <typename T>
 std::shared_ptr<T> HistogramRegistry::get(const HistName& histName)
 {
-  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[getHistIndex(histName)])) {
+  const uint32_t idx = getHistIndex(histName);
+  // the histogram may be modified or inspected by the caller, so it has to be up to date
+  if (!mFillBuffers[idx].empty()) {
+    flush(idx);
+  }
+  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[idx])) {
     return *histPtr;
   } else {
     throw runtime_error_f(R"(Histogram type specified in get<>(HIST("%s")) does not match the actual type of the histogram!)", histName.str);
@@ -405,10 +482,43 @@ uint32_t HistogramRegistry::getHistIndex(const T& histName)
   throw runtime_error_f(R"(Could not find histogram "%s" in HistogramRegistry "%s"!)", histName.str, mName.data());
 }
 
+template <int STRIDE, typename... Ts>
+void HistogramRegistry::fillBuffered(uint32_t idx, Ts... positionAndWeight)
+{
+  auto& buffer = mFillBuffers[idx];
+  if (buffer.capacity() == 0) {
+    buffer.reserve(STRIDE * mFillBufferSize);
+  }
+  if constexpr (sizeof...(Ts) == STRIDE) {
+    buffer.insert(buffer.end(), {positionAndWeight...});
+  } else {
+    buffer.insert(buffer.end(), {positionAndWeight..., 1.});
+  }
+  if (buffer.size() >= STRIDE * mFillBufferSize) {
+    flush(idx);
+  }
+}
+
 template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts&&... positionAndWeight)
 {
-  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if (mFillBufferSize) {
+    constexpr int nArgs = sizeof...(Ts);
+    if constexpr (nArgs == 1 || nArgs == 2) {
+      if (std::holds_alternative<std::shared_ptr<TH1>>(mRegistryValue[idx])) {
+        fillBuffered<2>(idx, static_cast<double>(positionAndWeight)...);
+        return;
+      }
+    }
+    if constexpr (nArgs == 2 || nArgs == 3) {
+      if (std::holds_alternative<std::shared_ptr<TH2>>(mRegistryValue[idx])) {
+        fillBuffered<3>(idx, static_cast<double>(positionAndWeight)...);
+        return;
+      }
+    }
+  }
+  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[idx]);
 }
 
 template <typename... Cs, typename T>
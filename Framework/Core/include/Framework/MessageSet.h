@@ -12,6 +12,7 @@
 #define FRAMEWORK_MESSAGESET_H
 
 #include "Framework/PartRef.h"
+#include "Framework/DecodedHeaders.h"
 #include <memory>
 #include <vector>
 #include <cassert>
@@ -51,21 +52,23 @@ struct MessageSet {
     size_t payloadIndex = 0;
   };
   std::vector<PairMapping> pairMap;
+  // headers of each O2 message, decoded when the message is added
+  std::vector<DecodedHeaders> decodedHeaders;
 
   MessageSet()
-    : messages(), messageMap(), pairMap()
+    : messages(), messageMap(), pairMap(), decodedHeaders()
   {
   }
 
   template <typename F>
   MessageSet(F getter, size_t size)
-    : messages(), messageMap(), pairMap()
+    : messages(), messageMap(), pairMap(), decodedHeaders()
   {
     add(std::forward<F>(getter), size);
   }
 
   MessageSet(MessageSet&& other)
-    : messages(std::move(other.messages)), messageMap(std::move(other.messageMap)), pairMap(std::move(other.pairMap))
+    : messages(std::move(other.messages)), messageMap(std::move(other.messageMap)), pairMap(std::move(other.pairMap)), decodedHeaders(std::move(other.decodedHeaders))
   {
     other.clear();
   }
@@ -78,6 +81,7 @@ struct MessageSet {
     messages = std::move(other.messages);
     messageMap = std::move(other.messageMap);
     pairMap = std::move(other.pairMap);
+    decodedHeaders = std::move(other.decodedHeaders);
     other.clear();
     return *this;
   }
@@ -106,6 +110,7 @@ struct MessageSet {
     messages.clear();
     messageMap.clear();
     pairMap.clear();
+    decodedHeaders.clear();
   }
 
   // this is more or less legacy
@@ -124,6 +129,7 @@ struct MessageSet {
   {
     pairMap.emplace_back(messageMap.size(), 0);
     messageMap.emplace_back(messages.size(), 1);
+    decodedHeaders.emplace_back(decode(ref.header));
     messages.emplace_back(std::move(ref.header));
     messages.emplace_back(std::move(ref.payload));
   }
@@ -140,6 +146,7 @@ struct MessageSet {
       }
       messages.emplace_back(std::move(getter(i)));
     }
+    decodedHeaders.emplace_back(decode(messages[messageMap.back().position]));
   }
 
   FairMQMessagePtr& header(size_t partIndex)
@@ -177,6 +184,22 @@ struct MessageSet {
     auto payloadIndex = pairMap[pos].payloadIndex;
     return messages[messageMap[partIndex].position + payloadIndex + 1];
   }
+
+  DecodedHeaders const& decodedHeader(size_t partIndex) const
+  {
+    return decodedHeaders[partIndex];
+  }
+
+  DecodedHeaders const& associatedDecodedHeader(size_t pos) const
+  {
+    return decodedHeaders[pairMap[pos].partIndex];
+  }
+
+ private:
+  static DecodedHeaders decode(FairMQMessagePtr const& header)
+  {
+    return header ? DecodedHeaders::decode(header->GetData()) : DecodedHeaders{};
+  }
 };
 
 } // namespace framework
@@ -0,0 +1,265 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef FRAMEWORK_MIXINGPOOL_H
+#define FRAMEWORK_MIXINGPOOL_H
+
+#include "Framework/BinningPolicy.h"
+#include "Framework/Pack.h"
+#include "Framework/RuntimeError.h"
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Pool of tracks of the collisions seen in previous dataframes, to be mixed
+/// with the collisions of the current one.
+///
+/// The grouped combinations only mix collisions within a dataframe. The pool
+/// keeps instead, for each bin of the binning policy BP, the tracks of the
+/// last depth collisions added, as compact copies of the columns Cs, so that
+/// the mixed statistics do not depend on the dataframe size. The depth must be
+/// at least 1. When maxBytes is set, the oldest collisions of all bins are
+/// dropped as soon as the copies exceed that size.
+///
+/// Typical usage, once per collision with its selected tracks:
+///
+///   for (auto [pooled, track] : pool.mixedPairs(collision, tracks)) {
+///     ... pooled.get<aod::track::Pt>() ... track.pt() ...
+///   }
+///   pool.add(collision, tracks);
+template <typename BP, typename... Cs>
+class MixingPool
+{
+ public:
+  /// Copy of the columns Cs of the tracks of one collision
+  struct PooledEvent {
+    int bin = -1;
+    uint64_t serial = 0; // order in which the collisions were added
+    std::tuple<std::vector<typename Cs::type>...> columns;
+
+    size_t size() const { return std::get<0>(columns).size(); }
+    size_t bytes() const { return size() * (sizeof(typename Cs::type) + ...); }
+
+    template <typename T>
+    void push_back(T const& track)
+    {
+      push_back(track, std::index_sequence_for<Cs...>{});
+    }
+
+    void clear()
+    {
+      std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+    }
+
+   private:
+    template <typename T, size_t... Is>
+    void push_back(T const& track, std::index_sequence<Is...>)
+    {
+      (std::get<Is>(columns).push_back(*(static_cast<Cs>(track).getIterator())), ...);
+    }
+  };
+
+  /// One track of a pooled collision
+  struct PooledTrack {
+    PooledEvent const* event;
+    size_t index;
+
+    template <typename C>
+    auto get() const
+    {
+      constexpr auto position = has_type_at_v<C>(pack<Cs...>{});
+      static_assert(position < sizeof...(Cs), "Column not kept in the MixingPool");
+      return std::get<position>(event->columns)[index];
+    }
+  };
+
+  /// Pairs of each track of a collision with each track of the pooled
+  /// collisions of the same bin. Only valid as long as the pool is not modified.
+  template <typename T>
+  class MixedPairs
+  {
+   public:
+    using track_iterator_t = decltype(std::declval<T const&>().begin());
+
+    class iterator
+    {
+     public:
+      using value_type = std::pair<PooledTrack, track_iterator_t const&>;
+      using reference = value_type;
+      using iterator_category = std::forward_iterator_tag;
+
+      iterator(std::deque<PooledEvent> const* events, track_iterator_t track, int64_t trackCount, int64_t nTracks)
+        : mEvents{events}, mTrack{track}, mTrackCount{trackCount}
+      {
+        if (mEvents == nullptr || mEvents->empty()) {
+          mTrackCount = nTracks;
+        }
+      }
+
+      iterator& operator++()
+      {
+        // the pooled tracks are the inner loop, so that the track iterator only moves forward
+        if (++mIndex == (*mEvents)[mEvent].size()) {
+          mIndex = 0;
+          if (++mEvent == mEvents->size()) {
+            mEvent = 0;
+            ++mTrack;
+            ++mTrackCount;
+          }
+        }
+        return *this;
+      }
+
+      value_type operator*() const
+      {
+        return {PooledTrack{&(*mEvents)[mEvent], mIndex}, mTrack};
+      }
+
+      bool operator==(iterator const& other) const
+      {
+        return mTrackCount == other.mTrackCount && mEvent == other.mEvent && mIndex == other.mIndex;
+      }
+      bool operator!=(iterator const& other) const
+      {
+        return !(*this == other);
+      }
+
+     private:
+      std::deque<PooledEvent> const* mEvents;
+      track_iterator_t mTrack;
+      int64_t mTrackCount;
+      size_t mEvent = 0;
+      size_t mIndex = 0;
+    };
+
+    MixedPairs(std::deque<PooledEvent> const* events, T const& tracks) : mEvents{events}, mTracks{tracks} {}
+
+    iterator begin() const { return iterator{mEvents, mTracks.begin(), 0, mTracks.size()}; }
+    iterator end() const { return iterator{mEvents, mTracks.begin(), mTracks.size(), mTracks.size()}; }
+
+   private:
+    std::deque<PooledEvent> const* mEvents;
+    T mTracks;
+  };
+
+  MixingPool(BP const& binningPolicy, int depth, size_t maxBytes = 0, int outsider = -1)
+    : mBinningPolicy{binningPolicy}, mDepth{depth}, mMaxBytes{maxBytes}, mOutsider{outsider}
+  {
+    if (depth < 1) {
+      throw runtime_error_f("Invalid mixing pool depth %d, it must be at least 1", depth);
+    }
+  }
+
+  template <typename C>
+  int getBin(C const& collision) const
+  {
+    return getBin(collision, mBinningPolicy.getColumns());
+  }
+
+  /// Pairs of the tracks of collision with the tracks of the pooled
+  /// collisions in the same bin
+  template <typename C, typename T>
+  MixedPairs<T> mixedPairs(C const& collision, T const& tracks) const
+  {
+    auto events = mBins.find(getBin(collision));
+    return MixedPairs<T>{events == mBins.end() ? nullptr : &events->second, tracks};
+  }
+
+  /// Keep the tracks of collision for mixing with the following collisions.
+  /// Collisions without tracks or outside the binning are ignored.
+  template <typename C, typename T>
+  void add(C const& collision, T const& tracks)
+  {
+    int bin = getBin(collision);
+    if (bin == mOutsider || tracks.size() == 0) {
+      return;
+    }
+    auto& events = mBins[bin];
+    PooledEvent event;
+    if ((int)events.size() >= mDepth) {
+      // reuse the storage of the collision we drop
+      event = std::move(events.front());
+      events.pop_front();
+      mBytes -= event.bytes();
+      event.clear();
+    }
+    event.bin = bin;
+    event.serial = mSerial++;
+    for (auto& track : tracks) {
+      event.push_back(track);
+    }
+    mBytes += event.bytes();
+    events.push_back(std::move(event));
+    while (mMaxBytes && mBytes > mMaxBytes) {
+      dropOldest();
+    }
+  }
+
+  /// Number of pooled collisions
+  size_t size() const
+  {
+    size_t result = 0;
+    for (auto& [bin, events] : mBins) {
+      result += events.size();
+    }
+    return result;
+  }
+
+  /// Size of the copied columns
+  size_t bytes() const { return mBytes; }
+
+  void clear()
+  {
+    mBins.clear();
+    mBytes = 0;
+  }
+
+ private:
+  template <typename C, typename... Bs>
+  int getBin(C const& collision, pack<Bs...>) const
+  {
+    return mBinningPolicy.getBin(std::make_tuple(*(static_cast<Bs>(collision).getIterator())...));
+  }
+
+  void dropOldest()
+  {
+    auto oldest = mBins.end();
+    for (auto it = mBins.begin(); it != mBins.end(); ++it) {
+      if (oldest == mBins.end() || it->second.front().serial < oldest->second.front().serial) {
+        oldest = it;
+      }
+    }
+    mBytes -= oldest->second.front().bytes();
+    oldest->second.pop_front();
+    if (oldest->second.empty()) {
+      mBins.erase(oldest);
+    }
+  }
+
+  BP mBinningPolicy;
+  int mDepth;
+  size_t mMaxBytes;
+  int mOutsider;
+  size_t mBytes = 0;
+  uint64_t mSerial = 0;
+  std::unordered_map<int, std::deque<PooledEvent>> mBins;
+};
+
+} // namespace o2::framework
+#endif // FRAMEWORK_MIXINGPOOL_H
@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_OUTPUTBUFFERPOOL_H_
+#define O2_FRAMEWORK_OUTPUTBUFFERPOOL_H_
+
+#include <fairmq/FwdDecls.h>
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Pool of reusable output buffers, carved out of one unmanaged region per
+/// transport, which is registered once instead of going through the shared
+/// memory allocator for each message.
+///
+/// Buffers are handed out in power of two size classes. When the last
+/// message using a buffer is released, by this device or by any of its
+/// consumers, FairMQ notifies us via the region callback and the buffer goes
+/// back to the free list of its class. Requests which cannot be served,
+/// because they are too large or because the region is exhausted, return
+/// nullptr, so that the caller can fall back to a normal message.
+class OutputBufferPool
+{
+ public:
+  struct Stats {
+    size_t pooled = 0;    // messages served from the pool
+    size_t recycled = 0;  // ... out of which from a buffer already used
+    size_t fallbacks = 0; // requests the pool could not serve
+  };
+
+  /// @a regionSize size of the region created for each transport
+  /// @a maxBufferSize largest buffer served, so that a few large outputs
+  ///    cannot take the whole region
+  OutputBufferPool(size_t regionSize, size_t maxBufferSize = 0, size_t minBufferSize = 256);
+  ~OutputBufferPool();
+
+  /// A message of @a size bytes, or nullptr if the pool cannot provide it.
+  FairMQMessagePtr getMessage(fair::mq::TransportFactory* transport, size_t size);
+
+  /// One message for each of @a sizes, all in the same contiguous buffer,
+  /// 64 bytes aligned. Empty if the pool cannot provide it.
+  std::vector<FairMQMessagePtr> getMessages(fair::mq::TransportFactory* transport, gsl::span<size_t const> sizes);
+
+  Stats stats() const;
+
+ private:
+  struct Region;
+  struct Buffer;
+
+  Region* getRegion(fair::mq::TransportFactory* transport);
+  Buffer* getBuffer(Region& region, size_t size);
+
+  size_t mRegionSize;
+  size_t mMaxBufferSize;
+  size_t mMinBufferSize;
+  mutable std::mutex mMutex;
+  Stats mStats;
+  std::unordered_map<fair::mq::TransportFactory*, std::unique_ptr<Region>> mRegions;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_OUTPUTBUFFERPOOL_H_
@@ -15,17 +15,80 @@
 #include "Framework/ProcessingContext.h"
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace o2::framework
 {
+
+/// Controls the number of timeframes in flight with an AIMD (additive
+/// increase, multiplicative decrease) scheme, like TCP does for its
+/// congestion window.
+///
+/// The latency of a timeframe is the time between its publication and the
+/// moment the sink reports it as consumed. As long as the pipeline is not
+/// saturated, adding timeframes in flight does not change the latency, so
+/// the limit is increased: by one for every consumed timeframe until the
+/// first congestion (slow start) and by one for every limit's worth of
+/// consumed timeframes afterwards. Once the slowest device is busy all the
+/// time, additional timeframes only queue up, wasting shared memory and
+/// increasing the latency. When the latency exceeds latencyTolerance times the minimum
+/// observed one, or when the shared memory is short, the limit is halved.
+/// With the default tolerance of 2, the limit oscillates between the
+/// smallest value giving the maximal throughput and twice that.
+class AdaptiveInFlightLimit
+{
+ public:
+  AdaptiveInFlightLimit(int maxLimit = 1024);
+
+  /// Timeframe @a index was published at @a now (in ns).
+  void sent(int64_t index, uint64_t now);
+  /// Timeframes [@a from, @a to) were consumed at @a now (in ns).
+  void consumed(int64_t from, int64_t to, uint64_t now);
+  /// Congestion (too large latency, shared memory short) seen when
+  /// timeframe @a index completed, or while it was the oldest in flight.
+  void congestion(int64_t index);
+
+  /// Number of timeframes allowed in flight.
+  int limit() const { return mWindow > mMaxLimit ? mMaxLimit : (int)mWindow; }
+  int maxLimit() const { return mMaxLimit; }
+  uint64_t minLatency() const { return (uint64_t)mMinLatency; }
+
+  /// Latency, relative to the minimum one, above which the limit is reduced.
+  double latencyTolerance = 2.;
+  /// Growth of the minimum latency for each consumed timeframe, so that a
+  /// change in the processing time is eventually picked up.
+  double minLatencyAging = 1.0001;
+
+ private:
+  int mMaxLimit;
+  double mWindow = 1.;
+  bool mSlowStart = true;
+  double mMinLatency = 0.;
+  int64_t mLastSent = -1;
+  /// Decreasing again before the timeframes sent after the last decrease
+  /// are consumed would react twice to the same congestion.
+  int64_t mRecoverUntil = -1;
+  std::vector<uint64_t> mSendTimes;
+};
+
 class RateLimiter
 {
  public:
+  /// Enable the adaptive mode, where the number of timeframes in flight is
+  /// controlled by an AdaptiveInFlightLimit and maxInFlight is only an upper
+  /// bound. In that mode, minSHM also triggers a reduction of the limit as
+  /// soon as less than twice that amount of shared memory is free.
+  void setAdaptive(bool adaptive) { mAdaptive = adaptive; }
   void check(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
 
  private:
+  void checkAdaptive(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
+
   int64_t mConsumedTimeframes = 0;
   int64_t mSentTimeframes = 0;
+  bool mAdaptive = false;
+  std::unique_ptr<AdaptiveInFlightLimit> mAdaptiveLimit;
 };
 } // namespace o2::framework
 
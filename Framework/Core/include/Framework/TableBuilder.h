@@ -675,6 +675,20 @@ class TableBuilder
   }
 
  public:
+  /// Columns filled in place, see inPlacePersist
+  struct InPlaceColumns {
+    /// Block holding the columns, preceded by the headroom
+    std::shared_ptr<arrow::Buffer> block;
+    /// Space reserved in front of the columns for the Arrow IPC metadata
+    int64_t headroom = 0;
+    /// Size of the columns, each padded to 8 bytes as in the Arrow IPC body
+    int64_t bodySize = 0;
+    std::vector<int64_t> widths;
+    std::vector<uint8_t*> columns;
+    int64_t rows = 0;
+    int64_t capacity = 0;
+  };
+
   void setLabel(const char* label);
 
   TableBuilder(arrow::MemoryPool* pool = arrow::default_memory_pool())
@@ -771,6 +785,34 @@ class TableBuilder
     };
   }
 
+  /// Same as preallocatedPersist, but the values are written directly in a
+  /// single block, allocated from the in place pool (see setInPlacePool) and
+  /// laid out as the body of the Arrow IPC message which carries the table.
+  /// When the TableBuilder is created with DataAllocator::make, the block is
+  /// the FairMQ message which is sent, so that the columns are not copied when
+  /// the table is serialised, provided exactly @a nRows rows were filled.
+  /// Only fixed width numeric columns are supported.
+  template <typename... ARGS>
+  auto inPlacePersist(std::vector<std::string> const& columnNames, int nRows)
+  {
+    static_assert(((std::is_arithmetic_v<ARGS> && !std::is_same_v<ARGS, bool>) && ...),
+                  "Only fixed width numeric columns can be persisted in place");
+    constexpr int nColumns = sizeof...(ARGS);
+    validate(nColumns, columnNames);
+    mArrays.resize(nColumns);
+    mSchema = std::make_shared<arrow::Schema>(TableBuilderHelpers::makeFields<ARGS...>(columnNames));
+    auto* columns = makeInPlaceColumns({sizeof(ARGS)...}, nRows);
+
+    return [columns](unsigned int slot, ARGS... args) -> void {
+      if (columns->rows == columns->capacity) {
+        throwError(runtime_error("Too many rows for a table persisted in place"));
+      }
+      size_t ci = 0;
+      ((reinterpret_cast<ARGS*>(columns->columns[ci++])[columns->rows] = args), ...);
+      ++columns->rows;
+    };
+  }
+
   template <typename... ARGS>
   auto bulkPersist(std::vector<std::string> const& columnNames, size_t nRows)
   {
@@ -819,6 +861,19 @@ class TableBuilder
   /// Actually creates the arrow::Table from the builders
   std::shared_ptr<arrow::Table> finalize();
 
+  /// Pool for the block used by inPlacePersist. Defaults to the pool of the
+  /// builders.
+  void setInPlacePool(std::shared_ptr<arrow::MemoryPool> pool)
+  {
+    mInPlacePool = std::move(pool);
+  }
+
+  /// The columns filled by inPlacePersist, nullptr for the other modes
+  InPlaceColumns const* inPlaceColumns() const
+  {
+    return mInPlace.get();
+  }
+
  private:
   /// Helper which actually creates the insertion cursor. Notice that the
   /// template argument T is a o2::soa::Table which contains only the
@@ -837,9 +892,14 @@ class TableBuilder
     return this->template persist<E>(columnNames);
   }
 
+  InPlaceColumns* makeInPlaceColumns(std::vector<int64_t> const& widths, int64_t nRows);
+  static bool finalizeInPlace(std::shared_ptr<arrow::Schema> schema, std::vector<std::shared_ptr<arrow::Array>>& arrays, void* holders);
+
   bool (*mFinalizer)(std::shared_ptr<arrow::Schema> schema, std::vector<std::shared_ptr<arrow::Array>>& arrays, void* holders);
   void* mHolders;
   arrow::MemoryPool* mMemoryPool;
+  std::shared_ptr<arrow::MemoryPool> mInPlacePool;
+  std::shared_ptr<InPlaceColumns> mInPlace;
   std::shared_ptr<arrow::Schema> mSchema;
   std::vector<std::shared_ptr<arrow::Array>> mArrays;
 };
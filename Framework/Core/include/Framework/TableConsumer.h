@@ -12,6 +12,7 @@
 #ifndef FRAMEWORK_TABLECONSUMER_H
 #define FRAMEWORK_TABLECONSUMER_H
 
+#include <cstdint>
 #include <memory>
 
 namespace arrow
@@ -24,6 +25,16 @@ namespace o2
 {
 namespace framework
 {
+/// Prefix of the messages of tables persisted in place (see
+/// TableBuilder::inPlacePersist), whose Arrow IPC stream does not start at
+/// the beginning of the message but is positioned so that its body is where
+/// the columns were filled.
+struct InPlaceTableHeader {
+  static constexpr char sMagic[8] = {'O', '2', 'I', 'N', 'P', 'L', 'C', 'E'};
+  char magic[8] = {'O', '2', 'I', 'N', 'P', 'L', 'C', 'E'};
+  uint64_t streamOffset = 0;
+};
+
 /// Helper class which creates a lambda suitable for building
 /// an arrow table from a tuple. This can be used, for example
 /// to build an arrow::Table from a TDataFrame.
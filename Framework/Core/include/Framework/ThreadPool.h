@@ -0,0 +1,199 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_THREADPOOL_H_
+#define O2_FRAMEWORK_THREADPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Work stealing task scheduler, available to the tasks of a device as the
+/// ThreadPool service (see CommonServices::threadPool).
+///
+/// Each worker has its own queue: the tasks it spawns are pushed to and
+/// popped from its back, idle workers steal from the front of the others'
+/// queues. A thread waiting for a TaskGroup runs pending tasks meanwhile, so
+/// nested parallelism does not deadlock and the thread of the device
+/// contributes to the work.
+///
+/// The workers never exceed the CPUs in the affinity mask of the device, so
+/// that devices sharing a node with a restricted CPU set do not oversubscribe
+/// it. Optionally, each worker is pinned to one of those CPUs.
+class ThreadPool
+{
+ public:
+  struct Stats {
+    uint64_t tasks = 0;  // tasks executed
+    uint64_t steals = 0; // ... out of which taken from the queue of another worker
+    uint64_t busy = 0;   // time spent running tasks by the workers, in ns
+  };
+
+  /// @a numWorkers <= 0 means one worker per CPU in the affinity mask
+  explicit ThreadPool(int numWorkers, bool pinWorkers = false);
+  ~ThreadPool();
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  /// Number of workers
+  int size() const { return (int)mWorkers.size(); }
+  /// Number of threads taking part in a parallelFor: the workers plus the caller
+  int maxThreads() const { return size() + 1; }
+  /// Index, in [0, maxThreads()), of the calling thread: 1 + the index of
+  /// the worker, or 0 for a thread running a parallelFor of this pool, like
+  /// the omp_get_thread_num() of the master thread. -1 for any other thread.
+  int threadIndex() const;
+
+  /// Number of CPUs the calling process is allowed to run on
+  static int allowedCPUs();
+
+  /// Schedule @a task. Prefer TaskGroup, which allows waiting for it.
+  void submit(std::function<void()> task);
+  /// Run one of the pending tasks on the calling thread.
+  /// @return false if there was none
+  bool runPendingTask();
+
+  /// Call f(i) for all i in [begin, end), in chunks of @a grain indices
+  /// distributed dynamically over the workers and the calling thread.
+  /// By default, the grain gives about 8 chunks per thread.
+  template <typename F>
+  void parallelFor(int64_t begin, int64_t end, F&& f, int64_t grain = 0);
+
+  Stats stats() const;
+
+ private:
+  struct Worker;
+
+  /// Gives index 0 to the calling thread while it takes part in a
+  /// parallelFor, unless it is one of the workers.
+  class CallerScope
+  {
+   public:
+    explicit CallerScope(ThreadPool const& pool);
+    ~CallerScope();
+
+   private:
+    ThreadPool const* mPrevious;
+  };
+
+  void work(int index);
+  bool runTask(int index);
+
+  std::vector<std::unique_ptr<Worker>> mWorkers;
+  std::atomic<int64_t> mPending{0};
+  std::atomic<uint64_t> mNextQueue{0};
+  std::atomic<bool> mStop{false};
+  std::mutex mSleepMutex;
+  std::condition_variable mWakeUp;
+};
+
+/// A set of tasks which can be waited for.
+///
+///   TaskGroup group(pool);
+///   group.run([&]() { ... });
+///   group.run([&]() { ... });
+///   group.wait();
+///
+/// The first exception thrown by one of the tasks is rethrown by wait().
+class TaskGroup
+{
+ public:
+  explicit TaskGroup(ThreadPool& pool) : mPool{pool} {}
+  ~TaskGroup();
+
+  template <typename F>
+  void run(F&& f)
+  {
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    mPool.submit([this, f = std::forward<F>(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        std::scoped_lock lock(mExceptionMutex);
+        if (!mException) {
+          mException = std::current_exception();
+        }
+      }
+      mPending.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  void wait();
+
+ private:
+  void join();
+
+  ThreadPool& mPool;
+  std::atomic<int64_t> mPending{0};
+  std::mutex mExceptionMutex;
+  std::exception_ptr mException;
+};
+
+template <typename F>
+void ThreadPool::parallelFor(int64_t begin, int64_t end, F&& f, int64_t grain)
+{
+  if (end <= begin) {
+    return;
+  }
+  if (grain <= 0) {
+    grain = std::max<int64_t>(1, (end - begin) / (8 * maxThreads()));
+  }
+  std::atomic<int64_t> next{begin};
+  auto chunks = [&next, end, grain, &f]() {
+    for (int64_t first = next.fetch_add(grain); first < end; first = next.fetch_add(grain)) {
+      for (int64_t i = first, last = std::min(first + grain, end); i < last; ++i) {
+        f(i);
+      }
+    }
+  };
+  CallerScope caller(*this);
+  TaskGroup group(*this);
+  int64_t nChunks = (end - begin + grain - 1) / grain;
+  for (int64_t t = 0, nTasks = std::min<int64_t>(size(), nChunks - 1); t < nTasks; ++t) {
+    group.run(chunks);
+  }
+  chunks();
+  group.wait();
+}
+
+/// Adapter for the loops parallelised with `#pragma omp parallel for`: runs
+/// them on @a pool when there is one, so that they share the CPUs of the
+/// device with the rest of its tasks, and with OpenMP otherwise. Code using
+/// omp_get_thread_num() to index per thread buffers can use
+/// pool->threadIndex() instead, with pool->maxThreads() buffers.
+template <typename F>
+void parallelFor(ThreadPool* pool, int64_t begin, int64_t end, F&& f)
+{
+  if (pool) {
+    pool->parallelFor(begin, end, std::forward<F>(f));
+    return;
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int64_t i = begin; i < end; ++i) {
+    f(i);
+  }
+}
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_THREADPOOL_H_
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TRANSIENTARENA_H_
+#define O2_FRAMEWORK_TRANSIENTARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace o2::framework
+{
+
+/// Memory resource for the temporary objects of a processing callback,
+/// available as a service:
+///
+///   auto& arena = pc.services().get<TransientArena>();
+///   std::pmr::vector<int> flags(nTracks, &arena);
+///
+/// Allocations are carved out of a monotonic buffer and deallocation is a
+/// no-op: everything is released at once by reset(), which the
+/// DataProcessingDevice calls at the end of each processing iteration.
+/// Objects using the arena must therefore not outlive the callback which
+/// created them. The buffer grows to the largest amount of memory used in
+/// an iteration, so that in the steady state each iteration is served by a
+/// single block whose pages are already mapped.
+///
+/// Not thread safe: allocate from the thread running the callback only.
+class TransientArena : public std::pmr::memory_resource
+{
+ public:
+  explicit TransientArena(size_t initialSize = 1 << 20);
+  ~TransientArena() override;
+
+  /// Release all the memory allocated since the previous reset.
+  void reset();
+
+  /// Bytes allocated since the last reset
+  size_t allocated() const { return mAllocated; }
+  /// Largest number of bytes allocated between two resets
+  size_t highWaterMark() const { return mHighWaterMark; }
+  /// Size of the buffer used before falling back to further allocations
+  size_t capacity() const { return mCapacity; }
+  uint64_t resets() const { return mResets; }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+  void allocateBuffer(size_t size);
+
+  std::unique_ptr<std::byte[]> mBuffer;
+  size_t mCapacity = 0;
+  std::optional<std::pmr::monotonic_buffer_resource> mResource;
+  size_t mAllocated = 0;
+  size_t mHighWaterMark = 0;
+  uint64_t mResets = 0;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TRANSIENTARENA_H_
@@ -21,6 +21,7 @@
 #include "Framework/Tracing.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceInfo.h"
+#include "Framework/OutputBufferPool.h"
 
 #include "CommonMessageBackendsHelpers.h"
 
@@ -50,6 +51,10 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQDeviceProxy()
     .name = "fairmq-device-proxy",
     .init = [](ServiceRegistry&, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto* proxy = new FairMQDeviceProxy();
+      size_t poolSize = options.Count("output-buffer-pool-size") ? std::stoull(options.GetPropertyAsString("output-buffer-pool-size")) : 0;
+      if (poolSize) {
+        proxy->setOutputBufferPool(std::make_unique<OutputBufferPool>(poolSize << 20));
+      }
       return ServiceHandle{.hash = TypeIdHelpers::uniqueId<FairMQDeviceProxy>(), .instance = proxy, .kind = ServiceKind::Serial};
     },
     .start = [](ServiceRegistry& services, void* instance) {
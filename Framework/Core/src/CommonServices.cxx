@@ -31,6 +31,7 @@
 #include "Framework/RunningWorkflowInfo.h"
 #include "Framework/Tracing.h"
 #include "Framework/Monitoring.h"
+#include "Framework/TransientArena.h"
 #include "TextDriverClient.h"
 #include "WSDriverClient.h"
 #include "HTTPParser.h"
@@ -529,24 +530,21 @@ o2::framework::ServiceSpec CommonServices::ccdbSupportSpec()
 //        This should probably be done by overriding the preFork
 //        callback and using the boost program options there to
 //        get the default number of threads.
-o2::framework::ServiceSpec CommonServices::threadPool(int numWorkers)
+o2::framework::ServiceSpec CommonServices::threadPool(int numWorkers, bool pinWorkers)
 {
   return ServiceSpec{
     .name = "threadpool",
-    .init = [numWorkers](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
-      ThreadPool* pool = new ThreadPool();
-      pool->poolSize = numWorkers;
+    .init = [numWorkers, pinWorkers](ServiceRegistry& services, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
+      auto* pool = new ThreadPool(numWorkers, pinWorkers);
+      LOGP(info, "Started a thread pool with {} workers ({} CPUs allowed)", pool->size(), ThreadPool::allowedCPUs());
       return ServiceHandle{TypeIdHelpers::uniqueId<ThreadPool>(), pool};
     },
-    .configure = [numWorkers](InitContext&, void* service) -> void* {
-      ThreadPool* t = reinterpret_cast<ThreadPool*>(service);
-      t->poolSize = numWorkers;
-      return service;
-    },
+    .configure = noConfiguration(),
     .postForkParent = [numWorkers](ServiceRegistry& service) -> void {
       auto numWorkersS = std::to_string(numWorkers);
       setenv("UV_THREADPOOL_SIZE", numWorkersS.c_str(), 0);
     },
+    .exit = [](ServiceRegistry&, void* service) { delete reinterpret_cast<ThreadPool*>(service); },
     .kind = ServiceKind::Serial};
 }
 
@@ -629,6 +627,25 @@ auto sendRelayerMetrics(ServiceRegistry& registry, DataProcessingStats& stats) -
     monitoring.send(Metric{(uint64_t)stats.consumedTimeframes, "consumed-timeframes"}.addTag(Key::Subsystem, Value::DPL));
   }
 
+  if (registry.active<ThreadPool>() && registry.get<ThreadPool>().size()) {
+    auto& pool = registry.get<ThreadPool>();
+    auto poolStats = pool.stats();
+    // busy is in ns, the time since the last update in ms
+    double available = 1e6 * timeSinceLastUpdate * pool.size();
+    monitoring.send(Metric{100. * (poolStats.busy - stats.lastReportedThreadPoolBusy) / available, "threadpool_utilization"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{(uint64_t)(poolStats.tasks - stats.lastReportedThreadPoolTasks), "threadpool_tasks"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{(uint64_t)(poolStats.steals - stats.lastReportedThreadPoolSteals), "threadpool_steals"}.addTag(Key::Subsystem, Value::DPL));
+    stats.lastReportedThreadPoolBusy.store(poolStats.busy);
+    stats.lastReportedThreadPoolTasks.store(poolStats.tasks);
+    stats.lastReportedThreadPoolSteals.store(poolStats.steals);
+  }
+
+  if (registry.active<TransientArena>() && registry.get<TransientArena>().highWaterMark()) {
+    auto& arena = registry.get<TransientArena>();
+    monitoring.send(Metric{(uint64_t)arena.highWaterMark(), "transient_arena_high_water_mark"}.addTag(Key::Subsystem, Value::DPL));
+    monitoring.send(Metric{(uint64_t)arena.capacity(), "transient_arena_capacity"}.addTag(Key::Subsystem, Value::DPL));
+  }
+
   stats.lastSlowMetricSentTimestamp.store(stats.beginIterationTimestamp.load());
   stats.lastReportedPerformedComputations.store(stats.performedComputations.load());
   O2_SIGNPOST_END(MonitoringStatus::ID, MonitoringStatus::SEND, 0, 0, O2_SIGNPOST_BLUE);
@@ -718,6 +735,18 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
     .kind = ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::transientArenaSpec()
+{
+  return ServiceSpec{
+    .name = "transient-arena",
+    .init = [](ServiceRegistry&, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+      return ServiceHandle{TypeIdHelpers::uniqueId<TransientArena>(), new TransientArena(), ServiceKind::Serial, "transient-arena"};
+    },
+    .configure = noConfiguration(),
+    .exit = [](ServiceRegistry&, void* service) { delete reinterpret_cast<TransientArena*>(service); },
+    .kind = ServiceKind::Serial};
+}
+
 o2::framework::ServiceSpec CommonServices::objectCache()
 {
   return ServiceSpec{
@@ -750,6 +779,7 @@ std::vector<ServiceSpec> CommonServices::defaultServices(int numThreads)
     dataSender(),
     dataProcessingStats(),
     objectCache(),
+    transientArenaSpec(),
     ccdbSupportSpec(),
     CommonMessageBackends::fairMQBackendSpec(),
     ArrowSupport::arrowBackendSpec(),
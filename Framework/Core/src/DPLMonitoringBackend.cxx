@@ -10,9 +10,11 @@
 // or submit itself to any jurisdiction.
 
 #include "DPLMonitoringBackend.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DriverClient.h"
 #include "Framework/ServiceRegistry.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
 
 namespace o2::framework
@@ -29,8 +31,19 @@ overloaded(Ts...) -> overloaded<Ts...>;
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistry& registry)
   : mRegistry{registry}
 {
+  // The driver provides a shared memory ring only to the devices it spawns itself.
+  char const* ringName = getenv(DeviceMetricsRing::ENV_VAR);
+  if (ringName == nullptr) {
+    return;
+  }
+  auto* ring = DeviceMetricsRing::openShared(ringName);
+  if (ring) {
+    mRingWriter = std::make_unique<DeviceMetricsRingWriter>(ring);
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
@@ -53,6 +66,20 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  // Single numeric values go through the binary channel, if available.
+  // Anything else, or a full ring, uses the textual representation.
+  if (mRingWriter && metric.getValuesSize() == 1) {
+    auto timestamp = convertTimestamp(metric.getTimestamp());
+    bool sent = std::visit(overloaded{
+                             [](const std::string&) -> bool { return false; },
+                             [&](int value) -> bool { return mRingWriter->push(metric.getName(), value, timestamp); },
+                             [&](double value) -> bool { return mRingWriter->push(metric.getName(), (float)value, timestamp); },
+                             [&](uint64_t value) -> bool { return mRingWriter->push(metric.getName(), value, timestamp); }},
+                           metric.getValues().front().second);
+    if (sent) {
+      return;
+    }
+  }
   std::array<char, 4096> buffer;
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
   for (auto& value : metric.getValues()) {
@@ -12,12 +12,14 @@
 #define O2_FRAMEWORK_DPLMONITORINGBACKEND_H_
 
 #include "Monitoring/Backend.h"
+#include <memory>
 #include <string>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class DeviceMetricsRingWriter;
 
 /// \brief Prints metrics to standard output via std::cout
 class DPLMonitoringBackend final : public o2::monitoring::Backend
@@ -27,7 +29,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistry& registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -46,6 +48,9 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
+  /// Binary channel to the driver, only available for devices
+  /// spawned by a driver on the same host.
+  std::unique_ptr<DeviceMetricsRingWriter> mRingWriter;
 };
 
 } // namespace o2::framework
@@ -16,6 +16,7 @@
 #include "Framework/ArrowContext.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/OutputBufferPool.h"
 #include "Headers/Stack.h"
 #include "FairMQResizableBuffer.h"
 
@@ -89,6 +90,59 @@ void DataAllocator::adoptChunk(const Output& spec, char* buffer, size_t size, fa
   context.add<MessageContext::TrivialObject>(std::move(headerMessage), routeIndex, 0, buffer, size, freefn, hint);
 }
 
+std::vector<gsl::span<char>> DataAllocator::makeContiguous(std::vector<Output> const& specs, std::vector<size_t> const& sizes)
+{
+  if (specs.size() != sizes.size()) {
+    throw runtime_error_f("makeContiguous: %zu outputs but %zu sizes", specs.size(), sizes.size());
+  }
+  auto& proxy = mRegistry->get<FairMQDeviceProxy>();
+  auto& timingInfo = mRegistry->get<TimingInfo>();
+  auto* pool = proxy.getOutputBufferPool();
+
+  std::vector<RouteIndex> routeIndices;
+  routeIndices.reserve(specs.size());
+  for (auto& spec : specs) {
+    routeIndices.push_back(matchDataHeader(spec, timingInfo.timeslice));
+  }
+
+  // One allocation for all the outputs sharing a transport
+  std::vector<FairMQMessagePtr> payloads(specs.size());
+  std::vector<size_t> group;
+  std::vector<size_t> groupSizes;
+  for (size_t i = 0; i < specs.size(); ++i) {
+    if (payloads[i]) {
+      continue;
+    }
+    auto* transport = proxy.getTransport(routeIndices[i]);
+    group.clear();
+    groupSizes.clear();
+    for (size_t j = i; j < specs.size(); ++j) {
+      if (!payloads[j] && proxy.getTransport(routeIndices[j]) == transport) {
+        group.push_back(j);
+        groupSizes.push_back(sizes[j]);
+      }
+    }
+    std::vector<FairMQMessagePtr> messages;
+    if (pool) {
+      messages = pool->getMessages(transport, groupSizes);
+    }
+    for (size_t k = 0; k < group.size(); ++k) {
+      auto j = group[k];
+      payloads[j] = messages.empty() ? transport->CreateMessage(sizes[j], fair::mq::Alignment{64}) : std::move(messages[k]);
+    }
+  }
+
+  std::vector<gsl::span<char>> result;
+  result.reserve(specs.size());
+  auto& context = mRegistry->get<MessageContext>();
+  for (size_t i = 0; i < specs.size(); ++i) {
+    result.emplace_back(static_cast<char*>(payloads[i]->GetData()), sizes[i]);
+    auto headerMessage = headerMessageFromOutput(specs[i], routeIndices[i], o2::header::gSerializationMethodNone, sizes[i]);
+    context.add<MessageContext::TrivialObject>(std::move(headerMessage), std::move(payloads[i]), routeIndices[i]);
+  }
+  return result;
+}
+
 FairMQMessagePtr DataAllocator::headerMessageFromOutput(Output const& spec,                     //
                                                         RouteIndex routeIndex,                  //
                                                         o2::header::SerializationMethod method, //
@@ -145,53 +199,6 @@ void DataAllocator::adopt(const Output& spec, std::string* ptr)
   assert(payload.get() == nullptr);
 }
 
-void doWriteTable(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table* table)
-{
-  auto mock = std::make_shared<arrow::io::MockOutputStream>();
-  int64_t expectedSize = 0;
-  auto mockWriter = arrow::ipc::MakeStreamWriter(mock.get(), table->schema());
-  arrow::Status outStatus;
-  if (O2_BUILTIN_LIKELY(table->num_rows() != 0)) {
-    outStatus = mockWriter.ValueOrDie()->WriteTable(*table);
-  } else {
-    std::vector<std::shared_ptr<arrow::Array>> columns;
-    columns.resize(table->columns().size());
-    for (size_t ci = 0; ci < table->columns().size(); ci++) {
-      columns[ci] = table->column(ci)->chunk(0);
-    }
-    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
-    outStatus = mockWriter.ValueOrDie()->WriteRecordBatch(*batch);
-  }
-
-  expectedSize = mock->Tell().ValueOrDie();
-  auto reserve = b->Reserve(expectedSize);
-  if (reserve.ok() == false) {
-    throw std::runtime_error("Unable to reserve memory for table");
-  }
-
-  auto stream = std::make_shared<FairMQOutputStream>(b);
-  auto outBatch = arrow::ipc::MakeStreamWriter(stream.get(), table->schema());
-  if (outBatch.ok() == false) {
-    throw ::std::runtime_error("Unable to create batch writer");
-  }
-
-  if (O2_BUILTIN_UNLIKELY(table->num_rows() == 0)) {
-    std::vector<std::shared_ptr<arrow::Array>> columns;
-    columns.resize(table->columns().size());
-    for (size_t ci = 0; ci < table->columns().size(); ci++) {
-      columns[ci] = table->column(ci)->chunk(0);
-    }
-    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
-    outStatus = outBatch.ValueOrDie()->WriteRecordBatch(*batch);
-  } else {
-    outStatus = outBatch.ValueOrDie()->WriteTable(*table);
-  }
-
-  if (outStatus.ok() == false) {
-    throw std::runtime_error("Unable to Write table");
-  }
-}
-
 void DataAllocator::adopt(const Output& spec, TableBuilder* tb)
 {
   auto& timingInfo = mRegistry->get<TimingInfo>();
@@ -205,13 +212,21 @@ void DataAllocator::adopt(const Output& spec, TableBuilder* tb)
     return transport->CreateMessage(s);
   };
   auto buffer = std::make_shared<FairMQResizableBuffer>(creator);
+  // Tables persisted in place are filled directly in the message to be sent.
+  auto pool = std::make_shared<FairMQMemoryPool>(creator);
+  tb->setInPlacePool(pool);
 
   /// To finalise this we write the table to the buffer.
   /// FIXME: most likely not a great idea. We should probably write to the buffer
   ///        directly in the TableBuilder, incrementally.
   std::shared_ptr<TableBuilder> p(tb);
-  auto finalizer = [payload = p](std::shared_ptr<FairMQResizableBuffer> b) -> void {
+  auto finalizer = [payload = p, pool](std::shared_ptr<FairMQResizableBuffer> b) -> void {
     auto table = payload->finalize();
+    auto* columns = payload->inPlaceColumns();
+    if (columns && columns->rows == columns->capacity &&
+        doWriteTableInPlace(b, *table, *pool, columns->block->data() + columns->headroom, columns->bodySize) >= 0) {
+      return;
+    }
     doWriteTable(b, table.get());
   };
 
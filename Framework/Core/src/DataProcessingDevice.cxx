@@ -28,11 +28,13 @@
 #include "Framework/FairOptionsRetriever.h"
 #include "ConfigurationOptionsRetriever.h"
 #include "Framework/FairMQDeviceProxy.h"
+#include "Framework/TransientArena.h"
 #include "Framework/CallbackService.h"
 #include "Framework/TMessageSerializer.h"
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpan.h"
 #include "Framework/Signpost.h"
+#include "Framework/SignpostRecorder.h"
 #include "Framework/SourceInfoHeader.h"
 #include "Framework/Logger.h"
 #include "Framework/DriverClient.h"
@@ -196,6 +198,10 @@ void run_callback(uv_work_t* handle)
   DataProcessorContext& context = *task->context;
   DataProcessingDevice::doPrepare(context);
   DataProcessingDevice::doRun(context);
+  // Whatever was allocated in the arena during this iteration is gone.
+  if (context.registry->active<TransientArena>()) {
+    context.registry->get<TransientArena>().reset();
+  }
   //  FrameMark;
 }
 
@@ -323,6 +329,7 @@ void DataProcessingDevice::Init()
 {
   TracyAppInfo(mSpec.name.data(), mSpec.name.size());
   ZoneScopedN("DataProcessingDevice::Init");
+  SignpostRecorder::setProcessName(mSpec.id);
   mRelayer = &mServiceRegistry.get<DataRelayer>();
 
   auto configStore = DeviceConfigurationHelpers::getConfiguration(mServiceRegistry, mSpec.name.c_str(), mSpec.options);
@@ -377,6 +384,16 @@ void DataProcessingDevice::Init()
   }
 }
 
+/// Dump the signposts recorded so far, when enabled.
+void on_signpost_dump_callback(uv_signal_t* handle, int signum)
+{
+  if (SignpostRecorder::isEnabled() == false) {
+    LOGP(warning, "Signal {} received, but signposts are not being recorded. Set {} to enable them.", signum, SignpostRecorder::ENV_VAR);
+    return;
+  }
+  LOGP(info, "Signposts written to {}", SignpostRecorder::dumpToFile());
+}
+
 void on_signal_callback(uv_signal_t* handle, int signum)
 {
   ZoneScopedN("Signal callaback");
@@ -638,6 +655,11 @@ void DataProcessingDevice::InitTask()
   sigusr1Handle->data = &mDeviceContext;
   uv_signal_start(sigusr1Handle, on_signal_callback, SIGUSR1);
 
+  // SIGUSR2 dumps the signposts recorded so far, see Framework/SignpostRecorder.h
+  uv_signal_t* sigusr2Handle = (uv_signal_t*)malloc(sizeof(uv_signal_t));
+  uv_signal_init(mState.loop, sigusr2Handle);
+  uv_signal_start(sigusr2Handle, on_signpost_dump_callback, SIGUSR2);
+
   /// Initialise the pollers
   DataProcessingDevice::initPollers();
 
@@ -1314,7 +1336,7 @@ auto calculateInputRecordLatency(InputRecord const& record, uint64_t currentTime
   DataProcessingStats::InputLatency result{static_cast<int>(-1), 0};
 
   for (auto& item : record) {
-    auto* header = o2::header::get<DataProcessingHeader*>(item.header);
+    auto* header = DataRefUtils::getHeader<DataProcessingHeader*>(item);
     if (header == nullptr) {
       continue;
     }
@@ -1329,7 +1351,7 @@ auto calculateTotalInputRecordSize(InputRecord const& record) -> int
 {
   size_t totalInputSize = 0;
   for (auto& item : record) {
-    auto* header = o2::header::get<DataHeader*>(item.header);
+    auto* header = DataRefUtils::getHeader<DataHeader*>(item);
     if (header == nullptr) {
       continue;
     }
@@ -1407,7 +1429,8 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
         headerptr = static_cast<char const*>(headerMsg->GetData());
         payloadptr = payloadMsg ? static_cast<char const*>(payloadMsg->GetData()) : nullptr;
         payloadSize = payloadMsg ? payloadMsg->GetSize() : 0;
-        return DataRef{nullptr, headerptr, payloadptr, payloadSize};
+        auto const& decoded = currentSetOfInputs[i].associatedDecodedHeader(partindex);
+        return DataRef{nullptr, headerptr, payloadptr, payloadSize, decoded.dataHeader, decoded.processingHeader};
       }
       return DataRef{};
     };
@@ -1518,12 +1541,12 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
         continue;
       }
 
-      auto dh = o2::header::get<DataHeader*>(input.header);
+      auto dh = DataRefUtils::getHeader<DataHeader*>(input);
       if (!dh) {
         reportError("Header is not a DataHeader?");
         continue;
       }
-      auto dph = o2::header::get<DataProcessingHeader*>(input.header);
+      auto dph = DataRefUtils::getHeader<DataProcessingHeader*>(input);
       if (!dph) {
         reportError("Header stack does not contain DataProcessingHeader");
         continue;
@@ -1725,6 +1748,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       }
     };
 
+    O2_SIGNPOST_START(DataProcessingSignpost::DISPATCH, action.slot.index, (int)action.op, 0, O2_SIGNPOST_GREEN);
     if ((context.deviceContext->state->tracingFlags & DeviceState::LoopReason::TRACE_USERCODE) != 0) {
       context.deviceContext->state->severityStack.push_back((int)fair::Logger::GetConsoleSeverity());
       fair::Logger::SetConsoleSeverity(fair::Severity::trace);
@@ -1750,6 +1774,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       fair::Logger::SetConsoleSeverity((fair::Severity)context.deviceContext->state->severityStack.back());
       context.deviceContext->state->severityStack.pop_back();
     }
+    O2_SIGNPOST_END(DataProcessingSignpost::DISPATCH, action.slot.index, (int)action.op, context.timingInfo->timeslice, O2_SIGNPOST_GREEN);
 
     postUpdateStats(action, record, tStart);
     // We forward inputs only when we consume them. If we simply Process them,
@@ -44,6 +44,14 @@ enum struct DriverStatus : uint32_t {
   BUFFER_OVERFLOWS = 2
 };
 
+/// Intervals around the steps of the processing of a timeslice
+enum struct DataProcessingSignpost : uint32_t {
+  RELAY = 4,
+  GET_READY_TO_PROCESS = 5,
+  DISPATCH = 6,
+  SEND = 7
+};
+
 } // namespace framework
 } // namespace o2
 
@@ -177,10 +177,13 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
         if (partial[idx].size() > 0 && partial[idx].header(part).get()) {
           auto header = partial[idx].header(part).get();
           auto payload = partial[idx].payload(part).get();
+          auto const& decoded = partial[idx].decodedHeader(part);
           return DataRef{nullptr,
                          reinterpret_cast<const char*>(header->GetData()),
                          reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
-                         payload ? payload->GetSize() : 0};
+                         payload ? payload->GetSize() : 0,
+                         decoded.dataHeader,
+                         decoded.processingHeader};
         }
         return DataRef{};
       };
@@ -260,8 +263,9 @@ DataRelayer::RelayChoice
                      size_t nMessages,
                      size_t nPayloads)
 {
-  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
   DataProcessingHeader const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
+  O2_SIGNPOST_SCOPE(DataProcessingSignpost::RELAY, dph->startTime, nMessages, nPayloads, O2_SIGNPOST_BLUE);
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
   // STATE HOLDING VARIABLES
   // This is the class level state of the relaying. If we start supporting
   // multithreading this will have to be made thread safe before we can invoke
@@ -509,6 +513,7 @@ DataRelayer::RelayChoice
 void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& completed)
 {
   LOGP(debug, "DataRelayer::getReadyToProcess");
+  O2_SIGNPOST_SCOPE(DataProcessingSignpost::GET_READY_TO_PROCESS, 0, completed.size(), 0, O2_SIGNPOST_BLUE);
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
   // THE STATE
@@ -573,10 +578,13 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
       if (partial[idx].size() > 0 && partial[idx].header(part).get()) {
         auto header = partial[idx].header(part).get();
         auto payload = partial[idx].payload(part).get();
+        auto const& decoded = partial[idx].decodedHeader(part);
         return DataRef{nullptr,
                        reinterpret_cast<const char*>(header->GetData()),
                        reinterpret_cast<char const*>(payload ? payload->GetData() : nullptr),
-                       payload ? payload->GetSize() : 0};
+                       payload ? payload->GetSize() : 0,
+                       decoded.dataHeader,
+                       decoded.processingHeader};
       }
       return DataRef{};
     };
@@ -17,6 +17,8 @@
 #include "Framework/Monitoring.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/LifetimeHelpers.h"
+#include "Framework/Signpost.h"
+#include "DataProcessingStatus.h"
 
 #include <fairmq/Device.h>
 
@@ -76,6 +78,7 @@ std::unique_ptr<FairMQMessage> DataSender::create(RouteIndex routeIndex)
 
 void DataSender::send(FairMQParts& parts, ChannelIndex channelIndex)
 {
+  O2_SIGNPOST_SCOPE(DataProcessingSignpost::SEND, channelIndex.value, parts.Size(), 0, O2_SIGNPOST_ORANGE);
   mPolicy.send(mProxy, parts, channelIndex);
 }
 
@@ -174,29 +174,10 @@ size_t DeviceMetricsHelper::bookMetricInfo(DeviceMetricsInfo& info, char const*
   return metricIndex;
 }
 
-bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
-                                        DeviceMetricsInfo& info,
-                                        DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
+size_t DeviceMetricsHelper::findOrBookMetric(ParsedMetricMatch& match,
+                                            DeviceMetricsInfo& info,
+                                            DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
 {
-  // get the type
-  size_t metricIndex = -1;
-
-  StringMetric stringValue;
-  switch (match.type) {
-    case MetricType::Float:
-    case MetricType::Int:
-    case MetricType::Uint64:
-      break;
-    case MetricType::String: {
-      auto lastChar = std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1);
-      memcpy(stringValue.data, match.beginStringValue, lastChar);
-      stringValue.data[lastChar] = '\0';
-    } break;
-    default:
-      return false;
-      break;
-  };
-
   // Find the metric based on the label. Create it if not found.
   auto cmpFn = [namePtr = match.beginKey,
                 &labels = info.metricLabels,
@@ -209,71 +190,76 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
                              MetricLabelIndex{},
                              cmpFn);
 
-  // We could not find the metric, lets insert a new one.
+  // Found, nothing else to do.
   auto matchSize = match.endKey - match.beginKey;
-  if (mi == info.metricLabelsAlphabeticallySortedIdx.end() || (strncmp(info.metricLabels[mi->index].label, match.beginKey, std::min(matchSize, (long)MetricLabel::MAX_METRIC_LABEL_SIZE - 1)) != 0)) {
-    // Create a new metric
-    MetricInfo metricInfo;
-    metricInfo.pos = 0;
-    metricInfo.type = match.type;
-    metricInfo.filledMetrics = 0;
-    // Add a new empty buffer for it of the correct kind
-    switch (match.type) {
-      case MetricType::Int:
-        metricInfo.storeIdx = info.intMetrics.size();
-        info.intMetrics.emplace_back(std::array<int, 1024>{});
-        break;
-      case MetricType::String:
-        metricInfo.storeIdx = info.stringMetrics.size();
-        info.stringMetrics.emplace_back(std::array<StringMetric, 32>{});
-        break;
-      case MetricType::Float:
-        metricInfo.storeIdx = info.floatMetrics.size();
-        info.floatMetrics.emplace_back(std::array<float, 1024>{});
-        break;
-      case MetricType::Uint64:
-        metricInfo.storeIdx = info.uint64Metrics.size();
-        info.uint64Metrics.emplace_back(std::array<uint64_t, 1024>{});
-        break;
+  if (mi != info.metricLabelsAlphabeticallySortedIdx.end() && (strncmp(info.metricLabels[mi->index].label, match.beginKey, std::min(matchSize, (long)MetricLabel::MAX_METRIC_LABEL_SIZE - 1)) == 0)) {
+    return mi->index;
+  }
 
-      default:
-        return false;
-    };
-    // Add the timestamp buffer for it
-    info.timestamps.emplace_back(std::array<size_t, 1024>{});
-    info.max.push_back(std::numeric_limits<float>::lowest());
-    info.min.push_back(std::numeric_limits<float>::max());
-    info.average.push_back(0);
-    info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
-    info.minDomain.push_back(std::numeric_limits<size_t>::max());
-    info.changed.push_back(false);
+  // We could not find the metric, lets insert a new one.
+  MetricInfo metricInfo;
+  metricInfo.pos = 0;
+  metricInfo.type = match.type;
+  metricInfo.filledMetrics = 0;
+  // Add a new empty buffer for it of the correct kind
+  switch (match.type) {
+    case MetricType::Int:
+      metricInfo.storeIdx = info.intMetrics.size();
+      info.intMetrics.emplace_back(std::array<int, 1024>{});
+      break;
+    case MetricType::String:
+      metricInfo.storeIdx = info.stringMetrics.size();
+      info.stringMetrics.emplace_back(std::array<StringMetric, 32>{});
+      break;
+    case MetricType::Float:
+      metricInfo.storeIdx = info.floatMetrics.size();
+      info.floatMetrics.emplace_back(std::array<float, 1024>{});
+      break;
+    case MetricType::Uint64:
+      metricInfo.storeIdx = info.uint64Metrics.size();
+      info.uint64Metrics.emplace_back(std::array<uint64_t, 1024>{});
+      break;
 
-    // Add the index by name in the correct position
-    // this will require moving the tail of the index,
-    // but inserting should happen only once for each metric,
-    // so who cares.
-    MetricLabel metricLabel;
-    auto lastChar = std::min(match.endKey - match.beginKey, (ptrdiff_t)MetricLabel::MAX_METRIC_LABEL_SIZE - 1);
-    memcpy(metricLabel.label, match.beginKey, lastChar);
-    metricLabel.label[lastChar] = '\0';
-    metricLabel.size = lastChar;
-    MetricLabelIndex metricLabelIdx;
-    metricLabelIdx.index = info.metrics.size();
-    info.metricLabels.push_back(metricLabel);
-    info.metricLabelsAlphabeticallySortedIdx.insert(mi, metricLabelIdx);
-    // Add the the actual Metric info to the store
-    metricIndex = info.metrics.size();
-    assert(metricInfo.storeIdx != -1);
-    assert(metricLabel.label[0] != '\0');
-    if (newMetricsCallback != nullptr) {
-      newMetricsCallback(metricLabel.label, metricInfo, match.intValue, metricIndex);
-    }
-    info.metrics.push_back(metricInfo);
-  } else {
-    metricIndex = mi->index;
+    default:
+      return -1;
+  };
+  // Add the timestamp buffer for it
+  info.timestamps.emplace_back(std::array<size_t, 1024>{});
+  info.max.push_back(std::numeric_limits<float>::lowest());
+  info.min.push_back(std::numeric_limits<float>::max());
+  info.average.push_back(0);
+  info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
+  info.minDomain.push_back(std::numeric_limits<size_t>::max());
+  info.changed.push_back(false);
+
+  // Add the index by name in the correct position
+  // this will require moving the tail of the index,
+  // but inserting should happen only once for each metric,
+  // so who cares.
+  MetricLabel metricLabel;
+  auto lastChar = std::min(match.endKey - match.beginKey, (ptrdiff_t)MetricLabel::MAX_METRIC_LABEL_SIZE - 1);
+  memcpy(metricLabel.label, match.beginKey, lastChar);
+  metricLabel.label[lastChar] = '\0';
+  metricLabel.size = lastChar;
+  MetricLabelIndex metricLabelIdx;
+  metricLabelIdx.index = info.metrics.size();
+  info.metricLabels.push_back(metricLabel);
+  info.metricLabelsAlphabeticallySortedIdx.insert(mi, metricLabelIdx);
+  // Add the the actual Metric info to the store
+  size_t metricIndex = info.metrics.size();
+  assert(metricInfo.storeIdx != -1);
+  assert(metricLabel.label[0] != '\0');
+  if (newMetricsCallback != nullptr) {
+    newMetricsCallback(metricLabel.label, metricInfo, match.intValue, metricIndex);
   }
-  assert(metricIndex != -1);
-  // We are now guaranteed our metric is present at metricIndex.
+  info.metrics.push_back(metricInfo);
+  return metricIndex;
+}
+
+bool DeviceMetricsHelper::storeMetric(size_t metricIndex,
+                                      ParsedMetricMatch& match,
+                                      DeviceMetricsInfo& info)
+{
   MetricInfo& metricInfo = info.metrics[metricIndex];
 
   //  auto mod = info.timestamps[metricIndex].size();
@@ -284,7 +270,10 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
       sizeOfCollection = info.intMetrics[metricInfo.storeIdx].size();
     } break;
     case MetricType::String: {
-      info.stringMetrics[metricInfo.storeIdx][metricInfo.pos] = stringValue;
+      auto& stringValue = info.stringMetrics[metricInfo.storeIdx][metricInfo.pos];
+      auto lastChar = match.type == MetricType::String ? std::min(match.endStringValue - match.beginStringValue, StringMetric::MAX_SIZE - 1) : 0;
+      memcpy(stringValue.data, match.beginStringValue, lastChar);
+      stringValue.data[lastChar] = '\0';
       sizeOfCollection = info.stringMetrics[metricInfo.storeIdx].size();
     } break;
     case MetricType::Float: {
@@ -319,6 +308,29 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   return true;
 }
 
+bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
+                                        DeviceMetricsInfo& info,
+                                        DeviceMetricsHelper::NewMetricCallback newMetricsCallback)
+{
+  switch (match.type) {
+    case MetricType::Float:
+    case MetricType::Int:
+    case MetricType::Uint64:
+    case MetricType::String:
+      break;
+    default:
+      return false;
+      break;
+  };
+
+  size_t metricIndex = findOrBookMetric(match, info, newMetricsCallback);
+  if (metricIndex == (size_t)-1) {
+    return false;
+  }
+  // We are now guaranteed our metric is present at metricIndex.
+  return storeMetric(metricIndex, match, info);
+}
+
 size_t DeviceMetricsHelper::metricIdxByName(const std::string& name, const DeviceMetricsInfo& info)
 {
   size_t i = 0;
@@ -0,0 +1,198 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DeviceMetricsRing.h"
+#include "Framework/Logger.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace o2::framework
+{
+
+static_assert((DeviceMetricsRing::CAPACITY & (DeviceMetricsRing::CAPACITY - 1)) == 0, "Capacity must be a power of 2");
+
+DeviceMetricsRing* DeviceMetricsRing::init(void* buffer)
+{
+  auto* ring = reinterpret_cast<DeviceMetricsRing*>(buffer);
+  new (&ring->nLabels) std::atomic<uint32_t>(0);
+  new (&ring->head) std::atomic<uint64_t>(0);
+  new (&ring->tail) std::atomic<uint64_t>(0);
+  for (size_t i = 0; i < CAPACITY; ++i) {
+    new (&ring->entries[i].sequence) std::atomic<uint64_t>(i);
+  }
+  ring->magic = MAGIC;
+  return ring;
+}
+
+DeviceMetricsRing* DeviceMetricsRing::createShared(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    LOGP(warning, "Unable to create metrics ring {}: {}", name, strerror(errno));
+    return nullptr;
+  }
+  if (ftruncate(fd, sizeof(DeviceMetricsRing)) != 0) {
+    LOGP(warning, "Unable to resize metrics ring {}: {}", name, strerror(errno));
+    close(fd);
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void* buffer = mmap(nullptr, sizeof(DeviceMetricsRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (buffer == MAP_FAILED) {
+    LOGP(warning, "Unable to map metrics ring {}: {}", name, strerror(errno));
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  return init(buffer);
+}
+
+DeviceMetricsRing* DeviceMetricsRing::openShared(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  void* buffer = mmap(nullptr, sizeof(DeviceMetricsRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (buffer == MAP_FAILED) {
+    return nullptr;
+  }
+  auto* ring = reinterpret_cast<DeviceMetricsRing*>(buffer);
+  if (ring->magic != MAGIC) {
+    munmap(buffer, sizeof(DeviceMetricsRing));
+    return nullptr;
+  }
+  return ring;
+}
+
+void DeviceMetricsRing::unmapShared(DeviceMetricsRing* ring)
+{
+  if (ring) {
+    munmap(ring, sizeof(DeviceMetricsRing));
+  }
+}
+
+void DeviceMetricsRing::unlinkShared(std::string const& name)
+{
+  shm_unlink(name.c_str());
+}
+
+bool DeviceMetricsRingWriter::intern(std::string_view name, uint32_t& id)
+{
+  std::lock_guard<std::mutex> lock(mNamesMutex);
+  auto it = mIds.find(std::string(name));
+  if (it != mIds.end()) {
+    id = it->second;
+    return true;
+  }
+  auto nLabels = mRing->nLabels.load(std::memory_order_relaxed);
+  if (nLabels >= DeviceMetricsRing::MAX_LABELS) {
+    return false;
+  }
+  auto& label = mRing->labels[nLabels];
+  auto size = std::min(name.size(), MetricLabel::MAX_METRIC_LABEL_SIZE - 1);
+  memcpy(label.label, name.data(), size);
+  label.label[size] = '\0';
+  label.size = size;
+  // The label must be visible before any entry using it.
+  mRing->nLabels.store(nLabels + 1, std::memory_order_release);
+  mIds.emplace(name, nLabels);
+  id = nLabels;
+  return true;
+}
+
+DeviceMetricsRing::Entry* DeviceMetricsRingWriter::reserve()
+{
+  auto pos = mRing->head.load(std::memory_order_relaxed);
+  while (true) {
+    auto& entry = mRing->entries[pos & (DeviceMetricsRing::CAPACITY - 1)];
+    auto sequence = entry.sequence.load(std::memory_order_acquire);
+    auto diff = (int64_t)sequence - (int64_t)pos;
+    if (diff == 0) {
+      if (mRing->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return &entry;
+      }
+    } else if (diff < 0) {
+      // The consumer did not free this slot yet.
+      return nullptr;
+    } else {
+      pos = mRing->head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+size_t DeviceMetricsRingReader::consume(DeviceMetricsInfo& info, DeviceMetricsHelper::NewMetricCallback newMetricCallback)
+{
+  auto pos = mRing->tail.load(std::memory_order_relaxed);
+  size_t count = 0;
+  while (true) {
+    auto& entry = mRing->entries[pos & (DeviceMetricsRing::CAPACITY - 1)];
+    if (entry.sequence.load(std::memory_order_acquire) != pos + 1) {
+      break;
+    }
+    ParsedMetricMatch match;
+    match.type = entry.type;
+    match.timestamp = entry.timestamp;
+    switch (entry.type) {
+      case MetricType::Int:
+        match.intValue = entry.intValue;
+        match.floatValue = (float)entry.intValue;
+        break;
+      case MetricType::Float:
+        match.intValue = 0;
+        match.floatValue = entry.floatValue;
+        break;
+      case MetricType::Uint64:
+        match.intValue = 0;
+        match.uint64Value = entry.uint64Value;
+        match.floatValue = (float)entry.uint64Value;
+        break;
+      default:
+        break;
+    }
+    auto id = entry.id;
+    // Free the slot for the producers
+    entry.sequence.store(pos + DeviceMetricsRing::CAPACITY, std::memory_order_release);
+    ++pos;
+
+    if (id >= mRing->nLabels.load(std::memory_order_acquire)) {
+      continue;
+    }
+    if (id >= mMetricIndices.size()) {
+      mMetricIndices.resize(id + 1, -1);
+    }
+    // The first time we see an id we do the lookup by name, which also
+    // creates the metric if needed.
+    if (mMetricIndices[id] == (size_t)-1) {
+      auto& label = mRing->labels[id];
+      match.beginKey = label.label;
+      match.endKey = label.label + label.size;
+      mMetricIndices[id] = DeviceMetricsHelper::findOrBookMetric(match, info, newMetricCallback);
+      if (mMetricIndices[id] == (size_t)-1) {
+        continue;
+      }
+    }
+    if (DeviceMetricsHelper::storeMetric(mMetricIndices[id], match, info)) {
+      ++count;
+    }
+  }
+  mRing->tail.store(pos, std::memory_order_relaxed);
+  return count;
+}
+
+} // namespace o2::framework
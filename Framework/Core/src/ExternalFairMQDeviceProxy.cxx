@@ -438,10 +438,11 @@ DataProcessorSpec specifyExternalFairMQDeviceProxy(char const* name,
       }
     };
 
-    auto runHandler = [dataHandler, channel, minSHM](ProcessingContext& ctx) {
-      static RateLimiter limiter;
+    auto limiter = std::make_shared<RateLimiter>();
+    limiter->setAdaptive(ctx.options().get<bool>("timeframes-rate-limit-adaptive"));
+    auto runHandler = [dataHandler, channel, minSHM, limiter](ProcessingContext& ctx) {
       auto device = ctx.services().get<RawDeviceService>().device();
-      limiter.check(ctx, std::stoi(device->fConfig->GetValue<std::string>("timeframes-rate-limit")), minSHM);
+      limiter->check(ctx, std::stoi(device->fConfig->GetValue<std::string>("timeframes-rate-limit")), minSHM);
 
       FairMQParts parts;
       device->Receive(parts, channel, 0);
@@ -467,7 +468,8 @@ DataProcessorSpec specifyExternalFairMQDeviceProxy(char const* name,
   }};
   const char* d = strdup(((std::string(defaultChannelConfig).find("name=") == std::string::npos ? (std::string("name=") + name + ",") : "") + std::string(defaultChannelConfig)).c_str());
   spec.options = {
-    ConfigParamSpec{"channel-config", VariantType::String, d, {"Out-of-band channel config"}}};
+    ConfigParamSpec{"channel-config", VariantType::String, d, {"Out-of-band channel config"}},
+    ConfigParamSpec{"timeframes-rate-limit-adaptive", VariantType::Bool, false, {"Adapt the number of timeframes in flight to the latency and the free SHM, timeframes-rate-limit being the maximum"}}};
   return spec;
 }
 
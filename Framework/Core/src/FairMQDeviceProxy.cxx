@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/FairMQDeviceProxy.h"
+#include "Framework/OutputBufferPool.h"
 
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/Channel.h>
@@ -18,6 +19,14 @@
 namespace o2::framework
 {
 
+FairMQDeviceProxy::FairMQDeviceProxy() = default;
+FairMQDeviceProxy::~FairMQDeviceProxy() = default;
+
+void FairMQDeviceProxy::setOutputBufferPool(std::unique_ptr<OutputBufferPool> pool)
+{
+  mOutputBufferPool = std::move(pool);
+}
+
 ChannelIndex FairMQDeviceProxy::getChannelIndex(RouteIndex index) const
 {
   assert(mRoutes.size());
@@ -49,7 +58,13 @@ std::unique_ptr<FairMQMessage> FairMQDeviceProxy::createMessage(RouteIndex route
 
 std::unique_ptr<FairMQMessage> FairMQDeviceProxy::createMessage(RouteIndex routeIndex, const size_t size) const
 {
-  return getTransport(routeIndex)->CreateMessage(size, fair::mq::Alignment{64});
+  auto* transport = getTransport(routeIndex);
+  if (mOutputBufferPool) {
+    if (auto message = mOutputBufferPool->getMessage(transport, size)) {
+      return message;
+    }
+  }
+  return transport->CreateMessage(size, fair::mq::Alignment{64});
 }
 
 void FairMQDeviceProxy::bindRoutes(std::vector<OutputRoute> const& outputs, fair::mq::Device& device)
@@ -10,10 +10,19 @@
 // or submit itself to any jurisdiction.
 
 #include "FairMQResizableBuffer.h"
+#include "Framework/CompilerBuiltins.h"
+#include "Framework/TableConsumer.h"
 #include <fairmq/FairMQMessage.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
 #include <arrow/status.h>
+#include <arrow/table.h>
 #include <arrow/util/config.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 namespace arrow::io::internal
 {
@@ -85,7 +94,10 @@ Status FairMQOutputStream::Write(const void* data, int64_t nbytes)
     if (ARROW_PREDICT_FALSE(position_ + nbytes >= capacity_)) {
       RETURN_NOT_OK(Reserve(nbytes));
     }
-    memcpy(mutable_data_ + position_, data, nbytes);
+    if (data != mutable_data_ + position_) {
+      memcpy(mutable_data_ + position_, data, nbytes);
+      copied_ += nbytes;
+    }
     position_ += nbytes;
   }
   return Status::OK();
@@ -170,4 +182,203 @@ std::unique_ptr<FairMQMessage> FairMQResizableBuffer::Finalise()
   return std::move(mMessage);
 }
 
+void FairMQResizableBuffer::adopt(std::unique_ptr<FairMQMessage> message)
+{
+  mMessage = std::move(message);
+  this->data_ = reinterpret_cast<uint8_t*>(mMessage->GetData());
+  this->capacity_ = static_cast<int64_t>(mMessage->GetSize());
+  this->size_ = 0;
+}
+
+namespace
+{
+// Arrow expects allocations aligned to 64 bytes and a valid pointer for
+// empty ones.
+constexpr int64_t kPoolAlignment = 64;
+alignas(kPoolAlignment) uint8_t zeroSizeArea[1];
+} // namespace
+
+FairMQMemoryPool::FairMQMemoryPool(Creator creator)
+  : mCreator{creator}
+{
+}
+
+FairMQMemoryPool::~FairMQMemoryPool() = default;
+
+arrow::Status FairMQMemoryPool::Allocate(int64_t size, uint8_t** out)
+{
+  if (size == 0) {
+    *out = zeroSizeArea;
+    return arrow::Status::OK();
+  }
+  std::unique_ptr<FairMQMessage> message;
+  try {
+    message = mCreator(size + kPoolAlignment - 1);
+  } catch (std::exception& e) {
+    return arrow::Status::OutOfMemory("Unable to create message of ", size, " bytes: ", e.what());
+  }
+  if (!message || message->GetData() == nullptr) {
+    return arrow::Status::OutOfMemory("Unable to create message of ", size, " bytes");
+  }
+  auto address = reinterpret_cast<uintptr_t>(message->GetData());
+  *out = reinterpret_cast<uint8_t*>((address + kPoolAlignment - 1) & ~(kPoolAlignment - 1));
+  mAllocations.emplace(*out, Allocation{std::move(message), size});
+  mBytesAllocated += size;
+  mMaxMemory = std::max(mMaxMemory, mBytesAllocated);
+  return arrow::Status::OK();
+}
+
+arrow::Status FairMQMemoryPool::Reallocate(int64_t oldSize, int64_t newSize, uint8_t** ptr)
+{
+  auto allocation = mAllocations.find(*ptr);
+  if (allocation != mAllocations.end()) {
+    auto available = static_cast<int64_t>(allocation->second.message->GetSize()) - (*ptr - static_cast<uint8_t*>(allocation->second.message->GetData()));
+    if (newSize <= available) {
+      mBytesAllocated += newSize - allocation->second.size;
+      mMaxMemory = std::max(mMaxMemory, mBytesAllocated);
+      allocation->second.size = newSize;
+      return arrow::Status::OK();
+    }
+  }
+  uint8_t* out = nullptr;
+  RETURN_NOT_OK(Allocate(newSize, &out));
+  memcpy(out, *ptr, std::min(oldSize, newSize));
+  Free(*ptr, oldSize);
+  *ptr = out;
+  return arrow::Status::OK();
+}
+
+void FairMQMemoryPool::Free(uint8_t* buffer, int64_t)
+{
+  auto allocation = mAllocations.find(buffer);
+  if (allocation == mAllocations.end()) {
+    // empty or already released
+    return;
+  }
+  mBytesAllocated -= allocation->second.size;
+  mAllocations.erase(allocation);
+}
+
+std::map<uint8_t const*, FairMQMemoryPool::Allocation>::const_iterator FairMQMemoryPool::find(uint8_t const* ptr) const
+{
+  auto allocation = mAllocations.upper_bound(ptr);
+  if (allocation == mAllocations.begin()) {
+    return mAllocations.end();
+  }
+  --allocation;
+  if (ptr >= allocation->first + allocation->second.size) {
+    return mAllocations.end();
+  }
+  return allocation;
+}
+
+int64_t FairMQMemoryPool::offsetInMessage(uint8_t const* ptr) const
+{
+  auto allocation = find(ptr);
+  if (allocation == mAllocations.end()) {
+    return -1;
+  }
+  return ptr - static_cast<uint8_t const*>(allocation->second.message->GetData());
+}
+
+std::unique_ptr<FairMQMessage> FairMQMemoryPool::release(uint8_t const* ptr)
+{
+  auto allocation = find(ptr);
+  if (allocation == mAllocations.end()) {
+    return nullptr;
+  }
+  auto node = mAllocations.extract(allocation);
+  mBytesAllocated -= node.mapped().size;
+  return std::move(node.mapped().message);
+}
+
+int64_t doWriteTable(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table* table)
+{
+  auto mock = std::make_shared<arrow::io::MockOutputStream>();
+  int64_t expectedSize = 0;
+  auto mockWriter = arrow::ipc::MakeStreamWriter(mock.get(), table->schema());
+  arrow::Status outStatus;
+  if (O2_BUILTIN_LIKELY(table->num_rows() != 0)) {
+    outStatus = mockWriter.ValueOrDie()->WriteTable(*table);
+  } else {
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    columns.resize(table->columns().size());
+    for (size_t ci = 0; ci < table->columns().size(); ci++) {
+      columns[ci] = table->column(ci)->chunk(0);
+    }
+    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
+    outStatus = mockWriter.ValueOrDie()->WriteRecordBatch(*batch);
+  }
+
+  expectedSize = mock->Tell().ValueOrDie();
+  auto reserve = b->Reserve(expectedSize);
+  if (reserve.ok() == false) {
+    throw std::runtime_error("Unable to reserve memory for table");
+  }
+
+  auto stream = std::make_shared<FairMQOutputStream>(b);
+  auto outBatch = arrow::ipc::MakeStreamWriter(stream.get(), table->schema());
+  if (outBatch.ok() == false) {
+    throw ::std::runtime_error("Unable to create batch writer");
+  }
+
+  if (O2_BUILTIN_UNLIKELY(table->num_rows() == 0)) {
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    columns.resize(table->columns().size());
+    for (size_t ci = 0; ci < table->columns().size(); ci++) {
+      columns[ci] = table->column(ci)->chunk(0);
+    }
+    auto batch = arrow::RecordBatch::Make(table->schema(), 0, columns);
+    outStatus = outBatch.ValueOrDie()->WriteRecordBatch(*batch);
+  } else {
+    outStatus = outBatch.ValueOrDie()->WriteTable(*table);
+  }
+
+  if (outStatus.ok() == false) {
+    throw std::runtime_error("Unable to Write table");
+  }
+  return stream->copied();
+}
+
+int64_t doWriteTableInPlace(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table const& table,
+                            FairMQMemoryPool& pool, uint8_t const* body, int64_t bodySize)
+{
+  auto bodyOffset = pool.offsetInMessage(body);
+  if (bodyOffset < 0 || table.num_rows() == 0) {
+    return -1;
+  }
+  // The metadata written by Arrow in front of the body only depends on the
+  // schema and on the size of the buffers, so the stream is started where
+  // it makes the body land on the columns already in the message.
+  auto mock = std::make_shared<arrow::io::MockOutputStream>();
+  auto mockWriter = arrow::ipc::MakeStreamWriter(mock.get(), table.schema());
+  if (mockWriter.ok() == false || mockWriter.ValueOrDie()->WriteTable(table).ok() == false) {
+    return -1;
+  }
+  auto streamOffset = bodyOffset - (mock->Tell().ValueOrDie() - bodySize);
+  if (streamOffset < (int64_t)sizeof(InPlaceTableHeader)) {
+    return -1;
+  }
+
+  b->adopt(pool.release(body));
+  auto stream = std::make_shared<FairMQOutputStream>(b);
+  std::vector<uint8_t> prefix(streamOffset, 0);
+  InPlaceTableHeader header;
+  header.streamOffset = streamOffset;
+  memcpy(prefix.data(), &header, sizeof(header));
+  auto outStatus = stream->Write(prefix.data(), prefix.size());
+  auto outBatch = arrow::ipc::MakeStreamWriter(stream.get(), table.schema());
+  if (outStatus.ok() == false || outBatch.ok() == false) {
+    throw ::std::runtime_error("Unable to create batch writer");
+  }
+  outStatus = outBatch.ValueOrDie()->WriteTable(table);
+  if (outStatus.ok() == false) {
+    throw std::runtime_error("Unable to Write table");
+  }
+  if (stream->Tell().ValueOrDie() != bodyOffset + bodySize) {
+    throw std::runtime_error("Table persisted in place does not match its Arrow IPC layout");
+  }
+  return stream->copied();
+}
+
 } // namespace o2::framework
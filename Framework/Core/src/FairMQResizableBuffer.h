@@ -14,13 +14,20 @@
 
 #include <memory>
 #include <functional>
+#include <map>
 #include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
 #include "arrow/io/interfaces.h"
 #include "arrow/status.h"
 #include "arrow/util/future.h"
 
 #include <fairmq/FwdDecls.h>
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -69,6 +76,10 @@ class FairMQOutputStream : public OutputStream
   Status Reset(int64_t initial_capacity = 1024, MemoryPool* pool = default_memory_pool());
 
   int64_t capacity() const { return capacity_; }
+  /// Bytes actually copied to the buffer. Writes of data which is already
+  /// at the current position, as for the columns of a table persisted in
+  /// place, are skipped.
+  int64_t copied() const { return copied_; }
 
  private:
   FairMQOutputStream();
@@ -81,12 +92,14 @@ class FairMQOutputStream : public OutputStream
   int64_t capacity_;
   int64_t position_;
   uint8_t* mutable_data_;
+  int64_t copied_ = 0;
 };
 
 /// An arrow::ResizableBuffer implemented on top of a FairMQMessage
 /// FIXME: this is an initial attempt to integrate arrow and FairMQ
 /// a proper solution probably involves writing a `arrow::MemoryPool`
-/// using a `FairMQUnmanagedRegion`. This will come at a later stage.
+/// using a `FairMQUnmanagedRegion`. See FairMQMemoryPool for the tables
+/// persisted in place.
 class FairMQResizableBuffer : public ::arrow::ResizableBuffer
 {
  public:
@@ -113,12 +126,69 @@ class FairMQResizableBuffer : public ::arrow::ResizableBuffer
   /// in order to use it again.
   std::unique_ptr<FairMQMessage> Finalise();
 
+  /// Use @a message as backing store, with size 0 and the message size as
+  /// capacity, so that what is already in it is kept when writing.
+  void adopt(std::unique_ptr<FairMQMessage> message);
+
  private:
   std::unique_ptr<FairMQMessage> mMessage;
   int64_t mSize;
   Creator mCreator;
 };
 
+/// An arrow::MemoryPool where each allocation is a FairMQMessage, which
+/// can be taken out of the pool and sent, so that the data allocated in it
+/// does not need to be copied to a message.
+class FairMQMemoryPool : public arrow::MemoryPool
+{
+ public:
+  using Creator = FairMQResizableBuffer::Creator;
+
+  FairMQMemoryPool(Creator);
+  ~FairMQMemoryPool() override;
+
+  arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  arrow::Status Reallocate(int64_t oldSize, int64_t newSize, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+  int64_t bytes_allocated() const override { return mBytesAllocated; }
+  int64_t max_memory() const override { return mMaxMemory; }
+  std::string backend_name() const override { return "fairmq"; }
+
+  /// @return the offset of @a ptr in the message of the allocation it
+  /// belongs to, -1 if it was not allocated by this pool.
+  int64_t offsetInMessage(uint8_t const* ptr) const;
+  /// Take ownership of the message of the allocation @a ptr belongs to.
+  /// Freeing the allocation afterwards has no effect.
+  std::unique_ptr<FairMQMessage> release(uint8_t const* ptr);
+
+ private:
+  struct Allocation {
+    std::unique_ptr<FairMQMessage> message;
+    int64_t size;
+  };
+  std::map<uint8_t const*, Allocation>::const_iterator find(uint8_t const* ptr) const;
+
+  Creator mCreator;
+  // Keyed by the (aligned) start of each allocation
+  std::map<uint8_t const*, Allocation> mAllocations;
+  int64_t mBytesAllocated = 0;
+  int64_t mMaxMemory = 0;
+};
+
+/// Write @a table to @a b as an Arrow IPC stream.
+/// @return the number of bytes copied to the buffer
+int64_t doWriteTable(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table* table);
+
+/// Write @a table, filled with TableBuilder::inPlacePersist using @a pool
+/// for its columns, as an Arrow IPC stream in the message holding the
+/// columns, which is then adopted by @a b. The stream is preceded by an
+/// InPlaceTableHeader, see TableConsumer.
+/// @a body is the start of the columns, @a bodySize their padded size.
+/// @return the number of bytes copied to the message, -1 if the metadata
+/// does not fit in front of the columns, in which case nothing is done.
+int64_t doWriteTableInPlace(std::shared_ptr<FairMQResizableBuffer> b, arrow::Table const& table,
+                            FairMQMemoryPool& pool, uint8_t const* body, int64_t bodySize);
+
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_FAIRMQRESIZABLEBUFFER_H_
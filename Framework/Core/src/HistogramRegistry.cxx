@@ -16,6 +16,76 @@
 namespace o2::framework
 {
 
+// fill n entries {x, weight} into a TH1, binning them ourselves for uniform axes
+void HistFiller::fillN(TH1* hist, const double* entries, int n)
+{
+  TAxis* axis = hist->GetXaxis();
+  if (axis->IsVariableBinSize() || hist->CanExtendAllAxes() || axis->TestBit(TAxis::kAxisRange) || hist->GetBuffer()) {
+    hist->FillN(n, entries, entries + 1, 2);
+    return;
+  }
+  // same as Fill(), the first weighted entry enables the storage of the sum of squares of weights
+  if (!hist->GetSumw2N() && !hist->TestBit(TH1::kIsNotW)) {
+    for (int i = 0; i < n; ++i) {
+      if (entries[2 * i + 1] != 1.) {
+        hist->Sumw2();
+        break;
+      }
+    }
+  }
+
+  // compute all the bins first, this loop has no dependency between iterations
+  const int nBins = axis->GetNbins();
+  const double xMin = axis->GetXmin();
+  const double xMax = axis->GetXmax();
+  std::vector<int> bins(n);
+  for (int i = 0; i < n; ++i) {
+    const double x = entries[2 * i];
+    bins[i] = x < xMin ? 0 : !(x < xMax) ? nBins + 1 : 1 + int(nBins * (x - xMin) / (xMax - xMin));
+  }
+
+  double stats[4]; // sum of weights, of squared weights, of weight * x and of weight * x^2
+  hist->GetStats(stats);
+  const double nEntries = hist->GetEntries();
+  const bool statOverflows = hist->GetStatOverflowsBehaviour();
+  TArrayD* sumw2 = hist->GetSumw2N() ? hist->GetSumw2() : nullptr;
+  // accumulate per bin locally unless the histogram is much larger than the number of entries
+  const bool accumulate = nBins + 2 <= n;
+  std::vector<double> content(accumulate ? nBins + 2 : 0);
+  for (int i = 0; i < n; ++i) {
+    const int bin = bins[i];
+    const double x = entries[2 * i];
+    const double w = entries[2 * i + 1];
+    if (accumulate) {
+      content[bin] += w;
+    } else {
+      hist->AddBinContent(bin, w);
+    }
+    if (sumw2) {
+      sumw2->fArray[bin] += w * w;
+    }
+    if (statOverflows || (bin > 0 && bin <= nBins)) {
+      stats[0] += w;
+      stats[1] += w * w;
+      stats[2] += w * x;
+      stats[3] += w * x * x;
+    }
+  }
+  for (int bin = 0; accumulate && bin < nBins + 2; ++bin) {
+    if (content[bin] != 0.) {
+      hist->AddBinContent(bin, content[bin]);
+    }
+  }
+  hist->PutStats(stats);
+  hist->SetEntries(nEntries + n);
+}
+
+// fill n entries {x, y, weight} into a TH2
+void HistFiller::fillN(TH2* hist, const double* entries, int n)
+{
+  hist->FillN(n, entries, entries + 1, entries + 2, 3);
+}
+
 constexpr HistogramRegistry::HistName::HistName(char const* const name)
   : str(name),
     hash(compile_time_hash(name)),
@@ -112,6 +182,7 @@ HistPtr HistogramRegistry::add(char const* const name, char const* const title,
 // store a copy of an existing histogram (or group of histograms) under a different name
 void HistogramRegistry::addClone(const std::string& source, const std::string& target)
 {
+  flush();
   auto doInsertClone = [&](const auto& sharedPtr) {
     if (!sharedPtr.get()) {
       return;
@@ -138,6 +209,36 @@ void HistogramRegistry::addClone(const std::string& source, const std::string& t
   }
 }
 
+void HistogramRegistry::setFillBufferSize(uint32_t nEntries)
+{
+  flush();
+  mFillBufferSize = nEntries;
+  for (auto& buffer : mFillBuffers) {
+    buffer.shrink_to_fit();
+  }
+}
+
+void HistogramRegistry::flush()
+{
+  for (auto idx = 0u; idx < MAX_REGISTRY_SIZE; ++idx) {
+    flush(idx);
+  }
+}
+
+void HistogramRegistry::flush(uint32_t idx)
+{
+  auto& buffer = mFillBuffers[idx];
+  if (buffer.empty()) {
+    return;
+  }
+  if (auto hist = std::get_if<std::shared_ptr<TH1>>(&mRegistryValue[idx])) {
+    HistFiller::fillN(hist->get(), buffer.data(), buffer.size() / 2);
+  } else if (auto hist = std::get_if<std::shared_ptr<TH2>>(&mRegistryValue[idx])) {
+    HistFiller::fillN(hist->get(), buffer.data(), buffer.size() / 3);
+  }
+  buffer.clear();
+}
+
 // function to query if name is already in use
 bool HistogramRegistry::contains(const HistName& histName)
 {
@@ -263,6 +364,7 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::operator*()
 {
+  flush();
   TList* list = new TList();
   list->SetName(mName.data());
 
@@ -19,8 +19,7 @@ namespace o2::framework
 
 FairMQMessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, size_t size)
 {
-  auto* transport = mProxy.getTransport(routeIndex);
-  return transport->CreateMessage(size, fair::mq::Alignment{64});
+  return mProxy.createMessage(routeIndex, size);
 }
 
 FairMQMessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, void* data, size_t size, fairmq_free_fn* ffn, void* hint)
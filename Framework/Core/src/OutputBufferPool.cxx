@@ -0,0 +1,178 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/OutputBufferPool.h"
+#include "Framework/Logger.h"
+
+#include <fairmq/FairMQTransportFactory.h>
+#include <fairmq/FairMQUnmanagedRegion.h>
+
+#include <array>
+#include <deque>
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr size_t alignTo64(size_t size)
+{
+  return (size + 63) & ~size_t{63};
+}
+} // namespace
+
+struct OutputBufferPool::Buffer {
+  char* data;
+  int sizeClass;
+  int users = 0; // messages still alive in this buffer
+};
+
+struct OutputBufferPool::Region {
+  char* base = nullptr;
+  size_t used = 0;
+  std::deque<Buffer> buffers;
+  std::array<std::vector<Buffer*>, 64> free;
+  // Last, so that it is destroyed first: FairMQ can still deliver block
+  // releases while the region goes away, and the callback uses the buffers
+  // and the free lists above.
+  FairMQUnmanagedRegionPtr region;
+};
+
+OutputBufferPool::OutputBufferPool(size_t regionSize, size_t maxBufferSize, size_t minBufferSize)
+  : mRegionSize{regionSize},
+    mMaxBufferSize{maxBufferSize ? maxBufferSize : regionSize / 16},
+    mMinBufferSize{alignTo64(minBufferSize ? minBufferSize : 64)}
+{
+}
+
+OutputBufferPool::~OutputBufferPool() = default;
+
+OutputBufferPool::Region* OutputBufferPool::getRegion(fair::mq::TransportFactory* transport)
+{
+  {
+    std::scoped_lock lock(mMutex);
+    auto it = mRegions.find(transport);
+    if (it != mRegions.end()) {
+      return it->second.get();
+    }
+  }
+  // The callback is invoked on a FairMQ thread (or directly from the message
+  // destructor, depending on the transport), so the region is created without
+  // holding the lock.
+  auto region = std::make_unique<Region>();
+  region->region = transport->CreateUnmanagedRegion(
+    mRegionSize, [this, r = region.get()](std::vector<fair::mq::RegionBlock> const& blocks) {
+      std::scoped_lock lock(mMutex);
+      for (auto& block : blocks) {
+        auto* buffer = static_cast<Buffer*>(block.hint);
+        if (--buffer->users == 0) {
+          r->free[buffer->sizeClass].push_back(buffer);
+        }
+      }
+    });
+  region->base = static_cast<char*>(region->region->GetData());
+  LOGP(info, "Created a {} MB region for the output buffer pool", mRegionSize >> 20);
+  std::scoped_lock lock(mMutex);
+  return mRegions.emplace(transport, std::move(region)).first->second.get();
+}
+
+OutputBufferPool::Buffer* OutputBufferPool::getBuffer(Region& region, size_t size)
+{
+  int sizeClass = 0;
+  while ((mMinBufferSize << sizeClass) < size) {
+    ++sizeClass;
+  }
+  auto& free = region.free[sizeClass];
+  if (!free.empty()) {
+    auto* buffer = free.back();
+    free.pop_back();
+    mStats.recycled++;
+    return buffer;
+  }
+  size_t bufferSize = mMinBufferSize << sizeClass;
+  if (region.used + bufferSize > mRegionSize) {
+    return nullptr;
+  }
+  auto& buffer = region.buffers.emplace_back(Buffer{region.base + region.used, sizeClass});
+  region.used += bufferSize;
+  return &buffer;
+}
+
+FairMQMessagePtr OutputBufferPool::getMessage(fair::mq::TransportFactory* transport, size_t size)
+{
+  if (size == 0 || size > mMaxBufferSize) {
+    std::scoped_lock lock(mMutex);
+    mStats.fallbacks++;
+    return nullptr;
+  }
+  auto* region = getRegion(transport);
+  Buffer* buffer = nullptr;
+  {
+    std::scoped_lock lock(mMutex);
+    buffer = getBuffer(*region, size);
+    if (buffer == nullptr) {
+      mStats.fallbacks++;
+      return nullptr;
+    }
+    buffer->users = 1;
+    mStats.pooled++;
+  }
+  return transport->CreateMessage(region->region, buffer->data, size, buffer);
+}
+
+std::vector<FairMQMessagePtr> OutputBufferPool::getMessages(fair::mq::TransportFactory* transport, gsl::span<size_t const> sizes)
+{
+  std::vector<FairMQMessagePtr> messages;
+  std::vector<size_t> offsets;
+  offsets.reserve(sizes.size());
+  size_t total = 0;
+  int users = 0;
+  for (auto size : sizes) {
+    offsets.push_back(total);
+    total += alignTo64(size);
+    users += size != 0;
+  }
+  if (users == 0 || total > mMaxBufferSize) {
+    std::scoped_lock lock(mMutex);
+    mStats.fallbacks++;
+    return messages;
+  }
+  auto* region = getRegion(transport);
+  Buffer* buffer = nullptr;
+  {
+    std::scoped_lock lock(mMutex);
+    buffer = getBuffer(*region, total);
+    if (buffer == nullptr) {
+      mStats.fallbacks++;
+      return messages;
+    }
+    buffer->users = users;
+    mStats.pooled += users;
+  }
+  messages.reserve(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    if (sizes[i] == 0) {
+      // not accounted as a user of the buffer, no callback for it
+      messages.push_back(transport->CreateMessage());
+    } else {
+      messages.push_back(transport->CreateMessage(region->region, buffer->data + offsets[i], sizes[i], buffer));
+    }
+  }
+  return messages;
+}
+
+OutputBufferPool::Stats OutputBufferPool::stats() const
+{
+  std::scoped_lock lock(mMutex);
+  return mStats;
+}
+
+} // namespace o2::framework
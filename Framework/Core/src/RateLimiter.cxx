@@ -13,18 +13,91 @@
 #include "Framework/RawDeviceService.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RunningWorkflowInfo.h"
+#include "Framework/Monitoring.h"
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/shmem/Monitor.h>
 #include <fairmq/shmem/Common.h>
+#include <algorithm>
+#include <chrono>
 
 using namespace o2::framework;
 
+namespace
+{
+long getFreeSHM(ProcessingContext& ctx, FairMQDevice* device)
+{
+  auto& runningWorkflow = ctx.services().get<RunningWorkflowInfo const>();
+  long freeMemory = -1;
+  try {
+    freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
+  } catch (...) {
+  }
+  if (freeMemory == -1) {
+    try {
+      freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
+    } catch (...) {
+    }
+  }
+  if (freeMemory == -1) {
+    throw std::runtime_error("Could not obtain free SHM memory");
+  }
+  return freeMemory;
+}
+
+uint64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+AdaptiveInFlightLimit::AdaptiveInFlightLimit(int maxLimit)
+  : mMaxLimit{std::max(maxLimit, 1)},
+    mSendTimes(mMaxLimit + 1)
+{
+}
+
+void AdaptiveInFlightLimit::sent(int64_t index, uint64_t now)
+{
+  mSendTimes[index % mSendTimes.size()] = now;
+  mLastSent = index;
+}
+
+void AdaptiveInFlightLimit::consumed(int64_t from, int64_t to, uint64_t now)
+{
+  for (auto index = from; index < to && index <= mLastSent; ++index) {
+    // The window only needs to grow if we are actually using all of it.
+    bool windowLimited = mLastSent - index + 1 >= limit();
+    double latency = now - mSendTimes[index % mSendTimes.size()];
+    mMinLatency = mMinLatency == 0. ? latency : std::min(latency, mMinLatency * minLatencyAging);
+    if (latency > latencyTolerance * mMinLatency) {
+      congestion(index);
+    } else if (windowLimited) {
+      mWindow += mSlowStart ? 1. : 1. / mWindow;
+      mWindow = std::min(mWindow, (double)mMaxLimit);
+    }
+  }
+}
+
+void AdaptiveInFlightLimit::congestion(int64_t index)
+{
+  if (index <= mRecoverUntil) {
+    return;
+  }
+  mSlowStart = false;
+  mWindow = std::max(1., mWindow / 2.);
+  mRecoverUntil = mLastSent;
+}
+
 void RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
 {
   if (!maxInFlight && !minSHM) {
     return;
   }
   auto device = ctx.services().get<RawDeviceService>().device();
+  if (mAdaptive && device->fChannels.count("metric-feedback")) {
+    checkAdaptive(ctx, maxInFlight, minSHM);
+    return;
+  }
   if (maxInFlight && device->fChannels.count("metric-feedback")) {
     int waitMessage = 0;
     int recvTimeot = 0;
@@ -49,23 +122,8 @@ void RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
   }
   if (minSHM) {
     int waitMessage = 0;
-    auto& runningWorkflow = ctx.services().get<RunningWorkflowInfo const>();
     while (true) {
-      long freeMemory = -1;
-      try {
-        freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
-      } catch (...) {
-      }
-      if (freeMemory == -1) {
-        try {
-          freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
-        } catch (...) {
-        }
-      }
-      if (freeMemory == -1) {
-        throw std::runtime_error("Could not obtain free SHM memory");
-      }
-      uint64_t freeSHM = freeMemory;
+      uint64_t freeSHM = getFreeSHM(ctx, device);
       if (freeSHM > minSHM) {
         if (waitMessage) {
           LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << minSHM << "), continuing to publish";
@@ -80,3 +138,61 @@ void RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
   }
   mSentTimeframes++;
 }
+
+void RateLimiter::checkAdaptive(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
+{
+  auto device = ctx.services().get<RawDeviceService>().device();
+  if (!mAdaptiveLimit) {
+    mAdaptiveLimit = maxInFlight > 0 ? std::make_unique<AdaptiveInFlightLimit>(maxInFlight) : std::make_unique<AdaptiveInFlightLimit>();
+  }
+  auto& limit = *mAdaptiveLimit;
+
+  // Feedback has to be processed as soon as it arrives, not only when we
+  // reach the limit, otherwise the latencies would be meaningless.
+  auto processFeedback = [&](int timeout) -> bool {
+    auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+    if (device->Receive(msg, "metric-feedback", 0, timeout) <= 0) {
+      return false;
+    }
+    assert(msg->GetSize() == 8);
+    auto consumed = *(int64_t*)msg->GetData();
+    limit.consumed(mConsumedTimeframes, consumed, now());
+    mConsumedTimeframes = consumed;
+    return true;
+  };
+  while (processFeedback(0)) {
+  }
+
+  if (minSHM) {
+    uint64_t freeSHM = getFreeSHM(ctx, device);
+    if (freeSHM < 2 * minSHM) {
+      limit.congestion(mConsumedTimeframes);
+    }
+    int waitMessage = 0;
+    while (freeSHM <= minSHM) {
+      if (waitMessage == 0) {
+        LOG(alarm) << "Free SHM memory too low: " << freeSHM << " < " << minSHM << ", waiting";
+        waitMessage = 1;
+      }
+      processFeedback(10);
+      freeSHM = getFreeSHM(ctx, device);
+    }
+    if (waitMessage) {
+      LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << minSHM << "), continuing to publish";
+    }
+  }
+
+  while ((mSentTimeframes - mConsumedTimeframes) >= limit.limit()) {
+    processFeedback(-1);
+  }
+
+  using o2::monitoring::Metric;
+  using o2::monitoring::tags::Key;
+  using o2::monitoring::tags::Value;
+  auto& monitoring = ctx.services().get<o2::monitoring::Monitoring>();
+  monitoring.send(Metric{limit.limit(), "timeframes-in-flight-limit"}.addTag(Key::Subsystem, Value::DPL));
+  monitoring.send(Metric{(int)(mSentTimeframes - mConsumedTimeframes + 1), "timeframes-in-flight"}.addTag(Key::Subsystem, Value::DPL));
+
+  limit.sent(mSentTimeframes, now());
+  mSentTimeframes++;
+}
@@ -15,6 +15,8 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
+#include <arrow/array.h>
+#include <arrow/buffer.h>
 #include <arrow/builder.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
@@ -67,6 +69,57 @@ std::shared_ptr<arrow::Table>
   return arrow::Table::Make(mSchema, mArrays);
 }
 
+TableBuilder::InPlaceColumns* TableBuilder::makeInPlaceColumns(std::vector<int64_t> const& widths, int64_t nRows)
+{
+  auto columns = std::make_shared<InPlaceColumns>();
+  columns->capacity = nRows;
+  columns->widths = widths;
+  // Upper bound for the Arrow IPC stream in front of the body: the schema
+  // message and the record batch metadata, which grow with the number of
+  // columns and the length of their names, and some margin for the label.
+  int64_t headroom = 1024;
+  for (auto& field : mSchema->fields()) {
+    headroom += 256 + field->name().size();
+  }
+  columns->headroom = (headroom + 63) & ~63;
+  std::vector<int64_t> offsets;
+  for (auto width : widths) {
+    offsets.push_back(columns->bodySize);
+    columns->bodySize += (width * nRows + 7) & ~7;
+  }
+
+  auto* pool = mInPlacePool ? mInPlacePool.get() : mMemoryPool;
+  auto size = columns->headroom + columns->bodySize;
+  uint8_t* data = nullptr;
+  if (pool->Allocate(size, &data).ok() == false) {
+    throwError(runtime_error_f("Unable to allocate %lld bytes for a table persisted in place", (long long)size));
+  }
+  // The block keeps the pool alive, as the table may outlive the builder.
+  columns->block = std::shared_ptr<arrow::Buffer>(new arrow::MutableBuffer(data, size),
+                                                  [pool, owner = mInPlacePool, size](arrow::Buffer* buffer) {
+                                                    pool->Free(buffer->mutable_data(), size);
+                                                    delete buffer;
+                                                  });
+  for (auto offset : offsets) {
+    columns->columns.push_back(data + columns->headroom + offset);
+  }
+  mInPlace = columns;
+  mHolders = columns.get();
+  mFinalizer = finalizeInPlace;
+  return columns.get();
+}
+
+bool TableBuilder::finalizeInPlace(std::shared_ptr<arrow::Schema> schema, std::vector<std::shared_ptr<arrow::Array>>& arrays, void* holders)
+{
+  auto* columns = reinterpret_cast<InPlaceColumns*>(holders);
+  for (size_t ci = 0; ci < arrays.size(); ++ci) {
+    auto offset = columns->columns[ci] - columns->block->data();
+    auto values = arrow::SliceBuffer(columns->block, offset, columns->rows * columns->widths[ci]);
+    arrays[ci] = arrow::MakeArray(arrow::ArrayData::Make(schema->field(ci)->type(), columns->rows, {nullptr, values}, 0));
+  }
+  return true;
+}
+
 void TableBuilder::throwError(RuntimeErrorRef const& ref)
 {
   throw ref;
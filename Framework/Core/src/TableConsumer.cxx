@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/TableConsumer.h"
+#include "Framework/RuntimeError.h"
+#include <cstring>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -33,8 +35,19 @@ namespace o2::framework
 {
 
 TableConsumer::TableConsumer(const uint8_t* data, int64_t size)
-  : mBuffer{std::make_shared<Buffer>(data, size)}
 {
+  // Tables persisted in place are read from where their stream starts,
+  // the columns are still used without copying them.
+  InPlaceTableHeader header;
+  if (size >= (int64_t)sizeof(header) && memcmp(data, InPlaceTableHeader::sMagic, sizeof(header.magic)) == 0) {
+    memcpy(&header, data, sizeof(header));
+    if (header.streamOffset > (uint64_t)size) {
+      throw runtime_error("Invalid offset for a table persisted in place");
+    }
+    data += header.streamOffset;
+    size -= header.streamOffset;
+  }
+  mBuffer = std::make_shared<Buffer>(data, size);
 }
 
 std::shared_ptr<arrow::Table>
@@ -0,0 +1,231 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ThreadPool.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+// The pool the current thread is a worker of, if any, and its index there
+thread_local ThreadPool const* gCurrentPool = nullptr;
+thread_local int gCurrentWorker = -1;
+// The pool the current thread, not being one of its workers, runs a parallelFor of
+thread_local ThreadPool const* gCallerPool = nullptr;
+} // namespace
+
+struct ThreadPool::Worker {
+  std::mutex mutex;
+  std::deque<std::function<void()>> tasks;
+  std::atomic<uint64_t> executed{0};
+  std::atomic<uint64_t> steals{0};
+  std::atomic<uint64_t> busy{0};
+  std::thread thread;
+};
+
+int ThreadPool::allowedCPUs()
+{
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    return CPU_COUNT(&set);
+  }
+#endif
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+ThreadPool::ThreadPool(int numWorkers, bool pinWorkers)
+{
+  int cpus = allowedCPUs();
+  numWorkers = numWorkers <= 0 ? cpus : std::min(numWorkers, cpus);
+  for (int i = 0; i < numWorkers; ++i) {
+    mWorkers.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < numWorkers; ++i) {
+    mWorkers[i]->thread = std::thread([this, i]() { work(i); });
+  }
+#ifdef __linux__
+  if (pinWorkers) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    int cpu = 0;
+    for (auto& worker : mWorkers) {
+      while (!CPU_ISSET(cpu, &allowed)) {
+        cpu = (cpu + 1) % CPU_SETSIZE;
+      }
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      pthread_setaffinity_np(worker->thread.native_handle(), sizeof(set), &set);
+      cpu = (cpu + 1) % CPU_SETSIZE;
+    }
+  }
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::scoped_lock lock(mSleepMutex);
+    mStop = true;
+  }
+  mWakeUp.notify_all();
+  for (auto& worker : mWorkers) {
+    worker->thread.join();
+  }
+}
+
+int ThreadPool::threadIndex() const
+{
+  if (gCurrentPool == this) {
+    return gCurrentWorker + 1;
+  }
+  return gCallerPool == this ? 0 : -1;
+}
+
+ThreadPool::CallerScope::CallerScope(ThreadPool const& pool)
+  : mPrevious{gCallerPool}
+{
+  gCallerPool = &pool;
+}
+
+ThreadPool::CallerScope::~CallerScope()
+{
+  gCallerPool = mPrevious;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+  if (mWorkers.empty()) {
+    task();
+    return;
+  }
+  // Workers keep what they spawn, other threads spread the tasks around.
+  size_t queue = gCurrentPool == this ? gCurrentWorker : mNextQueue++ % mWorkers.size();
+  {
+    std::scoped_lock lock(mWorkers[queue]->mutex);
+    mWorkers[queue]->tasks.push_back(std::move(task));
+  }
+  {
+    std::scoped_lock lock(mSleepMutex);
+    mPending++;
+  }
+  mWakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+  return runTask(gCurrentPool == this ? gCurrentWorker : -1);
+}
+
+bool ThreadPool::runTask(int index)
+{
+  std::function<void()> task;
+  bool stolen = false;
+  if (index >= 0) {
+    auto& own = *mWorkers[index];
+    std::scoped_lock lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+    }
+  }
+  for (size_t i = 1; !task && i <= mWorkers.size(); ++i) {
+    auto& victim = *mWorkers[(index + i) % mWorkers.size()];
+    std::scoped_lock lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      stolen = index >= 0;
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  mPending--;
+  if (index < 0) {
+    task();
+    return true;
+  }
+  auto& worker = *mWorkers[index];
+  auto start = std::chrono::steady_clock::now();
+  task();
+  worker.busy += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  worker.executed++;
+  worker.steals += stolen;
+  return true;
+}
+
+void ThreadPool::work(int index)
+{
+  gCurrentPool = this;
+  gCurrentWorker = index;
+  while (true) {
+    if (runTask(index)) {
+      continue;
+    }
+    std::unique_lock lock(mSleepMutex);
+    mWakeUp.wait(lock, [this]() { return mStop || mPending > 0; });
+    if (mStop) {
+      return;
+    }
+  }
+}
+
+ThreadPool::Stats ThreadPool::stats() const
+{
+  Stats result;
+  for (auto& worker : mWorkers) {
+    result.tasks += worker->executed;
+    result.steals += worker->steals;
+    result.busy += worker->busy;
+  }
+  return result;
+}
+
+TaskGroup::~TaskGroup()
+{
+  join();
+}
+
+void TaskGroup::join()
+{
+  while (mPending.load(std::memory_order_acquire) > 0) {
+    if (!mPool.runPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void TaskGroup::wait()
+{
+  join();
+  std::exception_ptr exception;
+  {
+    std::scoped_lock lock(mExceptionMutex);
+    std::swap(exception, mException);
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+} // namespace o2::framework
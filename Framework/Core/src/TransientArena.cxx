@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/TransientArena.h"
+
+#include <algorithm>
+
+namespace o2::framework
+{
+
+TransientArena::TransientArena(size_t initialSize)
+{
+  allocateBuffer(initialSize);
+}
+
+TransientArena::~TransientArena() = default;
+
+void TransientArena::allocateBuffer(size_t size)
+{
+  mResource.reset();
+  mBuffer.reset();
+  mCapacity = std::max<size_t>(size, 4096);
+  // not value initialised, the pages are only touched when used
+  mBuffer.reset(new std::byte[mCapacity]);
+  mResource.emplace(mBuffer.get(), mCapacity, std::pmr::new_delete_resource());
+}
+
+void* TransientArena::do_allocate(size_t bytes, size_t alignment)
+{
+  mAllocated += bytes;
+  return mResource->allocate(bytes, alignment);
+}
+
+void TransientArena::reset()
+{
+  mHighWaterMark = std::max(mHighWaterMark, mAllocated);
+  if (mAllocated > mCapacity) {
+    // Did not fit: next time use a single block large enough, with some
+    // margin for alignment and fluctuations.
+    allocateBuffer(mHighWaterMark + mHighWaterMark / 4);
+  } else if (mAllocated) {
+    mResource->release();
+  }
+  mAllocated = 0;
+  mResets++;
+}
+
+} // namespace o2::framework
@@ -46,6 +46,7 @@
 #include "Framework/Monitoring.h"
 #include "Framework/DataProcessorInfo.h"
 #include "Framework/DriverInfo.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DriverControl.h"
 #include "Framework/CommandInfo.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -158,6 +159,9 @@ using DataProcessorSpecs = std::vector<DataProcessorSpec>;
 template class std::vector<DeviceSpec>;
 
 std::vector<DeviceMetricsInfo> gDeviceMetricsInfos;
+// Binary metrics channel of each device, nullptr for remote devices.
+std::vector<std::unique_ptr<DeviceMetricsRingReader>> gDeviceMetricsRings;
+std::vector<std::string> gDeviceMetricsRingNames;
 
 // FIXME: probably find a better place
 // these are the device options added by the framework, but they can be
@@ -351,6 +355,21 @@ void spawnRemoteDevice(std::string const&,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(nullptr);
+  gDeviceMetricsRingNames.emplace_back("");
+}
+
+/// Remove the shared memory segments of the metrics rings
+void cleanupMetricsRings()
+{
+  for (size_t di = 0; di < gDeviceMetricsRings.size(); ++di) {
+    if (gDeviceMetricsRings[di]) {
+      DeviceMetricsRing::unmapShared(gDeviceMetricsRings[di]->ring());
+      DeviceMetricsRing::unlinkShared(gDeviceMetricsRingNames[di]);
+    }
+  }
+  gDeviceMetricsRings.clear();
+  gDeviceMetricsRingNames.clear();
 }
 
 struct DeviceLogContext {
@@ -711,6 +730,11 @@ void spawnDevice(DeviceRef ref,
       service.preFork(serviceRegistry, varmap);
     }
   }
+  // Binary channel for the metrics of the device. The ring is created
+  // before forking, so that it is there once the device starts sending.
+  auto metricsRingName = fmt::format("/dpl-metrics-{}-{}", getpid(), deviceInfos.size());
+  auto* metricsRing = DeviceMetricsRing::createShared(metricsRingName);
+
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -747,6 +771,9 @@ void spawnDevice(DeviceRef ref,
 
     auto portS = std::to_string(driverInfo.tracyPort);
     setenv("TRACY_PORT", portS.c_str(), 1);
+    if (metricsRing) {
+      setenv(DeviceMetricsRing::ENV_VAR, metricsRingName.c_str(), 1);
+    }
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
         service.postForkChild(serviceRegistry);
@@ -810,6 +837,8 @@ void spawnDevice(DeviceRef ref,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(metricsRing ? std::make_unique<DeviceMetricsRingReader>(metricsRing) : nullptr);
+  gDeviceMetricsRingNames.emplace_back(metricsRing ? metricsRingName : "");
 }
 
 struct LogProcessingState {
@@ -848,17 +877,6 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     assert(specs.size() == infos.size());
     DeviceSpec const& spec = specs[di];
 
-    if (info.unprinted.empty()) {
-      continue;
-    }
-
-    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
-
-    std::string_view s = info.unprinted;
-    size_t pos = 0;
-    info.history.resize(info.historySize);
-    info.historyLevel.resize(info.historySize);
-
     auto updateMetricsViews =
       Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
                                      &info.variablesViewIndex,
@@ -870,6 +888,24 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
       hasNewMetric = true;
     };
 
+    // Metrics sent via the shared memory ring are stored without any parsing.
+    if (di < gDeviceMetricsRings.size() && gDeviceMetricsRings[di]) {
+      if (gDeviceMetricsRings[di]->consume(metrics, newMetricCallback) > 0) {
+        result.didProcessMetric = true;
+      }
+    }
+
+    if (info.unprinted.empty()) {
+      continue;
+    }
+
+    O2_SIGNPOST_START(DriverStatus::ID, DriverStatus::BYTES_PROCESSED, info.pid, 0, 0);
+
+    std::string_view s = info.unprinted;
+    size_t pos = 0;
+    info.history.resize(info.historySize);
+    info.historyLevel.resize(info.historySize);
+
     while ((pos = s.find(delimiter)) != std::string::npos) {
       std::string token{s.substr(0, pos)};
       auto logLevel = LogParsingHelpers::parseTokenLevel(token);
@@ -1041,6 +1077,7 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("dpl-tracing-flags", bpo::value<std::string>()->default_value(""), "pipe `|` separate list of events to be traced")                                                                 //
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
+      ("output-buffer-pool-size", bpo::value<std::string>()->default_value("0"), "size in MB of the pool of reusable output buffers (0 disables)")                                         //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
@@ -1148,6 +1185,12 @@ void single_step_callback(uv_timer_s* ctx)
   killChildren(*infos, SIGUSR1);
 }
 
+/// Wake up the driver loop, so that it drains the metrics rings
+/// even if the devices do not print anything.
+void metrics_ring_callback(uv_timer_s*)
+{
+}
+
 void force_exit_callback(uv_timer_s* ctx)
 {
   auto* infos = reinterpret_cast<DeviceInfos*>(ctx->data);
@@ -1335,6 +1378,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
   uv_timer_init(loop, &force_step_timer);
   uv_timer_t force_exit_timer;
   uv_timer_init(loop, &force_exit_timer);
+  uv_timer_t metrics_ring_timer;
+  uv_timer_init(loop, &metrics_ring_timer);
+  uv_timer_start(&metrics_ring_timer, metrics_ring_callback, 100, 100);
 
   bool guiDeployedOnce = false;
   bool once = false;
@@ -1394,6 +1440,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
 
         /// Cleanup the shared memory for the uniqueWorkflowId, in
         /// case we are unlucky and an old one is already present.
+        cleanupMetricsRings();
         if (driverInfo.noSHMCleanup) {
           LOGP(warning, "Not cleaning up shared memory.");
         } else {
@@ -1923,6 +1970,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         } else {
           LOGP(warning, "Could not write out final configuration file. Read only run folder?");
         }
+        cleanupMetricsRings();
         if (driverInfo.noSHMCleanup) {
           LOGP(warning, "Not cleaning up shared memory.");
         } else {
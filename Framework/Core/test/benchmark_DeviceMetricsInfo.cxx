@@ -10,8 +10,10 @@
 // or submit itself to any jurisdiction.
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <regex>
 
 // This is the fastest we could ever get.
@@ -92,10 +94,33 @@ static void BM_ProcessIntMetric(benchmark::State& state)
     }
   }
   state.SetBytesProcessed(state.iterations() * metrics.size() * metric.size());
+  state.SetItemsProcessed(state.iterations() * metrics.size());
 }
 
 BENCHMARK(BM_ProcessIntMetric);
 
+// Same as above, but going through the binary ring, i.e. what the driver
+// does for the devices it spawned.
+static void BM_ProcessIntMetricRing(benchmark::State& state)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto buffer = std::make_unique<DeviceMetricsRing>();
+  auto* ring = DeviceMetricsRing::init(buffer.get());
+  DeviceMetricsRingWriter writer(ring);
+  DeviceMetricsRingReader reader(ring);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < 1000; ++i) {
+      writer.push("bkey", 12, 1789372894);
+    }
+    benchmark::DoNotOptimize(reader.consume(info));
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK(BM_ProcessIntMetricRing);
+
 static void BM_ParseFloatMetric(benchmark::State& state)
 {
   using namespace o2::framework;
@@ -16,14 +16,24 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/format.hpp>
+#include <random>
 
 using namespace o2::framework;
 using namespace arrow;
 using namespace o2::soa;
 
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
+DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
+} // namespace test
+
 /// Number of lookups to perform
 const int nLookups = 100000;
 
+/// Number of entries to fill
+const int nFills = 1000000;
+
 /// Lookup a histogram by name literal in a HistogramRegistry
 static void BM_HashedNameLookup(benchmark::State& state)
 {
@@ -62,7 +72,75 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a TH1F and a TH2F entry by entry, buffering up to state.range(0) entries per histogram
+static void BM_RegistryFill(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::normal_distribution<float> normal_dist(0, 1);
+  std::vector<float> values(2 * nFills);
+  for (auto& value : values) {
+    value = normal_dist(e1);
+  }
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "x", {HistType::kTH1F, {{100, -3, 3}}}},              //
+                  {"xy", "xy", {HistType::kTH2F, {{50, -3, 3}, {50, -3, 3}}}} //
+                }                                                             //
+  };
+  registry.setFillBufferSize(state.range(0));
+
+  for (auto _ : state) {
+    for (auto i = 0; i < nFills; ++i) {
+      registry.fill(HIST("x"), values[2 * i]);
+      registry.fill(HIST("xy"), values[2 * i], values[2 * i + 1]);
+    }
+    registry.flush();
+  }
+  state.SetItemsProcessed(state.iterations() * nFills * 2);
+}
+
+/// Fill a TH1F and a TH2F with the rows of a table passing a filter
+template <bool COLUMNAR>
+static void BM_RegistryTableFill(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::normal_distribution<float> normal_dist(0, 1);
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"x", "y"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, normal_dist(e1), normal_dist(e1));
+  }
+  auto table = builder.finalize();
+  using Test = o2::soa::Table<test::X, test::Y>;
+  Test tests{table};
+
+  HistogramRegistry registry{
+    "registry", {
+                  {"x", "x", {HistType::kTH1F, {{100, -3, 3}}}},              //
+                  {"xy", "xy", {HistType::kTH2F, {{50, -3, 3}, {50, -3, 3}}}} //
+                }                                                             //
+  };
+
+  for (auto _ : state) {
+    if constexpr (COLUMNAR) {
+      registry.fill<test::X>(HIST("x"), tests, test::x > 0.f);
+      registry.fill<test::X, test::Y>(HIST("xy"), tests, test::x > 0.f);
+    } else {
+      for (auto& test : tests) {
+        if (test.x() > 0.f) {
+          registry.fill(HIST("x"), test.x());
+          registry.fill(HIST("xy"), test.x(), test.y());
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_RegistryFill)->Arg(0)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_RegistryTableFill, false)->Range(8, 8 << 15);
+BENCHMARK_TEMPLATE(BM_RegistryTableFill, true)->Range(8, 8 << 15);
 
 BENCHMARK_MAIN();
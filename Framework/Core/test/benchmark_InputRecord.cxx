@@ -15,6 +15,7 @@
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataRelayer.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/DecodedHeaders.h"
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpan.h"
 #include <Monitoring/Monitoring.h>
@@ -103,4 +104,70 @@ static void BM_InputRecordGenericGetters(benchmark::State& state)
 
 BENCHMARK(BM_InputRecordGenericGetters);
 
+// Access the DataHeader and the DataProcessingHeader of all the parts of an
+// input, as done by the framework (e.g. to compute the input latency) and by
+// InputRecordWalker based user code, either by walking the header stack or
+// through the headers decoded when the parts were received.
+static void headerAccess(benchmark::State& state, bool decoded)
+{
+  InputSpec spec{"x", "TPC", "CLUSTERS", 0, Lifetime::Timeframe};
+  std::vector<InputRoute> schema = {InputRoute{spec, 0, "x_source"}};
+  ServiceRegistry registry;
+
+  size_t nParts = state.range(0);
+  std::vector<std::vector<std::byte>> headers;
+  std::vector<DecodedHeaders> decodedHeaders;
+  int payload = 0;
+  for (size_t pi = 0; pi < nParts; ++pi) {
+    DataHeader dh;
+    dh.dataDescription = "CLUSTERS";
+    dh.dataOrigin = "TPC";
+    dh.subSpecification = pi;
+    dh.payloadSize = sizeof(int);
+    dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+    DataProcessingHeader dph{0, 1};
+    Stack stack{dh, dph};
+    headers.emplace_back(stack.data(), stack.data() + stack.size());
+  }
+  for (auto& header : headers) {
+    decodedHeaders.push_back(DecodedHeaders::decode(header.data()));
+  }
+
+  auto getter = [&](size_t, size_t part) {
+    auto const* header = reinterpret_cast<char const*>(headers[part].data());
+    auto const* data = reinterpret_cast<char const*>(&payload);
+    if (decoded) {
+      return DataRef{nullptr, header, data, sizeof(int), decodedHeaders[part].dataHeader, decodedHeaders[part].processingHeader};
+    }
+    return DataRef{nullptr, header, data, sizeof(int)};
+  };
+  InputSpan span{getter, [nParts](size_t) { return nParts; }, 1};
+  InputRecord record{schema, span, registry};
+
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (size_t pi = 0; pi < nParts; ++pi) {
+      auto ref = record.getByPos(0, pi);
+      auto const* dh = DataRefUtils::getHeader<DataHeader*>(ref);
+      auto const* dph = DataRefUtils::getHeader<DataProcessingHeader*>(ref);
+      sum += dh->subSpecification + dph->startTime + DataRefUtils::getPayloadSize(ref);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * nParts);
+}
+
+static void BM_InputRecordHeaderWalk(benchmark::State& state)
+{
+  headerAccess(state, false);
+}
+
+static void BM_InputRecordHeaderDecoded(benchmark::State& state)
+{
+  headerAccess(state, true);
+}
+
+BENCHMARK(BM_InputRecordHeaderWalk)->Range(1, 4096);
+BENCHMARK(BM_InputRecordHeaderDecoded)->Range(1, 4096);
+
 BENCHMARK_MAIN();
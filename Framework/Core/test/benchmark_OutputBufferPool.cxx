@@ -0,0 +1,51 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/OutputBufferPool.h"
+
+#include <benchmark/benchmark.h>
+#include <fairmq/FairMQTransportFactory.h>
+
+using namespace o2::framework;
+
+// Allocation of small output messages directly from the transport
+static void BM_OutputMessagePlain(benchmark::State& state)
+{
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  for (auto _ : state) {
+    auto msg = transport->CreateMessage(state.range(0), fair::mq::Alignment{64});
+    benchmark::DoNotOptimize(msg->GetData());
+  }
+}
+
+BENCHMARK(BM_OutputMessagePlain)->Range(64, 1 << 20);
+
+// The same, served by the output buffer pool
+static void BM_OutputMessagePooled(benchmark::State& state)
+{
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  OutputBufferPool pool{64 << 20, 2 << 20};
+  for (auto _ : state) {
+    auto msg = pool.getMessage(transport.get(), state.range(0));
+    if (!msg) {
+      // region exhausted, as the framework does
+      msg = transport->CreateMessage(state.range(0), fair::mq::Alignment{64});
+    }
+    benchmark::DoNotOptimize(msg->GetData());
+  }
+  auto stats = pool.stats();
+  state.counters["recycled"] = stats.recycled;
+  state.counters["fallbacks"] = stats.fallbacks;
+}
+
+BENCHMARK(BM_OutputMessagePooled)->Range(64, 1 << 20);
+
+BENCHMARK_MAIN();
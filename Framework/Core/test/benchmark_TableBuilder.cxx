@@ -11,8 +11,10 @@
 
 #include "Framework/TableBuilder.h"
 #include "Framework/TableConsumer.h"
+#include "../src/FairMQResizableBuffer.h"
 
 #include <benchmark/benchmark.h>
+#include <fairmq/FairMQTransportFactory.h>
 
 using namespace o2::framework;
 
@@ -164,4 +166,57 @@ static void BM_TableBuilderComplex(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderComplex)->Range(8, 8 << 16);
 
+// Build a table and serialise it to a message, as done by the DataAllocator,
+// reporting the bytes copied to the message per row.
+static void BM_TableBuilderSerialisedPresized(benchmark::State& state)
+{
+  using namespace o2::framework;
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto creator = [&transport](size_t size) -> std::unique_ptr<FairMQMessage> {
+    return transport->CreateMessage(size);
+  };
+  int64_t copied = 0;
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto rowWriter = builder.preallocatedPersist<float, float, float>({"x", "y", "z"}, state.range(0));
+    for (size_t i = 0; i < state.range(0); ++i) {
+      rowWriter(0, 0.f, 0.f, 0.f);
+    }
+    auto table = builder.finalize();
+    auto buffer = std::make_shared<FairMQResizableBuffer>(creator);
+    copied += doWriteTable(buffer, table.get());
+    benchmark::DoNotOptimize(buffer->Finalise());
+  }
+  state.counters["copiedPerRow"] = (double)copied / (state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TableBuilderSerialisedPresized)->Range(8, 8 << 16);
+
+static void BM_TableBuilderSerialisedInPlace(benchmark::State& state)
+{
+  using namespace o2::framework;
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto creator = [&transport](size_t size) -> std::unique_ptr<FairMQMessage> {
+    return transport->CreateMessage(size);
+  };
+  int64_t copied = 0;
+  for (auto _ : state) {
+    auto pool = std::make_shared<FairMQMemoryPool>(creator);
+    TableBuilder builder;
+    builder.setInPlacePool(pool);
+    auto rowWriter = builder.inPlacePersist<float, float, float>({"x", "y", "z"}, state.range(0));
+    for (size_t i = 0; i < state.range(0); ++i) {
+      rowWriter(0, 0.f, 0.f, 0.f);
+    }
+    auto table = builder.finalize();
+    auto* columns = builder.inPlaceColumns();
+    auto buffer = std::make_shared<FairMQResizableBuffer>(creator);
+    copied += doWriteTableInPlace(buffer, *table, *pool, columns->block->data() + columns->headroom, columns->bodySize);
+    benchmark::DoNotOptimize(buffer->Finalise());
+  }
+  state.counters["copiedPerRow"] = (double)copied / (state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TableBuilderSerialisedInPlace)->Range(8, 8 << 16);
+
 BENCHMARK_MAIN();
@@ -23,6 +23,8 @@
 #include "Framework/OutputRoute.h"
 #include "Framework/ConcreteDataMatcher.h"
 #include "Framework/DataRefUtils.h"
+#include "Framework/FairMQDeviceProxy.h"
+#include "Framework/OutputBufferPool.h"
 #include "Headers/DataHeader.h"
 #include "TestClasses.h"
 #include "Framework/Logger.h"
@@ -148,6 +150,29 @@ DataProcessorSpec getSourceSpec()
     // make a vector of POD and set some data
     pc.outputs().make<std::vector<int>>(OutputRef{"podvector"}) = {10, 21, 42};
 
+    // all the outputs of the timeframe at once
+    auto contiguous = pc.outputs().makeContiguous({Output{"TST", "CONTIGUOUS", 0, Lifetime::Timeframe},
+                                                   Output{"TST", "CONTIGUOUS", 1, Lifetime::Timeframe}},
+                                                  {sizeof(o2::test::TriviallyCopyable), 3 * sizeof(int)});
+    ASSERT_ERROR(contiguous.size() == 2);
+    memcpy(contiguous[0].data(), &a, sizeof(a));
+    int ints[3] = {1, 2, 3};
+    memcpy(contiguous[1].data(), ints, sizeof(ints));
+
+    // small output messages served by a pool of reusable buffers
+    {
+      auto* transport = pc.services().get<FairMQDeviceProxy>().getTransport(RouteIndex{0});
+      OutputBufferPool pool{16 << 20};
+      for (int i = 0; i < 16; ++i) {
+        auto msg = pool.getMessage(transport, 1024);
+        ASSERT_ERROR(msg != nullptr);
+        ASSERT_ERROR(msg->GetSize() == 1024);
+      }
+      ASSERT_ERROR(pool.getMessage(transport, 32 << 20) == nullptr);
+      auto stats = pool.stats();
+      ASSERT_ERROR(stats.pooled == 16 && stats.fallbacks == 1);
+    }
+
     // now we are done and signal this downstream
     pc.services().get<ControlService>().endOfStream();
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
@@ -178,7 +203,9 @@ DataProcessorSpec getSourceSpec()
                             OutputSpec{"TST", "ROOTSERLZDVEC", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "ROOTSERLZDVEC2", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "PMRTESTVECTOR", 0, Lifetime::Timeframe},
-                            OutputSpec{{"podvector"}, "TST", "PODVECTOR", 0, Lifetime::Timeframe}},
+                            OutputSpec{{"podvector"}, "TST", "PODVECTOR", 0, Lifetime::Timeframe},
+                            OutputSpec{"TST", "CONTIGUOUS", 0, Lifetime::Timeframe},
+                            OutputSpec{"TST", "CONTIGUOUS", 1, Lifetime::Timeframe}},
                            AlgorithmSpec(processingFct)};
 }
 
@@ -333,6 +360,13 @@ DataProcessorSpec getSinkSpec()
     ASSERT_ERROR(podvector.size() == 3);
     ASSERT_ERROR(podvector[0] == 10 && podvector[1] == 21 && podvector[2] == 42);
 
+    LOG(info) << "extracting the outputs created with makeContiguous";
+    auto contiguous0 = pc.inputs().get<o2::test::TriviallyCopyable>("inputContiguous0");
+    ASSERT_ERROR(contiguous0 == o2::test::TriviallyCopyable(42, 23, 0xdead));
+    auto contiguous1 = pc.inputs().get<gsl::span<int>>("inputContiguous1");
+    ASSERT_ERROR(contiguous1.size() == 3);
+    ASSERT_ERROR(contiguous1[0] == 1 && contiguous1[1] == 2 && contiguous1[2] == 3);
+
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   };
 
@@ -354,6 +388,8 @@ DataProcessorSpec getSinkSpec()
                             InputSpec{"input15", "TST", "ROOTSERLZBLVECT", 0, Lifetime::Timeframe},
                             InputSpec{"inputPMR", "TST", "PMRTESTVECTOR", 0, Lifetime::Timeframe},
                             InputSpec{"inputPODvector", "TST", "PODVECTOR", 0, Lifetime::Timeframe},
+                            InputSpec{"inputContiguous0", "TST", "CONTIGUOUS", 0, Lifetime::Timeframe},
+                            InputSpec{"inputContiguous1", "TST", "CONTIGUOUS", 1, Lifetime::Timeframe},
                             InputSpec{"inputMP", ConcreteDataTypeMatcher{"TST", "MULTIPARTS"}, Lifetime::Timeframe}},
                            Outputs{OutputSpec{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe}},
                            AlgorithmSpec(processingFct)};
@@ -19,6 +19,8 @@
 #include <TMessage.h>
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/DataRefUtils.h"
+#include "Framework/DecodedHeaders.h"
+#include "Headers/Stack.h"
 #include <boost/test/unit_test.hpp>
 
 #include <memory>
@@ -76,3 +78,41 @@ BOOST_AUTO_TEST_CASE(TestRootContainerSerialization)
   // the get method takes care of this
   BOOST_CHECK(s->IsOwner());
 }
+
+BOOST_AUTO_TEST_CASE(TestDecodedHeaders)
+{
+  using namespace o2::header;
+  DataHeader dh;
+  dh.dataOrigin = "TST";
+  dh.dataDescription = "A";
+  dh.payloadSize = 42;
+  DataProcessingHeader dph{1, 0};
+
+  // DPL layout, both headers at fixed offsets
+  Stack stack{dh, dph};
+  auto decoded = DecodedHeaders::decode(stack.data());
+  BOOST_CHECK_EQUAL((void const*)decoded.dataHeader, (void const*)get<DataHeader*>(stack.data()));
+  BOOST_CHECK_EQUAL((void const*)decoded.processingHeader, (void const*)get<DataProcessingHeader*>(stack.data()));
+
+  // Any other layout is decoded by walking the stack
+  Stack reversed{dph, dh};
+  decoded = DecodedHeaders::decode(reversed.data());
+  BOOST_CHECK_EQUAL((void const*)decoded.dataHeader, (void const*)get<DataHeader*>(reversed.data()));
+  BOOST_CHECK_EQUAL((void const*)decoded.processingHeader, (void const*)get<DataProcessingHeader*>(reversed.data()));
+  Stack noDph{dh};
+  decoded = DecodedHeaders::decode(noDph.data());
+  BOOST_CHECK(decoded.dataHeader != nullptr);
+  BOOST_CHECK(decoded.processingHeader == nullptr);
+  BOOST_CHECK(DecodedHeaders::decode(nullptr).dataHeader == nullptr);
+
+  // DataRefs carrying the decoded headers do not need to look them up,
+  // the others fall back to walking the stack.
+  decoded = DecodedHeaders::decode(stack.data());
+  DataRef ref{nullptr, reinterpret_cast<char const*>(stack.data()), nullptr, 0, decoded.dataHeader, decoded.processingHeader};
+  BOOST_CHECK_EQUAL(DataRefUtils::getHeader<DataHeader*>(ref), decoded.dataHeader);
+  BOOST_CHECK_EQUAL(DataRefUtils::getHeader<DataProcessingHeader*>(ref), decoded.processingHeader);
+  BOOST_CHECK_EQUAL(DataRefUtils::getPayloadSize(ref), 42);
+  DataRef plain{nullptr, reinterpret_cast<char const*>(stack.data()), nullptr, 0};
+  BOOST_CHECK_EQUAL(DataRefUtils::getHeader<DataHeader*>(plain), decoded.dataHeader);
+  BOOST_CHECK_EQUAL(DataRefUtils::getHeader<DataProcessingHeader const*>(plain), decoded.processingHeader);
+}
@@ -14,8 +14,10 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 #include <boost/test/unit_test.hpp>
 #include <iostream>
+#include <memory>
 #include <regex>
 #include <string_view>
 
@@ -223,3 +225,44 @@ BOOST_AUTO_TEST_CASE(TestHelpers)
   BOOST_CHECK_EQUAL(metric2, 0);
   BOOST_CHECK_EQUAL(metric3, 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestMetricsRing)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto buffer = std::make_unique<DeviceMetricsRing>();
+  auto* ring = DeviceMetricsRing::init(buffer.get());
+  DeviceMetricsRingWriter writer(ring);
+  DeviceMetricsRingReader reader(ring);
+
+  BOOST_CHECK(writer.push("bkey", 12, 1000));
+  BOOST_CHECK(writer.push("akey", 1.5f, 1001));
+  BOOST_CHECK(writer.push("bkey", 13, 1002));
+  BOOST_CHECK(writer.push("ckey", (uint64_t)1 << 40, 1003));
+  BOOST_CHECK_EQUAL(ring->nLabels.load(), 3);
+  BOOST_CHECK_EQUAL(reader.consume(info), 4);
+  BOOST_CHECK_EQUAL(reader.consume(info), 0);
+
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), 3);
+  BOOST_CHECK(strncmp(info.metricLabels[0].label, "bkey", 4) == 0);
+  BOOST_CHECK_EQUAL(info.metrics[0].type, MetricType::Int);
+  BOOST_CHECK_EQUAL(info.metrics[0].filledMetrics, 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][1], 13);
+  BOOST_CHECK_EQUAL(info.timestamps[0][1], 1002);
+  BOOST_CHECK_EQUAL(info.metrics[1].type, MetricType::Float);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 1.5f);
+  BOOST_CHECK_EQUAL(info.metrics[2].type, MetricType::Uint64);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], (uint64_t)1 << 40);
+  // Same labels as for the text path
+  BOOST_CHECK_EQUAL(DeviceMetricsHelper::metricIdxByName("akey", info), 1);
+
+  // When the ring is full the writer refuses new metrics
+  for (size_t i = 0; i < DeviceMetricsRing::CAPACITY; ++i) {
+    BOOST_CHECK(writer.push("bkey", (int)i, 2000 + i));
+  }
+  BOOST_CHECK(writer.push("bkey", 0, 3000) == false);
+  BOOST_CHECK_EQUAL(reader.consume(info), DeviceMetricsRing::CAPACITY);
+  BOOST_CHECK(writer.push("bkey", 0, 3000));
+  BOOST_CHECK_EQUAL(reader.consume(info), 1);
+}
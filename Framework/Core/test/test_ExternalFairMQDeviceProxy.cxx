@@ -25,7 +25,9 @@ BOOST_AUTO_TEST_CASE(ExternalFairMQDeviceProxy)
                                                             {}, "type=sub,method=connect,address=tcp://localhost:10000,rateLogging=1", f);
   BOOST_CHECK_EQUAL(spec.name, "testSource");
   BOOST_CHECK_EQUAL(spec.inputs.size(), 0);
-  BOOST_REQUIRE_EQUAL(spec.options.size(), 1);
+  BOOST_REQUIRE_EQUAL(spec.options.size(), 2);
   BOOST_CHECK_EQUAL(spec.options[0].name, "channel-config");
   BOOST_CHECK_EQUAL(spec.options[0].defaultValue.get<const char*>(), std::string("name=testSource,type=sub,method=connect,address=tcp://localhost:10000,rateLogging=1"));
+  BOOST_CHECK_EQUAL(spec.options[1].name, "timeframes-rate-limit-adaptive");
+  BOOST_CHECK_EQUAL(spec.options[1].defaultValue.get<bool>(), false);
 }
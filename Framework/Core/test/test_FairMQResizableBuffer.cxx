@@ -15,6 +15,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include "Framework/TableBuilder.h"
+#include "Framework/TableConsumer.h"
 #include "../src/FairMQResizableBuffer.h"
 #include <fairmq/FairMQTransportFactory.h>
 #include <cstring>
@@ -146,3 +147,51 @@ BOOST_AUTO_TEST_CASE(TestStreaming)
 
   std::unique_ptr<FairMQMessage> payload = buffer->Finalise();
 }
+
+BOOST_AUTO_TEST_CASE(TestInPlaceTable)
+{
+  using namespace o2::framework;
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  auto creator = [&transport](size_t size) -> std::unique_ptr<FairMQMessage> {
+    return transport->CreateMessage(size);
+  };
+  auto pool = std::make_shared<FairMQMemoryPool>(creator);
+
+  TableBuilder builder;
+  builder.setInPlacePool(pool);
+  auto rowWriter = builder.inPlacePersist<int, float, double>({"x", "y", "z"}, 1000);
+  for (int i = 0; i < 1000; ++i) {
+    rowWriter(0, i, 2.f * i, 3. * i);
+  }
+  BOOST_CHECK_THROW(rowWriter(0, 0, 0.f, 0.), RuntimeErrorRef);
+  builder.setLabel("test");
+  auto table = builder.finalize();
+  auto* columns = builder.inPlaceColumns();
+  BOOST_REQUIRE(columns != nullptr);
+  BOOST_CHECK_EQUAL(columns->rows, 1000);
+  BOOST_CHECK_EQUAL(pool->bytes_allocated(), columns->headroom + columns->bodySize);
+
+  auto buffer = std::make_shared<FairMQResizableBuffer>(creator);
+  auto copied = doWriteTableInPlace(buffer, *table, *pool, columns->block->data() + columns->headroom, columns->bodySize);
+  // Only the metadata is copied, the columns were already in the message
+  BOOST_REQUIRE_GE(copied, 0);
+  BOOST_CHECK_LT(copied, columns->headroom);
+  BOOST_CHECK_EQUAL(pool->bytes_allocated(), 0);
+  auto message = buffer->Finalise();
+
+  TableConsumer consumer((uint8_t const*)message->GetData(), message->GetSize());
+  auto readBack = consumer.asArrowTable();
+  BOOST_REQUIRE_EQUAL(readBack->num_rows(), 1000);
+  BOOST_REQUIRE_EQUAL(readBack->num_columns(), 3);
+  BOOST_CHECK_EQUAL(readBack->schema()->metadata()->value(0), "test");
+  auto z = std::static_pointer_cast<arrow::DoubleArray>(readBack->column(2)->chunk(0));
+  BOOST_CHECK_EQUAL(z->Value(999), 2997.);
+  // The columns are read where they were filled
+  auto* begin = (uint8_t const*)message->GetData();
+  auto* values = (uint8_t const*)z->raw_values();
+  BOOST_CHECK(values > begin && values < begin + message->GetSize());
+
+  // The same table written with a copy, for comparison
+  auto copyBuffer = std::make_shared<FairMQResizableBuffer>(creator);
+  BOOST_CHECK_GT(doWriteTable(copyBuffer, table.get()), columns->bodySize);
+}
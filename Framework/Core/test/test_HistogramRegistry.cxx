@@ -14,6 +14,7 @@
 
 #include "Framework/HistogramRegistry.h"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <iostream>
 
 using namespace o2;
@@ -109,6 +110,53 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
   BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("xy"))->GetEntries(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(HistogramRegistryBufferedFill)
+{
+  auto makeRegistry = [](char const* const name) {
+    return HistogramRegistry{
+      name, {
+              {"x", "x", {HistType::kTH1F, {{100, -1.0f, 1.0f}}}},                                                //
+              {"xw", "x weighted", {HistType::kTH1D, {{100, -1.0f, 1.0f}}}},                                      //
+              {"xVar", "x variable bins", {HistType::kTH1F, {{std::vector<double>{-1.0, -0.5, 0.0, 0.1, 1.0}}}}}, //
+              {"xy", "xy", {HistType::kTH2F, {{20, -1.0f, 1.0f}, {20, -1.0f, 1.0f}}}}                             //
+            }                                                                                                     //
+    };
+  };
+  auto direct = makeRegistry("direct");
+  auto buffered = makeRegistry("buffered");
+  buffered.setFillBufferSize(64);
+
+  for (int i = 0; i < 1000; ++i) {
+    // some of the entries end up in the under- and overflow bins
+    double x = 1.2 * std::sin(i);
+    double y = 1.2 * std::cos(i);
+    double w = (i % 3) ? 1. : 0.5;
+    direct.fill(HIST("x"), x);
+    buffered.fill(HIST("x"), x);
+    direct.fill(HIST("xw"), x, w);
+    buffered.fill(HIST("xw"), x, w);
+    direct.fill(HIST("xVar"), x);
+    buffered.fill(HIST("xVar"), x);
+    direct.fill(HIST("xy"), x, y);
+    buffered.fill(HIST("xy"), x, y);
+  }
+
+  auto check = [](auto const& expected, auto const& actual) {
+    BOOST_CHECK_EQUAL(actual->GetEntries(), expected->GetEntries());
+    BOOST_CHECK_CLOSE(actual->GetMean(), expected->GetMean(), 1e-8);
+    BOOST_CHECK_CLOSE(actual->GetStdDev(), expected->GetStdDev(), 1e-8);
+    BOOST_CHECK_EQUAL(actual->GetSumw2N(), expected->GetSumw2N());
+    for (int bin = 0; bin < expected->GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(actual->GetBinContent(bin), expected->GetBinContent(bin));
+      BOOST_CHECK_EQUAL(actual->GetBinError(bin), expected->GetBinError(bin));
+    }
+  };
+  check(direct.get<TH1>(HIST("x")), buffered.get<TH1>(HIST("x")));
+  check(direct.get<TH1>(HIST("xw")), buffered.get<TH1>(HIST("xw")));
+  check(direct.get<TH1>(HIST("xVar")), buffered.get<TH1>(HIST("xVar")));
+  check(direct.get<TH2>(HIST("xy")), buffered.get<TH2>(HIST("xy")));
+}
+
 BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
 {
   HistogramRegistry registry{"registry"};
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework MixingPool
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/MixingPool.h"
+#include "Framework/TableBuilder.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::framework;
+using namespace o2::soa;
+
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(X, x, int32_t, "x");
+DECLARE_SOA_COLUMN_FULL(Y, y, int32_t, "y");
+DECLARE_SOA_COLUMN_FULL(FloatZ, floatZ, float, "floatZ");
+} // namespace test
+
+using TestCollisions = o2::soa::Table<o2::soa::Index<>, test::X>;
+using TestTracks = o2::soa::Table<test::Y, test::FloatZ>;
+
+namespace
+{
+TestCollisions makeCollisions(std::vector<int32_t> const& bins)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t>({"x"});
+  for (auto bin : bins) {
+    rowWriter(0, bin);
+  }
+  return TestCollisions{builder.finalize()};
+}
+
+TestTracks makeTracks(int32_t firstY, int n)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, float>({"y", "floatZ"});
+  for (auto i = 0; i < n; ++i) {
+    rowWriter(0, firstY + i, 0.5f * (firstY + i));
+  }
+  return TestTracks{builder.finalize()};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(MixingPoolAcrossDataframes)
+{
+  using Pool = MixingPool<NoBinningPolicy<test::X>, test::Y, test::FloatZ>;
+  Pool pool{{}, 2};
+
+  // First dataframe: nothing to mix with yet
+  auto collisions1 = makeCollisions({0, 1});
+  auto tracks10 = makeTracks(0, 3);
+  auto tracks11 = makeTracks(10, 2);
+  auto collision = collisions1.begin();
+  BOOST_CHECK_EQUAL(pool.getBin(collision), 0);
+  auto noPairs = pool.mixedPairs(collision, tracks10);
+  BOOST_CHECK(noPairs.begin() == noPairs.end());
+  pool.add(collision, tracks10);
+  ++collision;
+  pool.add(collision, tracks11);
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.bytes(), 5 * (sizeof(int32_t) + sizeof(float)));
+
+  // Second dataframe: mixed with the collisions of the same bin only
+  auto collisions2 = makeCollisions({0, 0, 2});
+  auto tracks20 = makeTracks(20, 2);
+  auto tracks21 = makeTracks(30, 1);
+  auto collision2 = collisions2.begin();
+  int count = 0;
+  for (auto [pooled, track] : pool.mixedPairs(collision2, tracks20)) {
+    BOOST_CHECK_EQUAL(pooled.get<test::Y>(), count % 3);
+    BOOST_CHECK_EQUAL(pooled.get<test::FloatZ>(), 0.5f * (count % 3));
+    BOOST_CHECK_EQUAL(track.y(), 20 + count / 3);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 2 * 3);
+  pool.add(collision2, tracks20);
+
+  ++collision2;
+  count = 0;
+  for (auto [pooled, track] : pool.mixedPairs(collision2, tracks21)) {
+    BOOST_CHECK_EQUAL(track.y(), 30);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 3 + 2);
+  // the depth is 2, so the first collision is dropped
+  pool.add(collision2, tracks21);
+  BOOST_CHECK_EQUAL(pool.size(), 3);
+  count = 0;
+  for (auto [pooled, track] : pool.mixedPairs(collision2, tracks21)) {
+    BOOST_CHECK_GE(pooled.get<test::Y>(), 20);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 2 + 1);
+
+  ++collision2;
+  auto otherBinPairs = pool.mixedPairs(collision2, tracks21);
+  BOOST_CHECK(otherBinPairs.begin() == otherBinPairs.end());
+}
+
+BOOST_AUTO_TEST_CASE(MixingPoolMemoryCap)
+{
+  using Pool = MixingPool<NoBinningPolicy<test::X>, test::Y, test::FloatZ>;
+  BOOST_CHECK_THROW(Pool({}, 0), RuntimeErrorRef);
+  constexpr size_t trackSize = sizeof(int32_t) + sizeof(float);
+  Pool pool{{}, 10, 4 * trackSize};
+
+  auto collisions = makeCollisions({0, 1, 0});
+  auto collision = collisions.begin();
+  pool.add(collision, makeTracks(0, 3));
+  ++collision;
+  pool.add(collision, makeTracks(10, 1));
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.bytes(), 4 * trackSize);
+  // the oldest collision of all bins goes first
+  ++collision;
+  pool.add(collision, makeTracks(20, 2));
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+  BOOST_CHECK_EQUAL(pool.bytes(), 3 * trackSize);
+  int count = 0;
+  for (auto [pooled, track] : pool.mixedPairs(collision, makeTracks(30, 1))) {
+    BOOST_CHECK_EQUAL(pooled.get<test::Y>(), 20 + count);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 2);
+}
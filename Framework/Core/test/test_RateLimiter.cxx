@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework RateLimiter
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/RateLimiter.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+/// A source as fast as allowed feeding a consumer with a number of parallel
+/// lanes, each taking the same time per timeframe.
+struct SimulatedPipeline {
+  int lanes;
+  uint64_t processingTime;
+  uint64_t transportTime;
+
+  struct Result {
+    double throughput;   // timeframes per ns, in the second half of the run
+    int maxInFlight;     // in the second half of the run
+    double averageLimit; // in the second half of the run
+  };
+
+  Result run(AdaptiveInFlightLimit& limit, int64_t nTimeframes)
+  {
+    std::vector<uint64_t> laneFree(lanes, 0);
+    std::deque<uint64_t> completions;
+    uint64_t now = 0;
+    uint64_t halfTime = 0;
+    int64_t sent = 0;
+    int64_t consumed = 0;
+    Result result{0, 0, 0};
+    int64_t nLimitSamples = 0;
+    while (consumed < nTimeframes) {
+      if (sent < nTimeframes && sent - consumed < limit.limit()) {
+        limit.sent(sent++, now);
+        auto lane = std::min_element(laneFree.begin(), laneFree.end());
+        *lane = std::max(now + transportTime, *lane) + processingTime;
+        completions.push_back(*lane + transportTime);
+        if (consumed >= nTimeframes / 2) {
+          result.maxInFlight = std::max(result.maxInFlight, (int)(sent - consumed));
+          result.averageLimit += limit.limit();
+          nLimitSamples++;
+        }
+        continue;
+      }
+      now = completions.front();
+      completions.pop_front();
+      limit.consumed(consumed, consumed + 1, now);
+      if (++consumed == nTimeframes / 2) {
+        halfTime = now;
+      }
+    }
+    result.throughput = double(nTimeframes - nTimeframes / 2) / double(now - halfTime);
+    result.averageLimit /= nLimitSamples;
+    return result;
+  }
+
+  /// Smallest number of timeframes in flight giving the maximal throughput
+  double optimalInFlight() const
+  {
+    return lanes * double(processingTime + 2 * transportTime) / processingTime;
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestAdaptiveLimitSlowConsumers)
+{
+  for (auto pipeline : {SimulatedPipeline{1, 100000000, 1000000},
+                        SimulatedPipeline{4, 100000000, 1000000},
+                        SimulatedPipeline{8, 50000000, 20000000}}) {
+    AdaptiveInFlightLimit limit{256};
+    auto result = pipeline.run(limit, 4000);
+    double maxThroughput = pipeline.lanes / double(pipeline.processingTime);
+    // We run at the maximal throughput...
+    BOOST_CHECK_GT(result.throughput, 0.99 * maxThroughput);
+    // ... with a bounded number of timeframes in flight
+    BOOST_CHECK_LE(result.maxInFlight, std::ceil(limit.latencyTolerance * pipeline.optimalInFlight()) + 1);
+    BOOST_CHECK_LT(result.averageLimit, limit.latencyTolerance * pipeline.optimalInFlight() + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestAdaptiveLimitMaximum)
+{
+  // The consumer is infinitely parallel, the limit stops at the maximum.
+  SimulatedPipeline pipeline{1000, 100000, 1000};
+  AdaptiveInFlightLimit limit{16};
+  auto result = pipeline.run(limit, 1000);
+  BOOST_CHECK_EQUAL(limit.limit(), 16);
+  BOOST_CHECK_EQUAL(result.maxInFlight, 16);
+}
+
+BOOST_AUTO_TEST_CASE(TestAdaptiveLimitCongestion)
+{
+  AdaptiveInFlightLimit limit{64};
+  // Slow start: the limit grows by one for each consumed timeframe.
+  uint64_t now = 0;
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < limit.limit(); ++j) {
+      limit.sent(i * 8 + j, now);
+    }
+    now += 1000;
+    limit.consumed(i * 8, i * 8 + 1, now);
+  }
+  BOOST_CHECK_EQUAL(limit.limit(), 9);
+  BOOST_CHECK_EQUAL(limit.minLatency(), 1000);
+  // Halved on congestion, only once for the timeframes already in flight.
+  limit.congestion(10);
+  BOOST_CHECK_EQUAL(limit.limit(), 4);
+  limit.congestion(20);
+  BOOST_CHECK_EQUAL(limit.limit(), 4);
+  limit.sent(100, now);
+  limit.congestion(100);
+  BOOST_CHECK_EQUAL(limit.limit(), 2);
+  // Never below one.
+  for (int i = 101; i < 110; ++i) {
+    limit.sent(i, now);
+    limit.congestion(i);
+  }
+  BOOST_CHECK_EQUAL(limit.limit(), 1);
+}
@@ -185,6 +185,32 @@ BOOST_AUTO_TEST_CASE(TestTableBuilderBulk)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTableBuilderInPlace)
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto rowWriter = builder.inPlacePersist<int, uint64_t>({"x", "y"}, 10);
+  for (int i = 0; i < 8; ++i) {
+    rowWriter(0, i, 2 * i);
+  }
+
+  // Fewer rows than preallocated are fine, they are simply not sent in place.
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 2);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 8);
+  BOOST_REQUIRE_EQUAL(table->schema()->field(1)->type()->id(), arrow::uint64()->id());
+  auto x = std::dynamic_pointer_cast<arrow::NumericArray<arrow::Int32Type>>(table->column(0)->chunk(0));
+  auto y = std::dynamic_pointer_cast<arrow::NumericArray<arrow::UInt64Type>>(table->column(1)->chunk(0));
+  for (int i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(x->Value(i), i);
+    BOOST_CHECK_EQUAL(y->Value(i), 2 * i);
+  }
+  auto* columns = builder.inPlaceColumns();
+  BOOST_REQUIRE(columns != nullptr);
+  BOOST_CHECK_EQUAL(columns->bodySize, 40 + 80);
+  BOOST_CHECK_EQUAL((uint8_t const*)x->raw_values(), columns->block->data() + columns->headroom);
+}
+
 BOOST_AUTO_TEST_CASE(TestTableBuilderMore)
 {
   using namespace o2::framework;
@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework ThreadPool
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/ThreadPool.h"
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestThreadPoolParallelFor)
+{
+  ThreadPool pool(4);
+  BOOST_CHECK_GE(pool.size(), 1);
+  BOOST_CHECK_LE(pool.size(), ThreadPool::allowedCPUs());
+  BOOST_CHECK_EQUAL(pool.threadIndex(), -1);
+
+  std::vector<int> values(100000, 0);
+  std::vector<int64_t> perThread(pool.maxThreads(), 0);
+  pool.parallelFor(0, values.size(), [&](int64_t i) {
+    values[i] += i % 7;
+    perThread[pool.threadIndex()] += 1; // no contention, one slot per thread
+  });
+  int64_t expected = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    expected += i % 7;
+  }
+  BOOST_CHECK_EQUAL(std::accumulate(values.begin(), values.end(), int64_t{0}), expected);
+  BOOST_CHECK_EQUAL(std::accumulate(perThread.begin(), perThread.end(), int64_t{0}), values.size());
+  BOOST_CHECK_EQUAL(pool.threadIndex(), -1);
+
+  // Also with an explicit grain and an empty range
+  std::atomic<int64_t> sum{0};
+  pool.parallelFor(10, 20, [&](int64_t i) { sum += i; }, 3);
+  BOOST_CHECK_EQUAL(sum, 145);
+  pool.parallelFor(5, 5, [&](int64_t) { sum = -1; });
+  BOOST_CHECK_EQUAL(sum, 145);
+}
+
+BOOST_AUTO_TEST_CASE(TestThreadPoolNested)
+{
+  // Waiting for a group from a worker runs the pending tasks, so nested
+  // parallelism completes even with a single worker.
+  for (int workers : {1, 4}) {
+    ThreadPool pool(workers);
+    std::atomic<int> count{0};
+    TaskGroup outer(pool);
+    for (int i = 0; i < 8; ++i) {
+      outer.run([&]() {
+        pool.parallelFor(0, 100, [&](int64_t) { count++; });
+      });
+    }
+    outer.wait();
+    BOOST_CHECK_EQUAL(count, 800);
+    auto stats = pool.stats();
+    BOOST_CHECK_LE(stats.steals, stats.tasks);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestThreadPoolExceptions)
+{
+  ThreadPool pool(2);
+  TaskGroup group(pool);
+  std::atomic<int> completed{0};
+  for (int i = 0; i < 10; ++i) {
+    group.run([i, &completed]() {
+      if (i == 3) {
+        throw std::runtime_error("task failed");
+      }
+      completed++;
+    });
+  }
+  BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+  BOOST_CHECK_EQUAL(completed, 9);
+}
+
+BOOST_AUTO_TEST_CASE(TestThreadPoolAdapter)
+{
+  std::vector<int> values(1000, 1);
+  // Without a pool, the loop runs as before (with OpenMP, if enabled)
+  parallelFor(nullptr, 0, values.size(), [&](int64_t i) { values[i] *= 2; });
+  ThreadPool pool(3);
+  parallelFor(&pool, 0, values.size(), [&](int64_t i) { values[i] *= 3; });
+  BOOST_CHECK_EQUAL(std::accumulate(values.begin(), values.end(), 0), 6000);
+}
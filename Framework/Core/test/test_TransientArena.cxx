@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework TransientArena
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/TransientArena.h"
+#include <memory_resource>
+#include <vector>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestTransientArenaReset)
+{
+  TransientArena arena(1 << 16);
+  BOOST_CHECK_EQUAL(arena.capacity(), 1 << 16);
+  void* first = nullptr;
+  {
+    std::pmr::vector<int> v(1000, 1, &arena);
+    first = v.data();
+    BOOST_CHECK_EQUAL(arena.allocated(), 1000 * sizeof(int));
+  }
+  arena.reset();
+  BOOST_CHECK_EQUAL(arena.allocated(), 0);
+  BOOST_CHECK_EQUAL(arena.highWaterMark(), 1000 * sizeof(int));
+  BOOST_CHECK_EQUAL(arena.resets(), 1);
+  // The memory is reused after the reset
+  std::pmr::vector<int> v(1000, 2, &arena);
+  BOOST_CHECK_EQUAL(v.data(), first);
+}
+
+BOOST_AUTO_TEST_CASE(TestTransientArenaGrowth)
+{
+  TransientArena arena(1 << 12);
+  size_t size = 1 << 20;
+  for (int i = 0; i < 3; ++i) {
+    std::pmr::vector<char> big(size, 0, &arena);
+    std::pmr::vector<double> small(100, 1., &arena);
+    BOOST_CHECK_EQUAL(big[size - 1] + small[99], 1.);
+    arena.reset();
+  }
+  // After the first iteration, a single buffer holds everything.
+  BOOST_CHECK_GE(arena.capacity(), size + 100 * sizeof(double));
+  BOOST_CHECK_EQUAL(arena.highWaterMark(), size + 100 * sizeof(double));
+  BOOST_CHECK_EQUAL(arena.resets(), 3);
+}
@@ -12,12 +12,14 @@
 #define O2_FRAMEWORK_SIGNPOST_H_
 
 #include <cstdint>
+#include <utility>
 
 /// Signpost API implemented using different techonologies:
 ///
 /// * macOS 10.15 onwards os_signpost
 /// * macOS 10.14 and below (either kdebug_signpost or kdebug)
-/// * linux SystemTap
+/// * linux SystemTap, when available, and the in process SignpostRecorder,
+///   which can be dumped as a Chrome trace (see Framework/SignpostRecorder.h)
 ///
 /// Supported systems will have O2_SIGNPOST_API_AVAILABLE defined.
 ///
@@ -60,12 +62,34 @@ static os_log_t gDPLLog;
 #define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4) syscall(SYS_kdebug_trace, APPSDBG_CODE(DBG_MACH_CHUD, (uint32_t)code) | DBG_FUNC_START, (uintptr_t)arg1, (uintptr_t)arg2, (uintptr_t)arg3, (uintptr_t)arg4);
 #define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4) syscall(SYS_kdebug_trace, APPSDBG_CODE(DBG_MACH_CHUD, (uintptr_t)code) | DBG_FUNC_END, (uintptr_t)arg1, (uintptr_t)arg2, (uintptr_t)arg3, (uintptr_t)arg4);
 #define O2_SIGNPOST_API_AVAILABLE
-#elif (!defined(__APPLE__)) && __has_include(<sys/sdt.h>) // Dtrace support is being dropped by Apple
+#elif !defined(__APPLE__)
+#include "Framework/SignpostRecorder.h"
+#if __has_include(<sys/sdt.h>) // Dtrace support is being dropped by Apple
 #include <sys/sdt.h>
-#define O2_SIGNPOST_INIT()
-#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, probe##code, arg1, arg2, arg3, arg4)
-#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, start_probe##code, arg1, arg2, arg3, arg4)
-#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, stop_probe##code, arg1, arg2, arg3, arg4)
+#define O2_SIGNPOST_STAP(name, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, name, arg1, arg2, arg3, arg4)
+#else
+#define O2_SIGNPOST_STAP(name, arg1, arg2, arg3, arg4)
+#endif
+#define O2_SIGNPOST_RECORD(kind, name, arg1, arg2, arg3, arg4)                                                                   \
+  if (O2_BUILTIN_UNLIKELY(o2::framework::SignpostRecorder::isEnabled())) {                                                       \
+    o2::framework::SignpostRecorder::record(kind, name, (uint64_t)(arg1), (uint64_t)(arg2), (uint64_t)(arg3), (uint64_t)(arg4)); \
+  }
+#define O2_SIGNPOST_INIT() o2::framework::SignpostRecorder::init()
+#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4)                                                    \
+  do {                                                                                               \
+    O2_SIGNPOST_STAP(probe##code, arg1, arg2, arg3, arg4);                                           \
+    O2_SIGNPOST_RECORD(o2::framework::SignpostRecorder::Kind::Event, #code, arg1, arg2, arg3, arg4); \
+  } while (0)
+#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4)                                              \
+  do {                                                                                               \
+    O2_SIGNPOST_STAP(start_probe##code, arg1, arg2, arg3, arg4);                                     \
+    O2_SIGNPOST_RECORD(o2::framework::SignpostRecorder::Kind::Start, #code, arg1, arg2, arg3, arg4); \
+  } while (0)
+#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4)                                              \
+  do {                                                                                             \
+    O2_SIGNPOST_STAP(stop_probe##code, arg1, arg2, arg3, arg4);                                    \
+    O2_SIGNPOST_RECORD(o2::framework::SignpostRecorder::Kind::End, #code, arg1, arg2, arg3, arg4); \
+  } while (0)
 #define O2_SIGNPOST_API_AVAILABLE
 #else // by default we do not do anything
 #define O2_SIGNPOST_INIT()
@@ -86,6 +110,26 @@ static os_log_t gDPLLog;
 #define O2_SIGNPOST_ORANGE 3
 #define O2_SIGNPOST_RED 4
 
+namespace o2::framework
+{
+/// Invokes the end of a signpost interval when going out of scope.
+template <typename F>
+struct SignpostScope {
+  SignpostScope(F&& end) : mEnd{std::move(end)} {}
+  ~SignpostScope() { mEnd(); }
+  F mEnd;
+};
+} // namespace o2::framework
+
+#define O2_SIGNPOST_CONCAT_IMPL(a, b) a##b
+#define O2_SIGNPOST_CONCAT(a, b) O2_SIGNPOST_CONCAT_IMPL(a, b)
+/// Mark the rest of the current scope as an interval. Notice that the
+/// arguments of the end of the interval are evaluated when leaving the scope
+/// and that, differently from the other macros, @a code is macro expanded.
+#define O2_SIGNPOST_SCOPE(code, interval_id, arg2, arg3, color) \
+  O2_SIGNPOST_START(code, interval_id, arg2, arg3, color);      \
+  o2::framework::SignpostScope O2_SIGNPOST_CONCAT(signpostScope, __LINE__)([&]() { O2_SIGNPOST_END(code, interval_id, arg2, arg3, color); })
+
 /// Helper class which allows the user to track
 template <typename S>
 struct StateMonitoring {
@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SIGNPOSTRECORDER_H_
+#define O2_FRAMEWORK_SIGNPOSTRECORDER_H_
+
+#include "Framework/CompilerBuiltins.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace o2::framework
+{
+
+/// In process recorder for the signposts, used as backend of the
+/// O2_SIGNPOST_* macros on Linux, where no system wide tracing facility
+/// is guaranteed to be available.
+///
+/// Every thread records its signposts in its own ring buffer, so that
+/// recording does not need any lock and the cost is essentially the one
+/// of reading the timestamp counter. When the buffer is full, the oldest
+/// signposts are overwritten. Recording is disabled by default, and it is
+/// enabled by O2_SIGNPOST_INIT() when the O2_SIGNPOST_TRACE environment
+/// variable points to a directory. In that case the buffers are dumped as a
+/// Chrome trace JSON file, which can be opened with Perfetto
+/// (https://ui.perfetto.dev) or chrome://tracing, when the process exits or
+/// when dump() / dumpToFile() are invoked.
+struct SignpostRecorder {
+  static constexpr char const* ENV_VAR = "O2_SIGNPOST_TRACE";
+  static constexpr size_t CAPACITY = 1 << 14; // Signposts per thread, must be a power of 2
+
+  enum struct Kind : uint8_t {
+    Event,
+    Start,
+    End
+  };
+
+  struct alignas(64) Entry {
+    uint64_t timestamp;
+    char const* name; // Always a string literal
+    uint64_t args[4];
+    Kind kind;
+  };
+
+  struct ThreadBuffer {
+    std::atomic<uint64_t> head = 0; // Number of signposts ever recorded
+    int tid = 0;
+    Entry entries[CAPACITY];
+  };
+
+  /// Enable the recording if the O2_SIGNPOST_TRACE environment variable is
+  /// set and register the dump of the buffers at exit.
+  static void init();
+  /// Enable the recording unconditionally, e.g. for tests.
+  static void enable();
+  static bool isEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+  /// Name of the process in the trace (e.g. the device id).
+  static void setProcessName(std::string const& name);
+
+  static void record(Kind kind, char const* name, uint64_t arg1, uint64_t arg2, uint64_t arg3, uint64_t arg4)
+  {
+    auto* buffer = sThreadBuffer ? sThreadBuffer : registerThread();
+    auto head = buffer->head.load(std::memory_order_relaxed);
+    auto& entry = buffer->entries[head & (CAPACITY - 1)];
+    entry.timestamp = now();
+    entry.name = name;
+    entry.args[0] = arg1;
+    entry.args[1] = arg2;
+    entry.args[2] = arg3;
+    entry.args[3] = arg4;
+    entry.kind = kind;
+    buffer->head.store(head + 1, std::memory_order_release);
+  }
+
+  /// Write the content of all the thread buffers as Chrome trace JSON.
+  /// Intervals are exported as complete events, matching each end with the
+  /// last start with the same name and interval id on the same thread.
+  static void dump(FILE* out);
+  /// Dump to a new file in the directory specified by O2_SIGNPOST_TRACE.
+  /// @return the name of the file or an empty string if nothing was written.
+  static std::string dumpToFile();
+
+  /// Raw timestamp, converted to time only when dumping.
+  static uint64_t now()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0"
+                 : "=r"(value));
+    return value;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+ private:
+  static ThreadBuffer* registerThread();
+
+  inline static std::atomic<bool> sEnabled = false;
+  inline static thread_local ThreadBuffer* sThreadBuffer = nullptr;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SIGNPOSTRECORDER_H_
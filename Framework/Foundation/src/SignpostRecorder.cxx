@@ -0,0 +1,238 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SignpostRecorder.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+struct RecorderState {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<SignpostRecorder::ThreadBuffer>> buffers;
+  std::string processName;
+  std::atomic<bool> atExitRegistered = false;
+  uint64_t startTicks = 0;
+  int64_t startNs = 0;
+  int dumpCount = 0;
+};
+
+RecorderState& state()
+{
+  static RecorderState gState;
+  return gState;
+}
+
+int64_t steadyNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int currentTid()
+{
+#ifdef __linux__
+  return (int)syscall(SYS_gettid);
+#else
+  static std::atomic<int> gNextTid = 1;
+  return gNextTid++;
+#endif
+}
+
+void printEscaped(FILE* out, char const* s)
+{
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', out);
+    }
+    fputc(*s, out);
+  }
+}
+} // namespace
+
+void SignpostRecorder::init()
+{
+  if (getenv(ENV_VAR) == nullptr) {
+    return;
+  }
+  enable();
+  if (state().atExitRegistered.exchange(true) == false) {
+    std::atexit([]() { SignpostRecorder::dumpToFile(); });
+  }
+}
+
+void SignpostRecorder::enable()
+{
+  auto& s = state();
+  if (sEnabled.load() == false) {
+    s.startNs = steadyNs();
+    s.startTicks = now();
+  }
+  sEnabled.store(true);
+}
+
+void SignpostRecorder::setProcessName(std::string const& name)
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  state().processName = name;
+}
+
+SignpostRecorder::ThreadBuffer* SignpostRecorder::registerThread()
+{
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->tid = currentTid();
+  sThreadBuffer = buffer.get();
+  // Buffers are kept until the end of the process, so that the signposts of
+  // threads which already exited end up in the trace as well.
+  std::lock_guard<std::mutex> lock(state().mutex);
+  state().buffers.push_back(std::move(buffer));
+  return sThreadBuffer;
+}
+
+void SignpostRecorder::dump(FILE* out)
+{
+  auto& s = state();
+  // Calibrate the timestamp counter against the steady clock, making sure
+  // enough time went by to have a decent precision.
+  auto endTicks = now();
+  auto endNs = steadyNs();
+  while (endNs - s.startNs < 10000000) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    endTicks = now();
+    endNs = steadyNs();
+  }
+  double nsPerTick = endTicks > s.startTicks ? double(endNs - s.startNs) / double(endTicks - s.startTicks) : 1.;
+  auto toUs = [&s, nsPerTick](uint64_t ticks) {
+    return (double(s.startNs) + (double(ticks) - double(s.startTicks)) * nsPerTick) / 1000.;
+  };
+
+  std::lock_guard<std::mutex> lock(s.mutex);
+  int pid = getpid();
+  bool first = true;
+  auto separator = [&first, out]() {
+    fputs(first ? "\n" : ",\n", out);
+    first = false;
+  };
+
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out);
+  if (s.processName.empty() == false) {
+    separator();
+    fprintf(out, R"({"name":"process_name","ph":"M","pid":%d,"args":{"name":")", pid);
+    printEscaped(out, s.processName.c_str());
+    fputs("\"}}", out);
+  }
+
+  std::vector<Entry> entries;
+  for (auto& buffer : s.buffers) {
+    // The owning thread might still be recording, so we copy the buffer and
+    // discard whatever could have been overwritten in the meanwhile.
+    auto head = buffer->head.load(std::memory_order_acquire);
+    auto begin = head > CAPACITY ? head - CAPACITY : 0;
+    entries.clear();
+    for (auto i = begin; i < head; ++i) {
+      entries.push_back(buffer->entries[i & (CAPACITY - 1)]);
+    }
+    auto newHead = buffer->head.load(std::memory_order_acquire);
+    uint64_t firstValid = newHead >= CAPACITY ? newHead - CAPACITY + 1 : 0;
+    size_t overwritten = firstValid > begin ? std::min<uint64_t>(firstValid - begin, entries.size()) : 0;
+    if (entries.size() == overwritten) {
+      continue;
+    }
+
+    separator();
+    fprintf(out, R"({"name":"thread_name","ph":"M","pid":%d,"tid":%d,"args":{"name":"thread %d"}})", pid, buffer->tid, buffer->tid);
+
+    std::map<std::pair<std::string_view, uint64_t>, std::vector<Entry const*>> open;
+    for (size_t ei = overwritten; ei < entries.size(); ++ei) {
+      auto& entry = entries[ei];
+      switch (entry.kind) {
+        case Kind::Event:
+          separator();
+          fprintf(out, R"({"name":"%s","cat":"dpl","ph":"i","s":"t","pid":%d,"tid":%d,"ts":%.3f,"args":{"arg1":%lu,"arg2":%lu,"arg3":%lu,"arg4":%lu}})",
+                  entry.name, pid, buffer->tid, toUs(entry.timestamp),
+                  (unsigned long)entry.args[0], (unsigned long)entry.args[1], (unsigned long)entry.args[2], (unsigned long)entry.args[3]);
+          break;
+        case Kind::Start:
+          open[{entry.name, entry.args[0]}].push_back(&entry);
+          break;
+        case Kind::End: {
+          auto& starts = open[{entry.name, entry.args[0]}];
+          // The start was overwritten, nothing we can do.
+          if (starts.empty()) {
+            break;
+          }
+          auto& start = *starts.back();
+          starts.pop_back();
+          separator();
+          fprintf(out, R"({"name":"%s","cat":"dpl","ph":"X","pid":%d,"tid":%d,"ts":%.3f,"dur":%.3f,"args":{"id":%lu,"arg2":%lu,"arg3":%lu,"endArg2":%lu,"endArg3":%lu}})",
+                  start.name, pid, buffer->tid, toUs(start.timestamp), toUs(entry.timestamp) - toUs(start.timestamp),
+                  (unsigned long)start.args[0], (unsigned long)start.args[1], (unsigned long)start.args[2],
+                  (unsigned long)entry.args[1], (unsigned long)entry.args[2]);
+        } break;
+      }
+    }
+    // Intervals which are still open are shown up to the end of the trace.
+    for (auto& [key, starts] : open) {
+      for (auto* start : starts) {
+        separator();
+        fprintf(out, R"({"name":"%s","cat":"dpl","ph":"B","pid":%d,"tid":%d,"ts":%.3f,"args":{"id":%lu,"arg2":%lu,"arg3":%lu}})",
+                start->name, pid, buffer->tid, toUs(start->timestamp),
+                (unsigned long)start->args[0], (unsigned long)start->args[1], (unsigned long)start->args[2]);
+      }
+    }
+  }
+  fputs("\n]}\n", out);
+}
+
+std::string SignpostRecorder::dumpToFile()
+{
+  char const* directory = getenv(ENV_VAR);
+  if (directory == nullptr || isEnabled() == false) {
+    return "";
+  }
+  std::string processName;
+  int dumpCount;
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    processName = state().processName;
+    dumpCount = state().dumpCount++;
+  }
+  std::replace(processName.begin(), processName.end(), '/', '_');
+  std::string filename = std::string(directory) + "/o2-signposts-" + (processName.empty() ? "" : processName + "-") +
+                         std::to_string(getpid()) + "-" + std::to_string(dumpCount) + ".json";
+  FILE* out = fopen(filename.c_str(), "w");
+  if (out == nullptr) {
+    fprintf(stderr, "Unable to write signposts to %s: %s\n", filename.c_str(), strerror(errno));
+    return "";
+  }
+  dump(out);
+  fclose(out);
+  fprintf(stderr, "Signposts written to %s\n", filename.c_str());
+  return filename;
+}
+
+} // namespace o2::framework
@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework SignpostRecorder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/Signpost.h"
+#include "Framework/SignpostRecorder.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace o2::framework;
+
+namespace
+{
+std::string dumpToString()
+{
+  FILE* out = tmpfile();
+  SignpostRecorder::dump(out);
+  std::string result(ftell(out), '\0');
+  rewind(out);
+  auto read = fread(result.data(), 1, result.size(), out);
+  fclose(out);
+  result.resize(read);
+  return result;
+}
+
+size_t count(std::string const& s, std::string const& what)
+{
+  size_t n = 0;
+  for (auto pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1)) {
+    ++n;
+  }
+  return n;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestSignpostRecorder)
+{
+  SignpostRecorder::enable();
+  SignpostRecorder::setProcessName("test-device");
+  BOOST_REQUIRE(SignpostRecorder::isEnabled());
+
+#ifndef __APPLE__
+  O2_SIGNPOST(dpl, 1000, 0, 0, 0);
+  O2_SIGNPOST_START(dpl, 1, 0, 0, 0);
+  {
+    O2_SIGNPOST_SCOPE(nested, 2, 3, 4, O2_SIGNPOST_GREEN);
+  }
+  O2_SIGNPOST_END(dpl, 1, 0, 0, 0);
+  O2_SIGNPOST_START(unterminated, 5, 0, 0, 0);
+  std::thread other([]() {
+    O2_SIGNPOST_START(dpl, 1, 0, 0, 0);
+    O2_SIGNPOST_END(dpl, 1, 0, 0, 0);
+  });
+  other.join();
+
+  auto trace = dumpToString();
+  BOOST_CHECK_EQUAL(trace.front(), '{');
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"test-device")"), 1);
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"thread_name")"), 2);
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"dpl","cat":"dpl","ph":"i")"), 1);
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"dpl","cat":"dpl","ph":"X")"), 2);
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"nested","cat":"dpl","ph":"X")"), 1);
+  BOOST_CHECK_EQUAL(count(trace, R"("name":"unterminated","cat":"dpl","ph":"B")"), 1);
+#endif
+
+  // Only the last CAPACITY signposts of a thread are kept
+  std::thread overflow([]() {
+    for (size_t i = 0; i < SignpostRecorder::CAPACITY + 10; ++i) {
+      SignpostRecorder::record(SignpostRecorder::Kind::Event, "overflow", i, 0, 0, 0);
+    }
+  });
+  overflow.join();
+  auto trace2 = dumpToString();
+  // The oldest slot is the one the thread would write next, so it is dropped as well
+  BOOST_CHECK_EQUAL(count(trace2, R"("name":"overflow")"), SignpostRecorder::CAPACITY - 1);
+  BOOST_CHECK_EQUAL(count(trace2, R"("arg1":10,)"), 0);
+  BOOST_CHECK_EQUAL(count(trace2, R"("arg1":11,)"), 1);
+  BOOST_CHECK_EQUAL(count(trace2, "\"arg1\":" + std::to_string(SignpostRecorder::CAPACITY + 9) + ","), 1);
+}
@@ -0,0 +1,96 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ConfigParamSpec.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+// we need to add workflow options before including Framework/runDataProcessing
+void customize(std::vector<ConfigParamSpec>& workflowOptions)
+{
+  workflowOptions.push_back(
+    ConfigParamSpec{"lanes", VariantType::Int, 4, {"Number of parallel instances of the slow processor"}});
+}
+
+#include "Framework/runDataProcessing.h"
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/RateLimiter.h"
+#include "Framework/Logger.h"
+
+// A source publishing timeframes as fast as the rate limiter allows, followed
+// by slow processors. The processors' outputs are dangling, so they end up in
+// the injected dummy sink, which reports the consumed timeframes back to the
+// source. Run with e.g.
+//
+//   o2-testworkflows-test-adaptive-rate-limiter --timeframes-rate-limit-ipcid 0 --adaptive
+//
+// and compare the source throughput and the timeframes-in-flight metrics to
+// those obtained with a fixed --max-in-flight and without --adaptive.
+WorkflowSpec defineDataProcessing(ConfigContext const& config)
+{
+  int lanes = config.options().get<int>("lanes");
+  int ipcid = std::stoi(config.options().get<std::string>("timeframes-rate-limit-ipcid"));
+  if (ipcid == -1) {
+    LOGP(warning, "No --timeframes-rate-limit-ipcid specified, the source will not be rate limited");
+  }
+
+  DataProcessorSpec source{
+    "tf-source",
+    Inputs{},
+    {OutputSpec{{"tf"}, "TST", "TF"}},
+    AlgorithmSpec{[](InitContext& ic) {
+      auto limiter = std::make_shared<RateLimiter>();
+      limiter->setAdaptive(ic.options().get<bool>("adaptive"));
+      auto maxInFlight = ic.options().get<int>("max-in-flight");
+      auto minSHM = (size_t)ic.options().get<int64_t>("min-shm");
+      auto tfSize = (size_t)ic.options().get<int64_t>("tf-size");
+      auto start = std::chrono::steady_clock::now();
+      auto published = std::make_shared<int64_t>(0);
+      return [limiter, maxInFlight, minSHM, tfSize, start, published](ProcessingContext& ctx) {
+        limiter->check(ctx, maxInFlight, minSHM);
+        auto tf = ctx.outputs().make<char>(OutputRef{"tf"}, tfSize);
+        tf[0] = 0;
+        if (++*published % 100 == 0) {
+          std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+          LOGP(info, "{} timeframes published, {:.2f} TF/s", *published, *published / elapsed.count());
+        }
+      };
+    }},
+    {ConfigParamSpec{"adaptive", VariantType::Bool, false, {"Use the adaptive rate limiting"}},
+     ConfigParamSpec{"max-in-flight", VariantType::Int, 64, {"Maximum number of timeframes in flight"}},
+     ConfigParamSpec{"min-shm", VariantType::Int64, 0ll, {"Minimum amount of free SHM required to publish"}},
+     ConfigParamSpec{"tf-size", VariantType::Int64, 50000000ll, {"Size of the published timeframes"}}}};
+  if (ipcid != -1) {
+    source.options.push_back(ConfigParamSpec{"channel-config", VariantType::String,
+                                             "name=metric-feedback,type=pull,method=connect,address=ipc://@metric-feedback-" + std::to_string(ipcid) + ",transport=shmem,rateLogging=0",
+                                             {"Out-of-band channel config"}});
+  }
+
+  DataProcessorSpec processor{
+    "slow-processor",
+    {InputSpec{"tf", "TST", "TF"}},
+    {OutputSpec{{"done"}, "TST", "DONE"}},
+    AlgorithmSpec{[](InitContext& ic) {
+      auto processingTime = std::chrono::milliseconds(ic.options().get<int>("processing-time"));
+      return [processingTime](ProcessingContext& ctx) {
+        std::this_thread::sleep_for(processingTime);
+        ctx.outputs().make<int>(OutputRef{"done"}, 1);
+      };
+    }},
+    {ConfigParamSpec{"processing-time", VariantType::Int, 200, {"Time spent on each timeframe, in ms"}}}};
+
+  return WorkflowSpec{source, timePipeline(processor, lanes)};
+}
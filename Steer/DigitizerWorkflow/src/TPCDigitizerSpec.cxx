@@ -41,8 +41,11 @@
 #include "DetectorsBase/Detector.h"
 #include "CommonDataFormat/RangeReference.h"
 #include "SimConfig/DigiParams.h"
+#include <array>
 #include <filesystem>
+#include <memory>
 #include "TH3.h"
+#include "TROOT.h"
 
 using namespace o2::framework;
 using SubSpecificationType = o2::framework::DataAllocator::SubSpecificationType;
@@ -172,6 +175,24 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       }
     }
     mDigitizer.setContinuousReadout(!triggeredMode);
+    mUseSparseDigitContainer = ic.options().get<bool>("TPCsparseDigitContainer");
+    mDigitizer.setUseSparseDigitContainer(mUseSparseDigitContainer);
+
+    mNThreads = std::max(1, ic.options().get<int>("TPCnThreads"));
+#ifndef WITH_OPENMP
+    if (mNThreads > 1) {
+      LOG(warning) << "TPC: Multi-threaded digitization requested, but OpenMP is not available";
+      mNThreads = 1;
+    }
+#endif
+    if (mNThreads > 1 && mInternalWriter) {
+      LOG(warning) << "TPC: Multi-threaded digitization is not supported with the internal writer";
+      mNThreads = 1;
+    }
+    if (mNThreads > 1) {
+      LOG(info) << "TPC: Digitizing the sectors of this device with up to " << mNThreads << " threads";
+      ROOT::EnableThreadSafety();
+    }
 
     // we send the GRP data once if the corresponding output channel is available
     // and set the flag to false after
@@ -241,6 +262,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       cdb.setGainMapFromFile("GainMap.root");
     }
 
+    if (mNThreads > 1) {
+      processSectorsParallel(pc);
+      return;
+    }
+
     for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
       for (auto const& inputref : it) {
         process(pc, inputref);
@@ -363,8 +389,6 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     mDigitizer.setSector(sector);
     mDigitizer.init();
 
-    auto& eventParts = context->getEventParts();
-
     auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush = false) {
       mFlushCounter++;
       // flush previous buffer
@@ -386,28 +410,58 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
       }
       mDigitCounter += mDigits.size();
+      return mDigits.size();
     };
 
+    TStopwatch timer;
+    timer.Start();
+
+    digitizeCollisions(mDigitizer, *context, sector, mDigitCounter, eventAccum, flushDigitsAndLabels);
+
+    if (!mInternalWriter) {
+      // send out to next stage
+      snapshotEvents(eventAccum);
+      // snapshotDigits(digitsAccum); --> done automatically
+      snapshotCommonMode(commonModeAccum);
+      snapshotLabels(labelAccum);
+    }
+
+    timer.Stop();
+    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+  }
+
+  /// loop over all collisions of the context and digitize the hits of one sector
+  /// \param digitizer Digitizer set up for the sector
+  /// \param context Digitization context of the timeframe
+  /// \param sector Sector to be processed
+  /// \param digitCounter Number of digits flushed so far, updated by flushDigitsAndLabels
+  /// \param eventAccum Digit grouping (triggers) of the sector
+  /// \param flushDigitsAndLabels Callback flushing the digitizer, returns the number of flushed digits
+  template <typename Flush>
+  void digitizeCollisions(o2::tpc::Digitizer& digitizer, o2::steer::DigitizationContext const& context, int sector,
+                          size_t const& digitCounter, std::vector<DigiGroupRef>& eventAccum, Flush&& flushDigitsAndLabels)
+  {
+    auto& irecords = context.getEventRecords();
+    auto& eventParts = context.getEventParts();
+    const bool isContinuous = digitizer.isContinuousReadout();
+
     if (isContinuous) {
       auto& hbfu = o2::raw::HBFUtils::Instance();
       double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
-      mDigitizer.setOutputDigitTimeOffset(time);
-      mDigitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+      digitizer.setOutputDigitTimeOffset(time);
+      digitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
     }
 
-    TStopwatch timer;
-    timer.Start();
-
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < irecords.size(); ++collID) {
       const double eventTime = irecords[collID].getTimeNS() / 1000.f;
       LOG(info) << "TPC: Event time " << eventTime << " us";
-      mDigitizer.setEventTime(eventTime);
+      digitizer.setEventTime(eventTime);
       if (!isContinuous) {
-        mDigitizer.setStartTime(eventTime);
+        digitizer.setStartTime(eventTime);
       }
-      size_t startSize = mDigitCounter; // digitsAccum->size();
+      size_t startSize = digitCounter; // digitsAccum->size();
 
       // for each collision, loop over the constituents event and source IDs
       // (background signal merging is basically taking place here)
@@ -416,19 +470,25 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         const int sourceID = part.sourceID;
 
         // get the hits for this event and this source
+        // the input chains are shared among the sectors processed in parallel
         std::vector<o2::tpc::HitGroup> hitsLeft;
         std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+#ifdef WITH_OPENMP
+#pragma omp critical(tpc_digitizer_hits)
+#endif
+        {
+          context.retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
+          context.retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        }
         LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
-        mDigitizer.process(hitsLeft, eventID, sourceID);
-        mDigitizer.process(hitsRight, eventID, sourceID);
+        digitizer.process(hitsLeft, eventID, sourceID);
+        digitizer.process(hitsRight, eventID, sourceID);
 
-        flushDigitsAndLabels();
+        const size_t nDigits = flushDigitsAndLabels(false);
 
         if (!isContinuous) {
-          eventAccum.emplace_back(startSize, mDigits.size());
+          eventAccum.emplace_back(startSize, nDigits);
         }
       }
     }
@@ -437,23 +497,136 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     if (isContinuous) {
       LOG(info) << "TPC: Final flush";
       flushDigitsAndLabels(true);
-      eventAccum.emplace_back(0, mDigitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
+      eventAccum.emplace_back(0, digitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
     }
+  }
 
-    if (!mInternalWriter) {
-      // send out to next stage
-      snapshotEvents(eventAccum);
-      // snapshotDigits(digitsAccum); --> done automatically
-      snapshotCommonMode(commonModeAccum);
-      snapshotLabels(labelAccum);
+  /// digitizer of a given sector for the multi-threaded processing, created on first use
+  o2::tpc::Digitizer& getSectorDigitizer(int sector)
+  {
+    auto& digitizer = mSectorDigitizers[sector];
+    if (!digitizer) {
+      digitizer = std::make_unique<o2::tpc::Digitizer>();
+      digitizer->setContinuousReadout(mDigitizer.isContinuousReadout());
+      digitizer->setUseSparseDigitContainer(mUseSparseDigitContainer);
+      digitizer->setUseSCDistortions(mDigitizer);
+    }
+    return *digitizer;
+  }
+
+  // process all sectors of this invocation concurrently
+  // each sector has its own digitizer (with its own random streams) and the output is accumulated per sector,
+  // the read-only tables (mapper, GEM amplification, calibration objects, space charge) are shared
+  void processSectorsParallel(framework::ProcessingContext& pc)
+  {
+    using ContextPtr = decltype(pc.inputs().get<o2::steer::DigitizationContext*>(std::declval<framework::DataRef>()));
+    struct SectorTask {
+      ContextPtr context;
+      o2::header::DataHeader::SubSpecificationType subSpec = 0;
+      uint64_t activeSectors = 0;
+      int sector = -1;
+      o2::tpc::Digitizer* digitizer = nullptr;
+      std::vector<o2::tpc::Digit> digits;
+      o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+      std::vector<o2::tpc::CommonMode> commonMode;
+      std::vector<DigiGroupRef> events;
+    };
+    std::vector<SectorTask> tasks;
+
+    // serial preparation: reading the inputs and setting up the digitizers
+    for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
+      for (auto const& inputref : it) {
+        auto context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
+        context->initSimChains(o2::detectors::DetID::TPC, mSimChains);
+        if (context->getEventRecords().size() == 0) {
+          continue;
+        }
+        auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
+        if (mWriteGRP && pc.outputs().isAllowed({"TPC", "ROMode", 0})) {
+          auto roMode = mDigitizer.isContinuousReadout() ? o2::parameters::GRPObject::CONTINUOUS : o2::parameters::GRPObject::PRESENT;
+          LOG(info) << "TPC: Sending ROMode= " << (mDigitizer.isContinuousReadout() ? "Continuous" : "Triggered")
+                    << " to GRPUpdater from channel " << dh->subSpecification;
+          pc.outputs().snapshot(Output{"TPC", "ROMode", 0, Lifetime::Timeframe}, roMode);
+        }
+        mWriteGRP = false;
+
+        auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
+        if (sectorHeader == nullptr) {
+          LOG(error) << "TPC: Sector header missing, skipping processing";
+          continue;
+        }
+        const int sector = sectorHeader->sector();
+        if (sector < 0) {
+          throw std::runtime_error("Legacy control information is not expected any more");
+        }
+        if (sector >= TPCSectorHeader::NSectors) {
+          throw std::runtime_error("Digitizer can only work on single sectors");
+        }
+        mListOfSectors.push_back(sector);
+
+        auto& task = tasks.emplace_back();
+        task.subSpec = dh->subSpecification;
+        task.activeSectors = sectorHeader->activeSectors;
+        task.sector = sector;
+        task.digitizer = &getSectorDigitizer(sector);
+        task.digitizer->setSector(sector);
+        task.context = std::move(context);
+      }
+    }
+    // update the parameters of the shared ElectronTransport, GEMAmplification and SAMPAProcessing (and initialize the
+    // shared space-charge object) once, the sector digitizers only read them in the parallel section
+    mDigitizer.init();
+    LOG(info) << "TPC: Processing " << tasks.size() << " sectors with " << std::min<size_t>(mNThreads, tasks.size()) << " threads";
+
+    TStopwatch timer;
+    timer.Start();
+
+#ifdef WITH_OPENMP
+    const int nThreads = std::min<size_t>(mNThreads, std::max<size_t>(1, tasks.size()));
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      auto& task = tasks[i];
+      std::vector<o2::tpc::Digit> digits;
+      o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+      size_t digitCounter = 0;
+      auto flushDigitsAndLabels = [this, &task, &digits, &labels, &digitCounter](bool finalFlush) {
+        digits.clear();
+        labels.clear();
+        task.digitizer->flush(digits, labels, task.commonMode, finalFlush);
+        std::copy(digits.begin(), digits.end(), std::back_inserter(task.digits));
+        if (mWithMCTruth) {
+          task.labels.mergeAtBack(labels);
+        }
+        digitCounter += digits.size();
+        return digits.size();
+      };
+      digitizeCollisions(*task.digitizer, *task.context, task.sector, digitCounter, task.events, flushDigitsAndLabels);
+      LOG(info) << "TPC: Sector " << task.sector << " produced " << task.digits.size() << " digits";
+    }
+
+    // serial sending of the outputs
+    for (auto& task : tasks) {
+      o2::tpc::TPCSectorHeader header{task.sector};
+      header.activeSectors = task.activeSectors;
+      const auto subSpec = static_cast<SubSpecificationType>(task.subSpec);
+      pc.outputs().snapshot(Output{"TPC", "DIGITS", subSpec, Lifetime::Timeframe, header}, task.digits);
+      LOG(info) << "TPC: Send TRIGGERS for sector " << task.sector << " channel " << task.subSpec << " | size " << task.events.size();
+      pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", subSpec, Lifetime::Timeframe, header}, task.events);
+      pc.outputs().snapshot(Output{"TPC", "COMMONMODE", subSpec, Lifetime::Timeframe, header}, task.commonMode);
+      if (mWithMCTruth) {
+        auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", subSpec, Lifetime::Timeframe, header});
+        task.labels.flatten_to(sharedlabels);
+      }
     }
 
     timer.Stop();
-    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+    LOG(info) << "TPC: Digitization of " << tasks.size() << " sectors took " << timer.RealTime() << "s (real) " << timer.CpuTime() << "s (CPU)";
   }
 
  private:
   o2::tpc::Digitizer mDigitizer;
+  std::array<std::unique_ptr<o2::tpc::Digitizer>, Sector::MAXSECTOR> mSectorDigitizers; // digitizers for the multi-threaded processing
   std::vector<TChain*> mSimChains;
   std::vector<o2::tpc::Digit> mDigits;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
@@ -469,6 +642,8 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
   bool mWithMCTruth = true;
   bool mInternalWriter = false;
   bool mUseCalibrationsFromCCDB = false;
+  bool mUseSparseDigitContainer = false;
+  int mNThreads = 1; // number of threads to digitize the sectors of this device concurrently
 };
 
 o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP, bool mctruth, bool internalwriter)
@@ -507,6 +682,8 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
       {"readSpaceCharge", VariantType::String, "", {"Path to root file containing pre-calculated space-charge object and name of the object (comma separated)"}},
       {"TPCtriggered", VariantType::Bool, false, {"Impose triggered RO mode (default: continuous)"}},
       {"TPCuseCCDB", VariantType::Bool, false, {"true: load calibrations from CCDB; false: use random calibratoins"}},
+      {"TPCsparseDigitContainer", VariantType::Bool, false, {"store only the occupied pads of each time bin in the intermediate digit container (reduces memory)"}},
+      {"TPCnThreads", VariantType::Int, 1, {"number of threads to digitize the sectors of this device concurrently, > 1 keeps one digitizer per sector"}},
     }};
 }
 
@@ -248,6 +248,7 @@ void O2MCApplication::attachSubEventInfo(FairMQParts& parts, o2::data::SubEventI
 }
 
 // helper function to fetch data from FairRootManager branch and serialize it
+// (or send it as flat buffer, see o2::base::attachSimDataMessage)
 // returns handle to container
 template <typename T>
 const T* attachBranch(std::string const& name, FairMQChannel& channel, FairMQParts& parts)
@@ -260,7 +261,7 @@ const T* attachBranch(std::string const& name, FairMQChannel& channel, FairMQPar
   }
   auto data = mgr->InitObjectAs<const T*>(name.c_str());
   if (data) {
-    o2::base::attachTMessage(*data, channel, parts);
+    o2::base::attachSimDataMessage(*data, channel, parts);
   }
   return data;
 }
@@ -64,6 +64,8 @@
 #include <list>
 #include <csignal>
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <filesystem>
 #include <functional>
 
@@ -134,6 +136,8 @@ class O2HitMerger : public FairMQDevice
       outfilename = o2::base::NameConf::getMCKinematicsFileName(o2::conf::SimConfig::Instance().getOutPrefix().c_str());
       mNExpectedEvents = o2::conf::SimConfig::Instance().getNEvents();
     }
+    mNMergerWorkers = o2::conf::SimConfig::Instance().getNMergerWorkers();
+    LOG(info) << "Merging with " << mNMergerWorkers << " threads";
     mAsService = o2::conf::SimConfig::Instance().asService();
 
     mOutFileName = outfilename.c_str();
@@ -277,7 +281,7 @@ class O2HitMerger : public FairMQDevice
   template <typename T, typename BT>
   void consumeData(int eventID, FairMQParts& data, int& index, BT& buffer)
   {
-    auto decodeddata = o2::base::decodeTMessage<T*>(data, index);
+    auto decodeddata = o2::base::decodeSimDataMessage<T>(data, index);
     if (buffer.find(eventID) == buffer.end()) {
       buffer[eventID] = typename BT::mapped_type();
     }
@@ -353,44 +357,49 @@ class O2HitMerger : public FairMQDevice
     bool expectmore = true;
     int index = 0;
     auto infoptr = o2::base::decodeTMessage<o2::data::SubEventInfo*>(data, index++);
-    o2::data::SubEventInfo& info = *infoptr;
-    auto accum = insertAdd<uint32_t, uint32_t>(mPartsCheckSum, info.eventID, (uint32_t)info.part);
-
-    LOG(info) << "SIMDATA channel got " << data.Size() << " parts for event " << info.eventID << " part " << info.part << " out of " << info.nparts;
-
-    fillSubEventInfoEntry(info);
-    consumeData<std::vector<o2::MCTrack>>(info.eventID, data, index, mMCTrackBuffer);
-    consumeData<std::vector<o2::TrackReference>>(info.eventID, data, index, mTrackRefBuffer);
+    // the info is owned by the buffers from now on and is released by the merger thread
+    // once the event is flushed, so we keep a copy of what is needed here
+    const auto eventID = infoptr->eventID;
+    const auto nparts = infoptr->nparts;
+    const auto maxEvents = infoptr->maxEvents;
+
+    LOG(info) << "SIMDATA channel got " << data.Size() << " parts for event " << eventID << " part " << infoptr->part << " out of " << nparts;
+
+    uint32_t accum = 0;
+    {
+      // insertion into the per-event buffers must not overlap with the removal of flushed events
+      std::lock_guard<std::mutex> lock(mBufferMutex);
+      accum = insertAdd<uint32_t, uint32_t>(mPartsCheckSum, eventID, (uint32_t)infoptr->part);
+      fillSubEventInfoEntry(*infoptr);
+      consumeData<std::vector<o2::MCTrack>>(eventID, data, index, mMCTrackBuffer);
+      consumeData<std::vector<o2::TrackReference>>(eventID, data, index, mTrackRefBuffer);
+    }
     while (index < data.Size()) {
-      consumeHits(info.eventID, data, index);
+      consumeHits(eventID, data, index);
     }
 
-    if (isDataComplete<uint32_t>(accum, info.nparts)) {
-      LOG(info) << "Event " << info.eventID << " complete. Marking as flushable";
-      mFlushableEvents[info.eventID] = true;
+    if (isDataComplete<uint32_t>(accum, nparts)) {
+      LOG(info) << "Event " << eventID << " complete. Marking as flushable";
+      {
+        std::lock_guard<std::mutex> lock(mBufferMutex);
+        mFlushableEvents[eventID] = true;
+      }
 
       // check if previous flush finished
       // start merging only when no merging currently happening
-      // Like this we don't have to join/wait on the thread here and do not block the outer ConditionalRun handling
-      // TODO: Let this run fully asynchronously (not even triggered by ConditionalRun)
+      // Like this we don't have to join/wait on the thread here and do not block the outer ConditionalRun handling.
+      // A running merger keeps on flushing events which are completed in the meantime.
       if (!mergingInProgress) {
-        if (mMergerIOThread.joinable()) {
-          mMergerIOThread.join();
-        }
-        // start hit merging and flushing in a separate thread in order not to block
-        mMergerIOThread = std::thread([info, this]() { mergingInProgress = true; mergeAndFlushData(); mergingInProgress = false; });
+        launchMerger();
       }
 
-      mEventChecksum += info.eventID;
+      mEventChecksum += eventID;
       // we also need to check if we have all events
-      if (isDataComplete<uint32_t>(mEventChecksum, info.maxEvents)) {
+      if (isDataComplete<uint32_t>(mEventChecksum, maxEvents)) {
         LOG(info) << "ALL EVENTS HERE; CHECKSUM " << mEventChecksum;
 
         // flush remaining data and close file
-        if (mMergerIOThread.joinable()) {
-          mMergerIOThread.join();
-        }
-        mMergerIOThread = std::thread([info, this]() { mergingInProgress = true; mergeAndFlushData(); mergingInProgress = false; });
+        launchMerger();
         if (mMergerIOThread.joinable()) {
           mMergerIOThread.join();
         }
@@ -399,7 +408,7 @@ class O2HitMerger : public FairMQDevice
       }
 
       if (mPipeToDriver != -1) {
-        if (write(mPipeToDriver, &info.eventID, sizeof(info.eventID)) == -1) {
+        if (write(mPipeToDriver, &eventID, sizeof(eventID)) == -1) {
           LOG(error) << "FAILED WRITING TO PIPE";
         };
       }
@@ -411,9 +420,43 @@ class O2HitMerger : public FairMQDevice
     return expectmore;
   }
 
+  // waits for a previous merger thread and starts hit merging and flushing
+  // in a separate thread in order not to block
+  void launchMerger()
+  {
+    if (mMergerIOThread.joinable()) {
+      mMergerIOThread.join();
+    }
+    mergingInProgress = true;
+    mMergerIOThread = std::thread([this]() { mergeAndFlushData(); mergingInProgress = false; });
+  }
+
+  bool isFlushable(int eventID)
+  {
+    std::lock_guard<std::mutex> lock(mBufferMutex);
+    auto iter = mFlushableEvents.find(eventID);
+    return iter != mFlushableEvents.end() && iter->second == true;
+  }
+
   void cleanEvent(int eventID)
   {
     // cleanup intermediate per-Event buffers
+    // (data which has not been consumed by the merge kernels, e.g. for skipped events, is released here)
+    std::lock_guard<std::mutex> lock(mBufferMutex);
+    auto release = [eventID](auto& buffer) {
+      auto iter = buffer.find(eventID);
+      if (iter != buffer.end()) {
+        for (auto ptr : iter->second) {
+          delete ptr;
+        }
+        buffer.unsafe_erase(iter);
+      }
+    };
+    release(mMCTrackBuffer);
+    release(mTrackRefBuffer);
+    release(mSubEventInfoBuffer);
+    mFlushableEvents.unsafe_erase(eventID);
+    mPartsCheckSum.erase(eventID);
   }
 
   template <typename T>
@@ -504,6 +547,7 @@ class O2HitMerger : public FairMQDevice
     for (auto ptr : vectorOfSubEventMCTracks) {
       delete ptr; // avoid this by using unique ptr
     }
+    vectorOfSubEventMCTracks.clear();
   }
 
   template <typename T, typename M>
@@ -555,6 +599,7 @@ class O2HitMerger : public FairMQDevice
     for (auto ptr : vectorOfT) {
       delete ptr; // avoid this by using unique ptr
     }
+    vectorOfT.clear();
   }
 
   void updateTrackIdWithOffset(MCTrack& track, Int_t nprim, Int_t idelta0, Int_t idelta1)
@@ -587,94 +632,76 @@ class O2HitMerger : public FairMQDevice
     mDetectorToTTreeMap[detID]->SetDirectory(mDetectorOutFiles[detID]);
   }
 
-  // This method goes over the buffers containing data for a given event; potentially merges
-  // them and flushes into the actual output file.
-  // The method can be called asynchronously to data collection
-  bool mergeAndFlushData()
-  {
-    auto checkIfNextFlushable = [this]() -> bool {
-      mNextFlushID++;
-      return mFlushableEvents.find(mNextFlushID) != mFlushableEvents.end() && mFlushableEvents[mNextFlushID] == true;
-    };
+  // per-event information needed by the merge kernels
+  struct EventMergeInfo {
+    int eventID = -1;
+    std::vector<int> trackoffsets;                         // trackoffsets (per data arrival id) used for global track-ID correction
+    std::vector<int> nprimaries;                           // primary particles in each subevent (data arrival id)
+    std::vector<int> subevOrdered;                         // data arrival id ordered by sub-event id (or part)
+    o2::dataformats::MCEventHeader* eventheader = nullptr; // the event header (owned by the SubEventInfo buffer)
+  };
 
-    LOG(info) << "Launching merge kernel ";
-    bool canflush = mFlushableEvents.find(mNextFlushID) != mFlushableEvents.end() && mFlushableEvents[mNextFlushID] == true;
-    if (!canflush) {
-      return false;
-    }
-    while (canflush == true) {
-      auto flusheventID = mNextFlushID;
-      LOG(info) << "Merge and flush event " << flusheventID;
+  // Collects the bookkeeping for all consecutive events which can be flushed now.
+  // Events without data or without hits (when requested) are dropped here.
+  std::vector<EventMergeInfo> collectFlushableEvents()
+  {
+    std::vector<EventMergeInfo> batch;
+    auto& confref = o2::conf::SimConfig::Instance();
+    while (isFlushable(mNextFlushID)) {
+      const auto flusheventID = mNextFlushID++;
       auto iter = mSubEventInfoBuffer.find(flusheventID);
-      if (iter == mSubEventInfoBuffer.end()) {
-        LOG(error) << "No info/data found for event " << flusheventID;
-        if (!checkIfNextFlushable()) {
-          return false;
-        }
-      }
-
-      auto& subEventInfoList = (*iter).second;
-      if (subEventInfoList.size() == 0 || mNExpectedEvents == 0) {
+      if (iter == mSubEventInfoBuffer.end() || (*iter).second.size() == 0 || mNExpectedEvents == 0) {
         LOG(error) << "No data entries found for event " << flusheventID;
-        if (!checkIfNextFlushable()) {
-          return false;
-        }
+        cleanEvent(flusheventID);
+        continue;
       }
+      auto& subEventInfoList = (*iter).second;
 
-      TStopwatch timer;
-      timer.Start();
-
-      // calculate trackoffsets
-      auto& confref = o2::conf::SimConfig::Instance();
-
-      // collecting trackoffsets (per data arrival id) to be used for global track-ID correction pass
-      std::vector<int> trackoffsets;
-      // collecting primary particles in each subevent (data arrival id)
-      std::vector<int> nprimaries;
+      EventMergeInfo event;
+      event.eventID = flusheventID;
       // mapping of id to actual sub-event id (or part)
       std::vector<int> nsubevents;
-
-      o2::dataformats::MCEventHeader* eventheader = nullptr; // The event header
-
-      // the MC labels (trackID) for hits
       for (auto info : subEventInfoList) {
         assert(info->npersistenttracks >= 0);
-        trackoffsets.emplace_back(info->npersistenttracks);
-        nprimaries.emplace_back(info->nprimarytracks);
+        event.trackoffsets.emplace_back(info->npersistenttracks);
+        event.nprimaries.emplace_back(info->nprimarytracks);
         nsubevents.emplace_back(info->part);
-        if (eventheader == nullptr) {
-          eventheader = &info->mMCEventHeader;
+        if (event.eventheader == nullptr) {
+          event.eventheader = &info->mMCEventHeader;
         } else {
-          eventheader->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
+          event.eventheader->getMCEventStats().add(info->mMCEventHeader.getMCEventStats());
         }
       }
 
       // now see which events can be discarded in any case due to no hits
       if (confref.isFilterOutNoHitEvents()) {
-        if (eventheader && eventheader->getMCEventStats().getNHits() == 0) {
+        if (event.eventheader && event.eventheader->getMCEventStats().getNHits() == 0) {
           LOG(info) << " Taking out event " << flusheventID << " due to no hits ";
           cleanEvent(flusheventID);
-          if (!checkIfNextFlushable()) {
-            return true;
-          }
+          continue;
         }
       }
 
-      // put the event headers into the new TTree
-      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
-
-      // attention: We need to make sure that we write everything in the same event order
-      // but iteration over keys of a standard map in C++ is ordered
-
-      // b) merge the general data
-      //
-      // for MCTrack remap the motherIds and merge at the same go
       const auto entries = subEventInfoList.size();
-      std::vector<int> subevOrdered((int)(nsubevents.size()));
+      event.subevOrdered.resize(nsubevents.size());
       for (int entry = entries - 1; entry >= 0; --entry) {
-        subevOrdered[nsubevents[entry] - 1] = entry;
-        printf("HitMerger entry: %d nprimry: %5d trackoffset: %5d \n", entry, nprimaries[entry], trackoffsets[entry]);
+        event.subevOrdered[nsubevents[entry] - 1] = entry;
+        printf("HitMerger entry: %d nprimry: %5d trackoffset: %5d \n", entry, event.nprimaries[entry], event.trackoffsets[entry]);
       }
+      batch.emplace_back(std::move(event));
+    }
+    return batch;
+  }
+
+  // merge kernel for the kinematics: MCTracks, TrackReferences and the MCEventHeader
+  void mergeAndFlushKinematics(std::vector<EventMergeInfo> const& batch)
+  {
+    for (auto& event : batch) {
+      auto flusheventID = event.eventID;
+      auto eventheader = event.eventheader;
+
+      // put the event headers into the new TTree
+      auto headerbr = o2::base::getOrMakeBranch(*mOutTree, "MCEventHeader.", &eventheader);
 
       // This is a hook that collects some useful statistics/properties on the event
       // for use by other components;
@@ -727,48 +754,87 @@ class O2HitMerger : public FairMQDevice
         eventheader->putInfo("prims_total", prims);
       };
 
-      reorderAndMergeMCTracks(flusheventID, *mOutTree, nprimaries, subevOrdered, mcheaderhook);
-      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", flusheventID, *mOutTree, trackoffsets, nprimaries, subevOrdered, mTrackRefBuffer);
+      // for MCTrack remap the motherIds and merge at the same go
+      reorderAndMergeMCTracks(flusheventID, *mOutTree, event.nprimaries, event.subevOrdered, mcheaderhook);
+      remapTrackIdsAndMerge<std::vector<o2::TrackReference>>("TrackRefs", flusheventID, *mOutTree, event.trackoffsets, event.nprimaries, event.subevOrdered, mTrackRefBuffer);
 
       // header can be written
       headerbr->SetAddress(&eventheader);
       headerbr->Fill();
       headerbr->ResetAddress();
 
-      // c) do the merge procedure for all hits ... delegate this to detector specific functions
-      // since they know about types; number of branches; etc.
-      // this will also fix the trackIDs inside the hits
-      for (int id = 0; id < mDetectorInstances.size(); ++id) {
-        auto& det = mDetectorInstances[id];
-        if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
-          // det->mergeHitEntries(*tree, *hittree, trackoffsets, nprimaries, subevOrdered);
-          det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
-          hittree->SetEntries(hittree->GetEntries() + 1);
-          LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
-        }
-      }
-
       // increase the entry count in the tree
       mOutTree->SetEntries(mOutTree->GetEntries() + 1);
-      LOG(info) << "outtree has file " << mOutTree->GetDirectory()->GetFile()->GetName();
+    }
+    mOutFile->Write("", TObject::kOverwrite);
+  }
+
+  // merge kernel for the hits of one detector ... delegate this to detector specific functions
+  // since they know about types; number of branches; etc.
+  // this will also fix the trackIDs inside the hits
+  void mergeAndFlushHits(int id, std::vector<EventMergeInfo> const& batch)
+  {
+    auto& det = mDetectorInstances[id];
+    auto hittree = mDetectorToTTreeMap[id];
+    for (auto& event : batch) {
+      det->mergeHitEntriesAndFlush(event.eventID, *hittree, event.trackoffsets, event.nprimaries, event.subevOrdered);
+      hittree->SetEntries(hittree->GetEntries() + 1);
+    }
+    mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+  }
 
-      cleanEvent(flusheventID);
-      LOG(info) << "Merge/flush for event " << flusheventID << " took " << timer.RealTime();
-      if (!checkIfNextFlushable()) {
-        break;
+  // This method goes over the buffers containing data for the completed events; potentially merges
+  // them and flushes into the actual output files.
+  // The kinematics and the hits of each detector go to separate files, so they are merged and written
+  // by independent tasks which are distributed over mNMergerWorkers threads.
+  // The method can be called asynchronously to data collection; events completed while merging
+  // are flushed by the same call.
+  bool mergeAndFlushData()
+  {
+    LOG(info) << "Launching merge kernel ";
+    bool flushed = false;
+    auto batch = collectFlushableEvents();
+    while (batch.size() > 0) {
+      TStopwatch timer;
+      timer.Start();
+
+      // task -1 is the kinematics, the others are detector IDs
+      std::vector<int> tasks{-1};
+      for (int id = 0; id < mDetectorInstances.size(); ++id) {
+        if (mDetectorInstances[id]) {
+          tasks.push_back(id);
+        }
       }
-    } // end while
-    LOG(info) << "Writing TTrees";
-    mOutFile->Write("", TObject::kOverwrite);
-    for (int id = 0; id < mDetectorInstances.size(); ++id) {
-      auto& det = mDetectorInstances[id];
-      if (det) {
-        mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+      std::atomic<int> nexttask{0};
+      auto worker = [this, &tasks, &nexttask, &batch]() {
+        for (int task = nexttask++; task < tasks.size(); task = nexttask++) {
+          if (tasks[task] < 0) {
+            mergeAndFlushKinematics(batch);
+          } else {
+            mergeAndFlushHits(tasks[task], batch);
+          }
+        }
+      };
+      const int nthreads = std::min<int>(mNMergerWorkers, tasks.size());
+      std::vector<std::thread> threads;
+      for (int i = 1; i < nthreads; ++i) {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (auto& thread : threads) {
+        thread.join();
       }
-    }
 
-    return true;
+      for (auto& event : batch) {
+        cleanEvent(event.eventID);
+      }
+      const auto time = timer.RealTime();
+      LOG(info) << "Merge/flush for events " << batch.front().eventID << " to " << batch.back().eventID << " took " << time
+                << " s (" << batch.size() / std::max(time, 1.e-6) << " events/s with " << nthreads << " threads)";
+      flushed = true;
+      batch = collectFlushableEvents();
+    }
+    return flushed;
   }
 
   std::map<uint32_t, uint32_t> mPartsCheckSum; //! mapping event id -> part checksum used to detect when all info
@@ -784,8 +850,10 @@ class O2HitMerger : public FairMQDevice
   Hashtable<int, TTree*> mDetectorToTTreeMap; //! the trees
 
   // intermediate structures to collect data per event
-  std::thread mMergerIOThread; //! a thread used to do hit merging and IO flushing asynchronously
-  bool mergingInProgress = false;
+  std::thread mMergerIOThread;               //! a thread used to do hit merging and IO flushing asynchronously
+  std::atomic<bool> mergingInProgress{false}; //!
+  int mNMergerWorkers = 1;                    //! number of threads used for merging and IO flushing
+  std::mutex mBufferMutex;                    //! guards insertion into and removal from the per-event buffers
 
   Hashtable<int, std::vector<std::vector<o2::MCTrack>*>> mMCTrackBuffer;         //! vector of sub-event track vectors; one per event
   Hashtable<int, std::vector<std::vector<o2::TrackReference>*>> mTrackRefBuffer; //!
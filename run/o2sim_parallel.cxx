@@ -332,29 +332,6 @@ int main(int argc, char* argv[])
   std::string rootpath(o2env);
   std::string installpath = rootpath + "/bin";
 
-  // copy topology file to working dir and update ports
-  std::stringstream configss;
-  configss << rootpath << "/share/config/o2simtopology_template.json";
-  auto localconfig = std::string("o2simtopology_") + std::to_string(getpid()) + std::string(".json");
-
-  // need to add pid to channel urls to allow simultaneous deploys!
-  // we simply insert the PID into the topology template
-  std::ifstream in(configss.str());
-  std::ofstream out(localconfig);
-  std::string wordToReplace("#PID#");
-  std::string wordToReplaceWith = std::to_string(getpid());
-  std::string line;
-  size_t len = wordToReplace.length();
-  while (std::getline(in, line)) {
-    size_t pos = line.find(wordToReplace);
-    if (pos != std::string::npos) {
-      line.replace(pos, len, wordToReplaceWith);
-    }
-    out << line << '\n';
-  }
-  in.close();
-  out.close();
-
   // create a channel for outside event notifications --> factor out into common function
   // auto factory = FairMQTransportFactory::CreateTransportFactory("zeromq");
   auto externalpublishchannel = o2::simpubsub::createPUBChannel(o2::simpubsub::getPublishAddress("o2sim-notifications"));
@@ -383,6 +360,32 @@ int main(int argc, char* argv[])
     return r;
   }
 
+  // copy topology file to working dir and update ports
+  std::stringstream configss;
+  configss << rootpath << "/share/config/o2simtopology_template.json";
+  auto localconfig = std::string("o2simtopology_") + std::to_string(getpid()) + std::string(".json");
+
+  // need to add pid to channel urls to allow simultaneous deploys!
+  // we simply insert the PID into the topology template
+  // (as well as the transport of the simdata channel, which is shared memory when flat buffers are sent)
+  std::ifstream in(configss.str());
+  std::ofstream out(localconfig);
+  const std::vector<std::pair<std::string, std::string>> replacements{
+    {"#PID#", std::to_string(getpid())},
+    {"#SIMDATATRANSPORT#", conf.isFlatSimData() ? "shmem" : "zeromq"}};
+  std::string line;
+  while (std::getline(in, line)) {
+    for (auto& [wordToReplace, wordToReplaceWith] : replacements) {
+      size_t pos = line.find(wordToReplace);
+      if (pos != std::string::npos) {
+        line.replace(pos, wordToReplace.length(), wordToReplaceWith);
+      }
+    }
+    out << line << '\n';
+  }
+  in.close();
+  out.close();
+
   gAskedEvents = conf.getNEvents();
   if (conf.asService()) {
     launchControlThread();